@@ -1,8 +1,7 @@
 #include "Barrel.h"
 #include "Sprite.h"
 #include "AnimatedSprite.h"
-#include "../Source/Services/ServiceLocator.h"
-#include "../Source/Platforms/PlatformLayer.h"
+#include "GameContext.h"
 #include "../Source/Utils/Math/Math.h"
 #include "../Source/Physics/Body.h"
 #include "../Source/Physics/BoxCollider.h"
@@ -12,7 +11,8 @@
 
 namespace GameDev2D
 {
-    Barrel::Barrel() : GameObject("Barrel"),
+    Barrel::Barrel(GameContext* aContext) : GameObject("Barrel"),
+        m_Context(aContext),
         m_Barrel(nullptr),
         m_PhysicsBody(nullptr)
     {
@@ -48,10 +48,10 @@ namespace GameDev2D
         //Initialize the parameters to create the Physics body
         float density = 1.0f;
         float radius = Math::PixelsToMeters(GetHeight() / 2.0f);
-        Physics::CircleCollider* circleCollider = new Physics::CircleCollider(radius);
+        Physics::CircleCollider* circleCollider = m_Context->GetWorld()->CreateCircleCollider(radius);
 
         //Create the Physics body to attach to the tank
-        m_PhysicsBody = Physics::World::GetInstance()->CreateBody(circleCollider, density);
+        m_PhysicsBody = m_Context->GetWorld()->CreateBody(circleCollider, density);
         m_PhysicsBody->SetGameObject(this);
         m_PhysicsBody->SetPosition(Math::PixelsToMeters(vec2(WINDOWS_DEFAULT_WIDTH / 2, WINDOWS_DEFAULT_HEIGHT / 2)));
         m_PhysicsBody->SetLinearDamping(vec2(0.2f, 0.2));
@@ -61,7 +61,15 @@ namespace GameDev2D
     Barrel::~Barrel()
     {
         m_Barrel = nullptr;
-        m_PhysicsBody = nullptr;
+
+        //Destroy the physics body and its collider
+        if (m_PhysicsBody != nullptr)
+        {
+            Physics::Collider* collider = m_PhysicsBody->GetCollider();
+            m_Context->GetWorld()->DestroyBody(m_PhysicsBody);
+            m_Context->GetWorld()->DestroyCollider(collider);
+            m_PhysicsBody = nullptr;
+        }
     }
 
     void Barrel::SetX(float x)
@@ -106,6 +114,9 @@ namespace GameDev2D
             m_Explosion->SetFrameIndex(0);
             m_Explosion->SetIsEnabled(true);
             m_Barrel->SetIsEnabled(false);
+
+            //Push the nearby bodies away, the Game sets off the barrels it reaches once the step has finished
+            m_Context->GetWorld()->ApplyRadialImpulse(m_PhysicsBody->GetPosition(), BARREL_EXPLOSION_RADIUS, BARREL_EXPLOSION_IMPULSE, Physics::RadialFalloff_Linear);
         }
     }
 
@@ -113,4 +124,9 @@ namespace GameDev2D
     {
         return m_Barrel->IsEnabled() == false;
     }
+
+    Physics::Body* Barrel::GetPhysicsBody()
+    {
+        return m_PhysicsBody;
+    }
 }
\ No newline at end of file
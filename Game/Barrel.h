@@ -6,9 +6,16 @@
 
 namespace GameDev2D
 {
+    //Local constants, the chain radius is less than the 2 m from a barrel's center to the edges of its diagonal
+    //neighbours in the starting layout, so a chain reaction only spreads where barrels have been pushed together
+    const float BARREL_EXPLOSION_RADIUS = 2.5f;     //In meters, the bodies this close to the barrel's center are pushed away
+    const float BARREL_CHAIN_RADIUS = 1.25f;        //In meters, the barrels whose edge is this close to the barrel's center are set off
+    const float BARREL_EXPLOSION_IMPULSE = 30.0f;   //In kg m/s, at the barrel's center, weakens linearly out to the radius
+
     //Forward declaration
     class Sprite;
     class AnimatedSprite;
+    class GameContext;
     namespace Physics
     {
         class Body;
@@ -17,7 +24,7 @@ namespace GameDev2D
     class Barrel : public GameObject
     {
     public:
-        Barrel();
+        Barrel(GameContext* context);
         ~Barrel();
 
         //Sets the position of the sprite
@@ -29,11 +36,16 @@ namespace GameDev2D
         float GetWidth();
         float GetHeight();
 
+        //Swaps the barrel for its explosion and queues a radial impulse in the physics world, which
+        //pushes the nearby bodies away during the next step
         void Explode();
         bool HasExploded();
 
+        Physics::Body* GetPhysicsBody();
+
     private:
         //Member variable
+        GameContext* m_Context;
         Sprite* m_Barrel;
         AnimatedSprite* m_Explosion;
         Physics::Body* m_PhysicsBody;
@@ -15,8 +15,10 @@
 #include "Tank.h"
 #include "Shell.h"
 #include "Barrel.h"
+#include "GameContext.h"
 
 #include "../Source/Services/ServiceLocator.h"
+#include "../Source/Services/Random/Random.h"
 #include "../Source/Platforms/PlatformLayer.h"
 #include "../Source/Graphics/Graphics.h"
 #include "../Source/Events/Input/InputEvents.h"
@@ -31,20 +33,23 @@
 
 namespace GameDev2D
 {
-    Game::Game() : BaseObject("Game"),
+    Game::Game(GameContext* aContext) : BaseObject("Game"),
+        m_Context(aContext),
         m_Camera(nullptr),
-        m_TimeStep(1.0 / (double)ServiceLocator::GetPlatformLayer()->GetTargetFramerate()),
+        m_BlueDetonatorBody(nullptr),
+        m_GreenDetonatorBody(nullptr),
         m_ScreenWidth(0.0f),
         m_ScreenHeight(0.0f)
     {
-        //Create the camera object
+        //Create the camera object, its shake draws from the context's random numbers
         m_Camera = new Camera();
+        m_Camera->SetRandom(m_Context->GetRandom());
 
-        //Set the physics world's listener
-        Physics::World::GetInstance()->SetListener(this);
+        //Set the physics world's listener, the context steps it at a fixed rate, independent of the frame rate
+        m_Context->GetWorld()->SetListener(this);
 
         //Create the first Tank object
-        m_BlueTank = new Tank(TankBlue);
+        m_BlueTank = new Tank(m_Context, TankBlue);
         m_BlueTank->SetLeftInput(KEY_CODE_A);
         m_BlueTank->SetRightInput(KEY_CODE_D);
         m_BlueTank->SetUpInput(KEY_CODE_W);
@@ -54,7 +59,7 @@ namespace GameDev2D
         m_BlueTank->SetFireTurretInput(KEY_CODE_TAB);
 
         //Create the second Tank object
-        m_GreenTank = new Tank(TankGreen);
+        m_GreenTank = new Tank(m_Context, TankGreen);
         m_GreenTank->SetLeftInput(KEY_CODE_LEFT);
         m_GreenTank->SetRightInput(KEY_CODE_RIGHT);
         m_GreenTank->SetUpInput(KEY_CODE_UP);
@@ -63,13 +68,13 @@ namespace GameDev2D
         m_GreenTank->SetTurretRightInput(KEY_CODE_M);
         m_GreenTank->SetFireTurretInput(KEY_CODE_SPACE);
 
-        m_ExplodedTank = new Tank(TankExploded);
+        m_ExplodedTank = new Tank(m_Context, TankExploded);
         m_ExplodedTank->SetIsEnabled(false);
 
         //Create the Shell objects
         for (unsigned int i = 0; i < SHELL_POOL_SIZE; i++)
         {
-            m_Shells[i] = new Shell();
+            m_Shells[i] = new Shell(m_Context);
         }
 
         m_Background = new Sprite("Background.png");
@@ -79,7 +84,7 @@ namespace GameDev2D
         //Create the Barrel object
         for (unsigned int i = 0; i < AMOUNT_OF_BARRELS; i++)
         {
-            m_Barrel[i] = new Barrel();
+            m_Barrel[i] = new Barrel(m_Context);
             m_Barrel[i]->SetAnchorPoint(0.5f, 0.5f);
         }
 
@@ -154,11 +159,12 @@ namespace GameDev2D
         m_GreenDetonator->SetAnchorPoint(0.5f, 0.5f);
         m_GreenDetonator->SetIsEnabled(false);
 
-        int blueRand = rand() % (AMOUNT_OF_BARRELS - 1);
+        //Use the context's seeded random number generator, so the detonators are placed the same way for the same seed
+        int blueRand = m_Context->GetRandom()->NextUInt(AMOUNT_OF_BARRELS - 1);
         int greenRand;
         do
         {
-        greenRand = rand() % (AMOUNT_OF_BARRELS - 1);
+        greenRand = m_Context->GetRandom()->NextUInt(AMOUNT_OF_BARRELS - 1);
         } while (greenRand == blueRand);
 
         //int blueRand = 23;
@@ -170,20 +176,55 @@ namespace GameDev2D
         //Initialize the parameters to create the Physics body;
         float density = 1.0f;
         float radius = Math::PixelsToMeters(m_BlueDetonator->GetHeight() / 2.0f);
-        Physics::CircleCollider* circleCollider = new Physics::CircleCollider(radius);
+        Physics::CircleCollider* circleCollider = m_Context->GetWorld()->CreateCircleCollider(radius);
+
+        //Create the Physics body to attach to the detonators, they are sensors, they only need
+        //to know when a tank drives over them, so they are never pushed around by the tanks
+        m_BlueDetonatorBody = m_Context->GetWorld()->CreateBody(circleCollider, density);
+        m_BlueDetonatorBody->SetGameObject(m_BlueDetonator);
+        m_BlueDetonatorBody->SetPosition(Math::PixelsToMeters(m_BlueDetonator->GetPosition()));
+        m_BlueDetonatorBody->SetSensor(true);
+
+        m_GreenDetonatorBody = m_Context->GetWorld()->CreateBody(circleCollider, density);
+        m_GreenDetonatorBody->SetGameObject(m_GreenDetonator);
+        m_GreenDetonatorBody->SetPosition(Math::PixelsToMeters(m_GreenDetonator->GetPosition()));
+        m_GreenDetonatorBody->SetSensor(true);
+
+        //Tag the physics bodies, so the contacts can tell which objects collided, and set the
+        //collision filters, the pairs that can never interact are rejected by the broadphase
+        Tank* tanks[] = { m_BlueTank, m_GreenTank, m_ExplodedTank };
+        for (unsigned int i = 0; i < 3; i++)
+        {
+            tanks[i]->GetPhysicsBody()->SetUserTag(PhysicsBodyTag_Tank);
+            tanks[i]->GetPhysicsBody()->SetUserId(i);
+            tanks[i]->GetPhysicsBody()->SetCategoryBits(COLLISION_CATEGORY_TANK);
+            tanks[i]->GetPhysicsBody()->SetMaskBits(COLLISION_MASK_TANK);
+        }
+
+        for (unsigned int i = 0; i < SHELL_POOL_SIZE; i++)
+        {
+            m_Shells[i]->GetPhysicsBody()->SetUserTag(PhysicsBodyTag_Shell);
+            m_Shells[i]->GetPhysicsBody()->SetUserId(i);
+            m_Shells[i]->GetPhysicsBody()->SetCategoryBits(COLLISION_CATEGORY_SHELL);
+            m_Shells[i]->GetPhysicsBody()->SetMaskBits(COLLISION_MASK_SHELL);
+        }
 
-        //Create the Physics body to attach to the detonators;
-        Physics::Body* physicsBodyBlue = Physics::World::GetInstance()->CreateBody(circleCollider, density);
-        physicsBodyBlue->SetGameObject(m_BlueDetonator);
-        physicsBodyBlue->SetPosition(Math::PixelsToMeters(m_BlueDetonator->GetPosition()));
-        physicsBodyBlue->SetLinearDamping(vec2(0.2f, 0.2f));
-        physicsBodyBlue->SetAngularDamping(1.0f);
+        for (unsigned int i = 0; i < AMOUNT_OF_BARRELS; i++)
+        {
+            m_Barrel[i]->GetPhysicsBody()->SetUserTag(PhysicsBodyTag_Barrel);
+            m_Barrel[i]->GetPhysicsBody()->SetUserId(i);
+            m_Barrel[i]->GetPhysicsBody()->SetCategoryBits(COLLISION_CATEGORY_BARREL);
+            m_Barrel[i]->GetPhysicsBody()->SetMaskBits(COLLISION_MASK_BARREL);
+        }
 
-        Physics::Body* physicsBodyGreen = Physics::World::GetInstance()->CreateBody(circleCollider, density);
-        physicsBodyGreen->SetGameObject(m_GreenDetonator);
-        physicsBodyGreen->SetPosition(Math::PixelsToMeters(m_GreenDetonator->GetPosition()));
-        physicsBodyGreen->SetLinearDamping(vec2(0.2f, 0.2f));
-        physicsBodyGreen->SetAngularDamping(1.0f);
+        m_BlueDetonatorBody->SetUserTag(PhysicsBodyTag_Detonator);
+        m_BlueDetonatorBody->SetUserId(0);
+        m_BlueDetonatorBody->SetCategoryBits(COLLISION_CATEGORY_DETONATOR);
+        m_BlueDetonatorBody->SetMaskBits(COLLISION_MASK_DETONATOR);
+        m_GreenDetonatorBody->SetUserTag(PhysicsBodyTag_Detonator);
+        m_GreenDetonatorBody->SetUserId(1);
+        m_GreenDetonatorBody->SetCategoryBits(COLLISION_CATEGORY_DETONATOR);
+        m_GreenDetonatorBody->SetMaskBits(COLLISION_MASK_DETONATOR);
 
         m_Explosion = new AnimatedSprite();
         m_Explosion->SetIsEnabled(false);
@@ -240,6 +281,29 @@ namespace GameDev2D
             m_Barrel[i] = nullptr;
         }
 
+        //Destroy the detonators' physics bodies, and the collider they share
+        if (m_BlueDetonatorBody != nullptr)
+        {
+            Physics::Collider* collider = m_BlueDetonatorBody->GetCollider();
+            m_Context->GetWorld()->DestroyBody(m_BlueDetonatorBody);
+            m_Context->GetWorld()->DestroyBody(m_GreenDetonatorBody);
+            m_Context->GetWorld()->DestroyCollider(collider);
+            m_BlueDetonatorBody = nullptr;
+            m_GreenDetonatorBody = nullptr;
+        }
+
+        if (m_BlueDetonator != nullptr)
+        {
+            delete m_BlueDetonator;
+            m_BlueDetonator = nullptr;
+        }
+
+        if (m_GreenDetonator != nullptr)
+        {
+            delete m_GreenDetonator;
+            m_GreenDetonator = nullptr;
+        }
+
         if (m_Background != nullptr)
         {
             delete m_Background;
@@ -267,8 +331,27 @@ namespace GameDev2D
 
         m_Explosion->Update(aDelta);
 
-        //Step the Physics World, it needs a 'fixed' time step
-        Physics::World::GetInstance()->Step(m_TimeStep);
+        //Update the Physics World, it takes as many 'fixed' time steps as fit in the frame's delta time
+        m_Context->GetWorld()->Update(aDelta);
+
+        //Handle the contacts that began during the physics steps, now that the bodies have finished moving
+        const vector<Physics::ContactEvent>& beginContacts = m_Context->GetWorld()->GetBeginContactEvents();
+        for (unsigned int i = 0; i < beginContacts.size(); i++)
+        {
+            HandleContactBegin(beginContacts.at(i).bodyA, beginContacts.at(i).bodyB);
+        }
+
+        //Set off the barrels close enough to an explosion, their own explosions are applied in the next physics
+        //step, so a chain reaction spreads out one step at a time. The barrels further away are only pushed
+        const vector<Physics::RadialImpulseHit>& explosionHits = m_Context->GetWorld()->GetRadialImpulseHits();
+        for (unsigned int i = 0; i < explosionHits.size(); i++)
+        {
+            Physics::Body* body = explosionHits.at(i).body;
+            if (body->GetUserTag() == PhysicsBodyTag_Barrel && explosionHits.at(i).distance < BARREL_CHAIN_RADIUS)
+            {
+                ExplodeBarrel(m_Barrel[body->GetUserId()]);
+            }
+        }
 
         //Update the Shells
         for (unsigned int i = 0; i < SHELL_POOL_SIZE; i++)
@@ -319,7 +402,7 @@ namespace GameDev2D
         m_ExplodedTank->Draw();
 
         //Draw the physics world
-        Physics::World::GetInstance()->DebugDraw();
+        m_Context->GetWorld()->DebugDraw();
 
 
         m_Explosion->Draw();
@@ -354,6 +437,9 @@ namespace GameDev2D
     {
         m_ScreenWidth = aWidth;
         m_ScreenHeight = aHeight;
+
+        //The shells are disabled once they leave the screen
+        m_Context->SetSize(aWidth, aHeight);
     }
 
     void Game::HandleEvent(Event* aEvent)
@@ -412,6 +498,11 @@ namespace GameDev2D
         return m_Camera;
     }
 
+    GameContext* Game::GetContext()
+    {
+        return m_Context;
+    }
+
     Shell* Game::GetShell()
     {
         for (unsigned int i = 0; i < SHELL_POOL_SIZE; i++)
@@ -443,8 +534,29 @@ namespace GameDev2D
 
     bool Game::CollisionCallback(Physics::Body* aBodyA, Physics::Body* aBodyB)
     {
-        bool handleCollisionResponse = true;
+        //This is called during the physics step, so it only decides the collision response,
+        //the game is updated after the step by HandleContactBegin()
+        Shell* shell = IsShell(aBodyA, aBodyB);
+        Barrel* barrel = IsBarrel(aBodyA, aBodyB);
+        Tank* tank = IsTank(aBodyA, aBodyB);
+
+        //We don't need to handle collision response when a barrel and a shell collide
+        if (shell != nullptr && barrel != nullptr)
+        {
+            return false;
+        }
 
+        //Tanks drive through the barrels that have been disabled
+        if (barrel != nullptr && tank != nullptr && barrel->IsEnabled() == false)
+        {
+            return false;
+        }
+
+        return true; //This will determine if we should handle collision response
+    }
+
+    void Game::HandleContactBegin(Physics::Body* aBodyA, Physics::Body* aBodyB)
+    {
         Shell* shell = IsShell(aBodyA, aBodyB);
         Barrel* barrel = IsBarrel(aBodyA, aBodyB);
         Tank* tank = IsTank(aBodyA, aBodyB);
@@ -507,53 +619,53 @@ namespace GameDev2D
             if (barrel->HasExploded() == false)
             {
                 //Explode the barrel
-                barrel->Explode();
+                ExplodeBarrel(barrel);
 
                 //Disable the shell
                 shell->SetIsEnabled(false);
-
-                if (barrel->GetPosition() == m_BlueDetonator->GetPosition())
-                {
-                    barrel->SetIsEnabled(false);
-                    m_BlueDetonator->SetIsEnabled(true);
-                }
-                if (barrel->GetPosition() == m_GreenDetonator->GetPosition())
-                {
-                    barrel->SetIsEnabled(false);
-                    m_GreenDetonator->SetIsEnabled(true);
-                }
-                m_Camera->Shake(1.0f, 0.2);
             }
-
-            //We don't need to handle collision response when a barrel and a shell collide
-            handleCollisionResponse = false;
         }
 
-        if (barrel != nullptr && tank != nullptr)
+        if (barrel != nullptr && tank != nullptr && barrel->IsEnabled() == true)
         {
-            if (barrel->IsEnabled() == false)
-            {
-                handleCollisionResponse = false;
-            }
-            else
-            {
-                handleCollisionResponse = true;
-            }
-
             Log("Collision!");
         }
+    }
+
+    void Game::ExplodeBarrel(Barrel* aBarrel)
+    {
+        if (aBarrel->HasExploded() == true)
+        {
+            return;
+        }
 
-        return handleCollisionResponse; //This will determine if we should handle collision response
+        //Explode the barrel, this also pushes away the bodies around it
+        aBarrel->Explode();
+
+        if (aBarrel->GetPosition() == m_BlueDetonator->GetPosition())
+        {
+            aBarrel->SetIsEnabled(false);
+            m_BlueDetonator->SetIsEnabled(true);
+        }
+        if (aBarrel->GetPosition() == m_GreenDetonator->GetPosition())
+        {
+            aBarrel->SetIsEnabled(false);
+            m_GreenDetonator->SetIsEnabled(true);
+        }
+        m_Camera->Shake(1.0f, 0.2);
     }
 
     Shell* Game::IsShell(Physics::Body* aBodyA, Physics::Body* aBodyB)
     {
-        for (unsigned int i = 0; i < SHELL_POOL_SIZE; i++)
+        //The user tag says what kind of object a body belongs to, and the user id which one it is
+        if (aBodyA->GetUserTag() == PhysicsBodyTag_Shell)
         {
-            if (aBodyA->GetGameObject() == m_Shells[i] || aBodyB->GetGameObject() == m_Shells[i])
-            {
-                return m_Shells[i];
-            }
+            return m_Shells[aBodyA->GetUserId()];
+        }
+
+        if (aBodyB->GetUserTag() == PhysicsBodyTag_Shell)
+        {
+            return m_Shells[aBodyB->GetUserId()];
         }
 
         //If this return was reached it means neither Physics::Body is a Shell object, return a nullptr
@@ -562,12 +674,14 @@ namespace GameDev2D
 
     Barrel* Game::IsBarrel(Physics::Body* aBodyA, Physics::Body* aBodyB)
     {
-        for (unsigned int i = 0; i < AMOUNT_OF_BARRELS; i++)
+        if (aBodyA->GetUserTag() == PhysicsBodyTag_Barrel)
         {
-            if (aBodyA->GetGameObject() == m_Barrel[i] || aBodyB->GetGameObject() == m_Barrel[i])
-            {
-                return m_Barrel[i];
-            }
+            return m_Barrel[aBodyA->GetUserId()];
+        }
+
+        if (aBodyB->GetUserTag() == PhysicsBodyTag_Barrel)
+        {
+            return m_Barrel[aBodyB->GetUserId()];
         }
 
         //If this return was reached it means neither Physics::Body is a Barrel object, return a nullptr
@@ -576,14 +690,15 @@ namespace GameDev2D
 
     Tank* Game::IsTank(Physics::Body* aBodyA, Physics::Body* aBodyB)
     {
-        if (aBodyA->GetGameObject() == m_GreenTank || aBodyB->GetGameObject() == m_GreenTank)
+        //The exploded tank isn't one of the player's tanks
+        if (aBodyA->GetUserTag() == PhysicsBodyTag_Tank && aBodyA->GetGameObject() != m_ExplodedTank)
         {
-            return m_GreenTank;
+            return (Tank*)aBodyA->GetGameObject();
         }
 
-        if (aBodyA->GetGameObject() == m_BlueTank || aBodyB->GetGameObject() == m_BlueTank)
+        if (aBodyB->GetUserTag() == PhysicsBodyTag_Tank && aBodyB->GetGameObject() != m_ExplodedTank)
         {
-            return m_BlueTank;
+            return (Tank*)aBodyB->GetGameObject();
         }
 
         return nullptr;
@@ -591,11 +706,11 @@ namespace GameDev2D
 
     Sprite* Game::IsDetonator(Physics::Body* aBodyA, Physics::Body* aBodyB)
     {
-        if (aBodyA->GetGameObject() == m_BlueDetonator || aBodyB->GetGameObject() == m_BlueDetonator)
-            return m_BlueDetonator;
+        if (aBodyA->GetUserTag() == PhysicsBodyTag_Detonator)
+            return (Sprite*)aBodyA->GetGameObject();
 
-        if (aBodyA->GetGameObject() == m_GreenDetonator || aBodyB->GetGameObject() == m_GreenDetonator)
-            return m_GreenDetonator;
+        if (aBodyB->GetUserTag() == PhysicsBodyTag_Detonator)
+            return (Sprite*)aBodyB->GetGameObject();
 
         return nullptr;
     }
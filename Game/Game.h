@@ -21,6 +21,26 @@ namespace GameDev2D
     const unsigned int SHELL_POOL_SIZE = 6;
     const unsigned int AMOUNT_OF_BARRELS = 48;
 
+    //The user tags of the physics bodies, the user id is the object's index in its array
+    enum PhysicsBodyTag
+    {
+        PhysicsBodyTag_None = 0,
+        PhysicsBodyTag_Tank,
+        PhysicsBodyTag_Shell,
+        PhysicsBodyTag_Barrel,
+        PhysicsBodyTag_Detonator
+    };
+
+    //Collision categories, the physics bodies only collide with the categories in their mask
+    const unsigned short COLLISION_CATEGORY_TANK = 0x0001;
+    const unsigned short COLLISION_CATEGORY_SHELL = 0x0002;
+    const unsigned short COLLISION_CATEGORY_BARREL = 0x0004;
+    const unsigned short COLLISION_CATEGORY_DETONATOR = 0x0008;
+    const unsigned short COLLISION_MASK_TANK = 0xffff;
+    const unsigned short COLLISION_MASK_SHELL = 0xffff;
+    const unsigned short COLLISION_MASK_BARREL = COLLISION_CATEGORY_TANK | COLLISION_CATEGORY_SHELL;      //Barrels and detonators sit still, they never push each other
+    const unsigned short COLLISION_MASK_DETONATOR = COLLISION_CATEGORY_TANK;                               //Detonators are sensors, only the tanks set them off
+
     //Forward declarations
     class Camera;
     class Event;
@@ -32,6 +52,7 @@ namespace GameDev2D
     class Tank;
     class Shell;
     class Barrel;
+    class GameContext;
 
     //Forward declare physics classes
     namespace Physics
@@ -43,7 +64,8 @@ namespace GameDev2D
     class Game : public BaseObject, public Physics::WorldListener
     {
     public:
-        Game();
+        //The Game creates its objects, and their physics bodies, in the context's World
+        Game(GameContext* context);
         ~Game();
 
         //Update game content in this method
@@ -70,20 +92,29 @@ namespace GameDev2D
         //Returns a pointer to the Game's camera object
         Camera* GetCamera();
 
+        //Returns the context the Game runs in
+        GameContext* GetContext();
+
         //Returns a disabled Shell object from the Shell object pool
         Shell* GetShell();
 
         //Updates and handles input for a Tank object
         void UpdateTank(Tank* aTank, double aDelta);
 
-        //Handle collision between bodies
+        //Decides if a contact gets a collision response, called during the physics step
         bool CollisionCallback(Physics::Body* bodyA, Physics::Body* bodyB);
 
-        //Conveniance method to determine if a Phyiscs::Body is a Shell object
+        //Handle collision between bodies, called after the physics step for each contact that began
+        void HandleContactBegin(Physics::Body* bodyA, Physics::Body* bodyB);
+
+        //Explodes the barrel, if it hasn't already, and uncovers the detonator hidden under it
+        void ExplodeBarrel(Barrel* barrel);
+
+        //Conveniance method to determine if a Phyiscs::Body is a Shell object, using the Body's user tag
         //Method will return nullptr if neither Phyiscs::Body is a Shell
         Shell* IsShell(Physics::Body* bodyA, Physics::Body* bodyB);
 
-        //Conveniance method to determine if a Phyiscs::Body is a Barrel object
+        //Conveniance method to determine if a Phyiscs::Body is a Barrel object, using the Body's user tag
         //Method will return nullptr if neither Phyiscs::Body is a Barrel
         Barrel* IsBarrel(Physics::Body* bodyA, Physics::Body* bodyB);
 
@@ -93,6 +124,7 @@ namespace GameDev2D
 
     private:
         //Member variables
+        GameContext* m_Context;
         Camera* m_Camera;
         Tank* m_BlueTank;
         Tank* m_GreenTank;
@@ -102,8 +134,9 @@ namespace GameDev2D
         Sprite* m_Background;
 		Sprite* m_BlueDetonator;
 		Sprite* m_GreenDetonator;
+		Physics::Body* m_BlueDetonatorBody;
+		Physics::Body* m_GreenDetonatorBody;
         AnimatedSprite* m_Explosion;
-        double m_TimeStep;
         float m_ScreenWidth;
         float m_ScreenHeight;
     };
@@ -0,0 +1,78 @@
+#include "GameContext.h"
+#include "Game.h"
+#include "../Source/Services/Random/Random.h"
+#include "../Source/Physics/World.h"
+
+
+namespace GameDev2D
+{
+    GameContext::GameContext(double aFixedTimeStep, uint64_t aSeed) : BaseObject("GameContext"),
+        m_World(nullptr),
+        m_Random(nullptr),
+        m_Game(nullptr),
+        m_Width(WINDOWS_DEFAULT_WIDTH),
+        m_Height(WINDOWS_DEFAULT_HEIGHT)
+    {
+        //Create the random number generator
+        m_Random = new Random();
+        m_Random->SetSeed(aSeed);
+
+        //Create the physics world, its snapshots save and restore the context's random numbers
+        m_World = new Physics::World();
+        m_World->SetFixedTimeStep(aFixedTimeStep);
+        m_World->SetRandom(m_Random);
+    }
+
+    GameContext::~GameContext()
+    {
+        //The Game's objects destroy their physics bodies, so the Game is deleted before the World
+        SafeDelete(m_Game);
+        SafeDelete(m_World);
+        SafeDelete(m_Random);
+    }
+
+    void GameContext::CreateGame()
+    {
+        assert(m_Game == nullptr);
+        m_Game = new Game(this);
+    }
+
+    void GameContext::Update(double aDelta)
+    {
+        if (m_Game != nullptr)
+        {
+            m_Game->Update(aDelta);
+        }
+    }
+
+    void GameContext::SetSize(float aWidth, float aHeight)
+    {
+        m_Width = aWidth;
+        m_Height = aHeight;
+    }
+
+    float GameContext::GetWidth()
+    {
+        return m_Width;
+    }
+
+    float GameContext::GetHeight()
+    {
+        return m_Height;
+    }
+
+    Physics::World* GameContext::GetWorld()
+    {
+        return m_World;
+    }
+
+    Random* GameContext::GetRandom()
+    {
+        return m_Random;
+    }
+
+    Game* GameContext::GetGame()
+    {
+        return m_Game;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef __GAME_CONTEXT_H__
+#define __GAME_CONTEXT_H__
+
+#include "../Source/Core/BaseObject.h"
+
+
+namespace GameDev2D
+{
+    //Forward declarations
+    class Game;
+    class Random;
+    namespace Physics
+    {
+        class World;
+    }
+
+    //The GameContext owns the state of a single game simulation: its physics World, its random
+    //number generator and the Game. The Game and its objects get the World and the Random from
+    //their context, never from a global, so several contexts can be stepped at once, each on its
+    //own thread. The rendering, audio and input services are shared by every context, through
+    //the ServiceLocator
+    class GameContext : public BaseObject
+    {
+    public:
+        //Creates the context's World, stepped at the fixed time step, and its Random, seeded with the seed
+        GameContext(double fixedTimeStep, uint64_t seed);
+        ~GameContext();
+
+        //Creates the Game in this context. The Game's sprites load their textures through the
+        //shared services, so the ServiceLocator's default services must be loaded first
+        void CreateGame();
+
+        //Updates the Game, which steps the context's World
+        void Update(double delta);
+
+        //The size of the arena, in pixels, the shells that leave it are disabled
+        void SetSize(float width, float height);
+        float GetWidth();
+        float GetHeight();
+
+        //Returns the context's World, Random and Game
+        Physics::World* GetWorld();
+        Random* GetRandom();
+        Game* GetGame();
+
+    private:
+        //Member variables
+        Physics::World* m_World;
+        Random* m_Random;
+        Game* m_Game;
+        float m_Width;
+        float m_Height;
+    };
+}
+
+#endif
@@ -10,6 +10,7 @@
 #include "../Source/Services/ServiceLocator.h"
 #include "../Source/Services/Graphics/Graphics.h"
 #include "../Source/Services/ShaderManager/ShaderManager.h"
+#include "../Source/Graphics/Core/SpriteBatch.h"
 
 
 namespace GameDev2D
@@ -149,6 +150,9 @@ namespace GameDev2D
                 UpdateVertexBuffer();
             }
 
+            //Draw the sprites batched before the polygon, so they stay underneath it
+            ServiceLocator::GetGraphics()->GetSpriteBatch()->Flush();
+
             //Use the shader
             m_Shader->Use();
 
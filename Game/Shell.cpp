@@ -1,7 +1,6 @@
 #include "Shell.h"
 #include "Sprite.h"
-#include "../Source/Services/ServiceLocator.h"
-#include "../Source/Platforms/PlatformLayer.h"
+#include "GameContext.h"
 #include "../Source/Utils/Math/Math.h"
 #include "../Source/Physics/Body.h"
 #include "../Source/Physics/BoxCollider.h"
@@ -11,7 +10,8 @@
 
 namespace GameDev2D
 {
-    Shell::Shell() : GameObject("Shell"), 
+    Shell::Shell(GameContext* aContext) : GameObject("Shell"),
+        m_Context(aContext),
         m_Sprite(nullptr),
         m_PhysicsBody(nullptr)
     {
@@ -26,19 +26,30 @@ namespace GameDev2D
         //Initialize the parameters to create the Physics body
         float density = 1.0f;
         float radius = Math::PixelsToMeters(GetHeight() / 2.0f);
-        Physics::CircleCollider* circleCollider = new Physics::CircleCollider(radius);
+        Physics::CircleCollider* circleCollider = m_Context->GetWorld()->CreateCircleCollider(radius);
 
         //Create the Physics body to attach to the tank
-        m_PhysicsBody = Physics::World::GetInstance()->CreateBody(circleCollider, density);
+        m_PhysicsBody = m_Context->GetWorld()->CreateBody(circleCollider, density);
         m_PhysicsBody->SetGameObject(this);
         m_PhysicsBody->SetLinearDamping(vec2(0.2f, 0.2));
         m_PhysicsBody->SetAngularDamping(1.0f);
+
+        //Shells are fast enough to pass through a barrel in a single step
+        m_PhysicsBody->SetBullet(true);
     }
 
     Shell::~Shell()
     {
         m_Sprite = nullptr;
-        m_PhysicsBody = nullptr;
+
+        //Destroy the physics body and its collider
+        if (m_PhysicsBody != nullptr)
+        {
+            Physics::Collider* collider = m_PhysicsBody->GetCollider();
+            m_Context->GetWorld()->DestroyBody(m_PhysicsBody);
+            m_Context->GetWorld()->DestroyCollider(collider);
+            m_PhysicsBody = nullptr;
+        }
     }
 
     void Shell::Update(double aDelta)
@@ -46,9 +57,9 @@ namespace GameDev2D
         //If the shell is enabled, update it and check it's bounds
         if (IsEnabled() == true)
         {
-            //Get the screen width and height 
-            float screenWidth = ServiceLocator::GetPlatformLayer()->GetWidth();
-            float screenHeight = ServiceLocator::GetPlatformLayer()->GetHeight();
+            //Get the arena's width and height
+            float screenWidth = m_Context->GetWidth();
+            float screenHeight = m_Context->GetHeight();
 
             //If the shell went off-screen, disable it
             if (GetX() < 0.0f || GetX() > screenWidth || GetY() < 0.0f || GetY() > screenHeight)
@@ -72,6 +83,11 @@ namespace GameDev2D
         return m_Sprite->GetHeight();
     }
 
+    Physics::Body* Shell::GetPhysicsBody()
+    {
+        return m_PhysicsBody;
+    }
+
     void Shell::Fire(vec2 aPosition, float aAngleInDegrees)
     {
         //Enable the shell
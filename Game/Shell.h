@@ -12,6 +12,7 @@ namespace GameDev2D
 {
     //Forward declaration
     class Sprite;
+    class GameContext;
     namespace Physics
     {
         class Body;
@@ -20,7 +21,7 @@ namespace GameDev2D
     class Shell : public GameObject
     {
     public:
-        Shell();
+        Shell(GameContext* context);
         ~Shell();
 
         void Update(double delta);
@@ -30,8 +31,11 @@ namespace GameDev2D
 
         void Fire(vec2 position, float angleInDegrees);
 
+        Physics::Body* GetPhysicsBody();
+
     private:
         //Member variables
+        GameContext* m_Context;
         Sprite* m_Sprite;
         Physics::Body* m_PhysicsBody;
     };
@@ -1,5 +1,6 @@
 #include "Tank.h"
 #include "Sprite.h"
+#include "GameContext.h"
 #include "../Source/Services/ServiceLocator.h"
 #include "../Source/Utils/Math/Math.h"
 #include "../Source/Physics/Body.h"
@@ -10,7 +11,8 @@
 
 namespace GameDev2D
 {
-    Tank::Tank(TankColor aTankColor) : GameObject("Tank"),
+    Tank::Tank(GameContext* aContext, TankColor aTankColor) : GameObject("Tank"),
+        m_Context(aContext),
         m_TankColor(aTankColor),
         m_Body(nullptr),
         m_Turret(nullptr),
@@ -53,10 +55,10 @@ namespace GameDev2D
         float density = 2.0f;
         float width = Math::PixelsToMeters(GetWidth());
         float height = Math::PixelsToMeters(GetHeight());
-        Physics::BoxCollider* boxCollider = new Physics::BoxCollider(width, height);
+        Physics::BoxCollider* boxCollider = m_Context->GetWorld()->CreateBoxCollider(width, height);
 
         //Create the Physics body to attach to the tank
-        m_PhysicsBody = Physics::World::GetInstance()->CreateBody(boxCollider, density);
+        m_PhysicsBody = m_Context->GetWorld()->CreateBody(boxCollider, density);
         m_PhysicsBody->SetGameObject(this);
         m_PhysicsBody->SetPosition(Math::PixelsToMeters(GetWorldPosition()));
         m_PhysicsBody->SetAngle(Math::DegreesToRadians(GetWorldAngle()));
@@ -69,7 +71,15 @@ namespace GameDev2D
     {
         m_Body = nullptr;
         m_Turret = nullptr;
-        m_PhysicsBody = nullptr;
+
+        //Destroy the physics body and its collider
+        if (m_PhysicsBody != nullptr)
+        {
+            Physics::Collider* collider = m_PhysicsBody->GetCollider();
+            m_Context->GetWorld()->DestroyBody(m_PhysicsBody);
+            m_Context->GetWorld()->DestroyCollider(collider);
+            m_PhysicsBody = nullptr;
+        }
     }
 
     void Tank::Update(double aDelta)
@@ -40,6 +40,7 @@ namespace GameDev2D
 
     //Forward declarations
     class Sprite;
+    class GameContext;
     namespace Physics
     {
         class Body;
@@ -48,7 +49,7 @@ namespace GameDev2D
     class Tank : public GameObject
     {
     public:
-        Tank(TankColor tankColor);
+        Tank(GameContext* context, TankColor tankColor);
         ~Tank();
 
         void Update(double delta);
@@ -76,6 +77,7 @@ namespace GameDev2D
 		Physics::Body* GetPhysicsBody();
 
     private:
+        GameContext* m_Context;
         TankColor m_TankColor;
         KeyCode m_Input[TankInputCount];
         Sprite* m_Body;
@@ -32,6 +32,7 @@
 
 //Graphics settings
 #define GRAPHICS_DEFAULT_CLEAR_COLOR Color::CornflowerBlueColor()
+#define GRAPHICS_SPRITE_BATCHING 1 //Merges the frame's TextureFrame draws into as few draw calls as possible
 
 //Debug Draw
 #define DRAW_DEBUG_FPS_COUNTER 1
@@ -48,6 +49,16 @@
 
 #define DRAW_DEBUG_ANCHORPOINTER_SIZE 15.0f
 
+//Physics settings
+#define PHYSICS_USE_SIMD 1 //Uses SSE/AVX for the physics world's batched passes, when the compiler supports them
+//Deterministic mode is chosen at compile time, set PHYSICS_DETERMINISTIC to 1 here (or pass -DPHYSICS_DETERMINISTIC=1
+//to the compiler) and rebuild every source file. It turns off FMA contraction and uses platform independent sine and
+//cosine, so every machine running the same build and seed produces the same World::ComputeChecksum() each step.
+//Lockstep and replays also need all of a game's random numbers to come from its GameContext's Random
+#ifndef PHYSICS_DETERMINISTIC
+    #define PHYSICS_DETERMINISTIC 0 //Uses a strict float policy and platform independent sine and cosine, for lockstep and replays
+#endif
+
 //Errors
 #define THROW_EXCEPTION_ON_ERROR 1
 
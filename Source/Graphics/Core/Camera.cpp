@@ -8,6 +8,7 @@
 
 #include "Camera.h"
 #include "../../Services/ServiceLocator.h"
+#include "../../Services/Random/Random.h"
 #include "../../Platforms/PlatformLayer.h"
 #include "matrix_transform.hpp"
 #include "quaternion.hpp"
@@ -27,7 +28,8 @@ namespace GameDev2D
         m_ShakeMagnitude(0.0f),
         m_ShakeDuration(0.0),
         m_ShakeTimer(0.0f),
-        m_ShakeOffset(vec2(0.0f, 0.0f))
+        m_ShakeOffset(vec2(0.0f, 0.0f)),
+        m_Random(nullptr)
     {
         //Listener for the resize event, we need to know if the screen resizes to reset the matrices
         ServiceLocator::GetPlatformLayer()->AddEventListener(this, RESIZE_EVENT);
@@ -252,9 +254,18 @@ namespace GameDev2D
         }
     }
 
+    void Camera::SetRandom(Random* aRandom)
+    {
+        m_Random = aRandom;
+    }
+
     float Camera::RandomShake(float aMagnitude)
     {
-        float random = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
-        return (random * 2.0f - 1.0f) * aMagnitude;
+        //A camera without a random number generator doesn't shake
+        if (m_Random == nullptr)
+        {
+            return 0.0f;
+        }
+        return m_Random->NextFloat(-1.0f, 1.0f) * aMagnitude;
     }
 }
\ No newline at end of file
@@ -17,6 +17,9 @@ using namespace glm;
 
 namespace GameDev2D
 {
+    //Forward declaration
+    class Random;
+
     //2D Orthographic camera, used by every scene in the game. A scene can have more than one camera,
     //but currently the Graphics service only supports one active camera at a time. The camera positions,
     //orientation, and zoom can be set to animate over a duration, an easing function can be applied,
@@ -69,6 +72,11 @@ namespace GameDev2D
         //Shakes the camera for a magnitude over a certain duration
         void Shake(float magnitude, double duration);
 
+        //Sets the random number generator the shake offsets are drawn from, a Game's camera uses its
+        //GameContext's Random, so the shake is part of the context's saved and replayed state. A camera
+        //without a Random doesn't shake
+        void SetRandom(Random* random);
+
         //Resets the projection and view matrices
         void ResetProjectionMatrix();
         void ResetViewMatrix();
@@ -92,6 +100,7 @@ namespace GameDev2D
         double m_ShakeDuration;
         double m_ShakeTimer;
         vec2 m_ShakeOffset;
+        Random* m_Random;
     };
 }
 
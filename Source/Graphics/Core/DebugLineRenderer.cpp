@@ -0,0 +1,230 @@
+#include "DebugLineRenderer.h"
+#include "Shader.h"
+#include "SpriteBatch.h"
+#include "../OpenGL.h"
+#include "../../Services/ServiceLocator.h"
+#include "../../Services/Graphics/Graphics.h"
+#include "../../Services/ShaderManager/ShaderManager.h"
+
+
+namespace GameDev2D
+{
+    //Local constants
+    const unsigned int DEBUG_LINE_VERTEX_SIZE = 2;
+    const unsigned int DEBUG_LINE_COLOR_SIZE = 4;
+    const unsigned int DEBUG_LINE_STRIDE = DEBUG_LINE_VERTEX_SIZE + DEBUG_LINE_COLOR_SIZE;
+
+    DebugLineRenderer::DebugLineRenderer() : BaseObject("DebugLineRenderer"),
+        m_Shader(nullptr),
+        m_VertexArrayObject(0),
+        m_VertexBufferObject(0),
+        m_ContainsAlpha(false)
+    {
+        //Calculate the unit circle once, every circle is scaled and translated from it
+        for (unsigned int i = 0; i < DEBUG_LINE_CIRCLE_SEGMENTS; i++)
+        {
+            float angle = 2.0f * (float)M_PI * (float)i / (float)DEBUG_LINE_CIRCLE_SEGMENTS;
+            m_UnitCircle[i] = vec2(cosf(angle), sinf(angle));
+        }
+
+        //Set the shader as the default passthrough shader
+        m_Shader = ServiceLocator::GetShaderManager()->GetPassthroughShader();
+        if (m_Shader == nullptr)
+        {
+            return;
+        }
+
+        //Generate the VAO and the VBO, the VBO's data is replaced every frame
+        glGenVertexArrays(1, &m_VertexArrayObject);
+        glGenBuffers(1, &m_VertexBufferObject);
+
+        //Bind the VAO and the VBO
+        ServiceLocator::GetGraphics()->BindVertexArray(m_VertexArrayObject);
+        glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
+
+        //Use the shader
+        m_Shader->Use();
+
+        //Enable and set the shader's vertices attribute
+        int verticesIndex = m_Shader->GetAttribute("a_vertices");
+        glEnableVertexAttribArray(verticesIndex);
+        long verticesOffset = 0;
+        glVertexAttribPointer(verticesIndex, DEBUG_LINE_VERTEX_SIZE, GL_FLOAT, GL_FALSE, sizeof(float) * DEBUG_LINE_STRIDE, (const GLvoid*)verticesOffset);
+
+        //Enable and set the shader's color attribute
+        int colorIndex = m_Shader->GetAttribute("a_sourceColor");
+        glEnableVertexAttribArray(colorIndex);
+        long colorOffset = DEBUG_LINE_VERTEX_SIZE * sizeof(float);
+        glVertexAttribPointer(colorIndex, DEBUG_LINE_COLOR_SIZE, GL_FLOAT, GL_FALSE, sizeof(float) * DEBUG_LINE_STRIDE, (const GLvoid*)colorOffset);
+
+        //Unbind the VAO
+        ServiceLocator::GetGraphics()->BindVertexArray(0);
+    }
+
+    DebugLineRenderer::~DebugLineRenderer()
+    {
+        //Set the shader to null
+        m_Shader = nullptr;
+
+        //Delete the VBO
+        if (m_VertexBufferObject != 0)
+        {
+            glDeleteBuffers(1, &m_VertexBufferObject);
+            m_VertexBufferObject = 0;
+        }
+
+        //Delete the VAO
+        if (m_VertexArrayObject != 0)
+        {
+            glDeleteVertexArrays(1, &m_VertexArrayObject);
+            m_VertexArrayObject = 0;
+        }
+    }
+
+    void DebugLineRenderer::AddLine(vec2 aStart, vec2 aEnd, Color aColor)
+    {
+        vec4 color = aColor.Get();
+        AddVertex(aStart, color);
+        AddVertex(aEnd, color);
+    }
+
+    void DebugLineRenderer::AddCircle(vec2 aCenter, float aRadius, float aAngle, Color aColor)
+    {
+        vec4 color = aColor.Get();
+
+        //Scale and translate the unit circle
+        vec2 previous = aCenter + m_UnitCircle[DEBUG_LINE_CIRCLE_SEGMENTS - 1] * aRadius;
+        for (unsigned int i = 0; i < DEBUG_LINE_CIRCLE_SEGMENTS; i++)
+        {
+            vec2 current = aCenter + m_UnitCircle[i] * aRadius;
+            AddVertex(previous, color);
+            AddVertex(current, color);
+            previous = current;
+        }
+
+        //A line from the center shows the circle's angle
+        AddVertex(aCenter, color);
+        AddVertex(aCenter + vec2(cosf(aAngle), sinf(aAngle)) * aRadius, color);
+    }
+
+    void DebugLineRenderer::AddBox(vec2 aCenter, float aWidth, float aHeight, float aAngle, Color aColor)
+    {
+        //Scale, rotate and translate the unit box's corners
+        vec2 axisX = vec2(cosf(aAngle), sinf(aAngle)) * (aWidth * 0.5f);
+        vec2 axisY = vec2(-sinf(aAngle), cosf(aAngle)) * (aHeight * 0.5f);
+        vec2 corners[4];
+        corners[0] = aCenter - axisX - axisY;
+        corners[1] = aCenter + axisX - axisY;
+        corners[2] = aCenter + axisX + axisY;
+        corners[3] = aCenter - axisX + axisY;
+
+        AddLineLoop(corners, 4, aColor);
+    }
+
+    void DebugLineRenderer::AddRect(vec2 aLowerBound, vec2 aUpperBound, Color aColor)
+    {
+        vec2 corners[4];
+        corners[0] = aLowerBound;
+        corners[1] = vec2(aUpperBound.x, aLowerBound.y);
+        corners[2] = aUpperBound;
+        corners[3] = vec2(aLowerBound.x, aUpperBound.y);
+
+        AddLineLoop(corners, 4, aColor);
+    }
+
+    void DebugLineRenderer::AddLineLoop(const vec2* aVertices, unsigned int aCount, Color aColor)
+    {
+        //Safety check the count
+        if (aCount < 2)
+        {
+            return;
+        }
+
+        vec4 color = aColor.Get();
+        for (unsigned int i = 0; i < aCount; i++)
+        {
+            AddVertex(aVertices[i], color);
+            AddVertex(aVertices[(i + 1) % aCount], color);
+        }
+    }
+
+    void DebugLineRenderer::Draw()
+    {
+        //Safety check the shader and the lines
+        if (m_Shader == nullptr || m_Vertices.empty() == true)
+        {
+            Clear();
+            return;
+        }
+
+        //Cache the graphics service
+        Graphics* graphics = ServiceLocator::GetGraphics();
+
+        //Draw the sprites batched before the lines, so they stay underneath them
+        graphics->GetSpriteBatch()->Flush();
+
+        //Use the shader and bind the vertex array object
+        m_Shader->Use();
+        graphics->BindVertexArray(m_VertexArrayObject);
+
+        //Replace the vertex buffer's data with this frame's lines
+        glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * m_Vertices.size(), &m_Vertices[0], GL_DYNAMIC_DRAW);
+
+        //Set the model view projection matrix, the vertices are already in world space
+        mat4 mvp = graphics->GetProjectionMatrix() * graphics->GetViewMatrix();
+        glUniformMatrix4fv(m_Shader->GetModelViewProjectionUniform(), 1, 0, &mvp[0][0]);
+
+        //Validate the shader
+        if (m_Shader->Validate() == true)
+        {
+            //Enable blending, if any of the lines are see through
+            if (m_ContainsAlpha == true)
+            {
+                graphics->EnableBlending();
+            }
+
+            //Render every line
+            glDrawArrays(GL_LINES, 0, (GLsizei)(m_Vertices.size() / DEBUG_LINE_STRIDE));
+
+            //Disable blending, if we did in fact have it enabled
+            if (m_ContainsAlpha == true)
+            {
+                graphics->DisableBlending();
+            }
+        }
+
+        //Unbind the vertex array
+        graphics->BindVertexArray(0);
+
+        //The lines are added again every frame
+        Clear();
+    }
+
+    void DebugLineRenderer::Clear()
+    {
+        m_Vertices.clear();
+        m_ContainsAlpha = false;
+    }
+
+    unsigned int DebugLineRenderer::GetLineCount()
+    {
+        return m_Vertices.size() / (DEBUG_LINE_STRIDE * 2);
+    }
+
+    void DebugLineRenderer::AddVertex(vec2 aPosition, const vec4& aColor)
+    {
+        m_Vertices.push_back(aPosition.x);
+        m_Vertices.push_back(aPosition.y);
+        m_Vertices.push_back(aColor.r);
+        m_Vertices.push_back(aColor.g);
+        m_Vertices.push_back(aColor.b);
+        m_Vertices.push_back(aColor.a);
+
+        //Check to see if the vertex has an alpha and will need blending
+        if (aColor.a < 1.0f)
+        {
+            m_ContainsAlpha = true;
+        }
+    }
+}
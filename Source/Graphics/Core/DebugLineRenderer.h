@@ -0,0 +1,67 @@
+#ifndef __GameDev2D__DebugLineRenderer__
+#define __GameDev2D__DebugLineRenderer__
+
+#include "../../Core/BaseObject.h"
+#include "Color.h"
+
+
+using namespace glm;
+using namespace std;
+
+namespace GameDev2D
+{
+    //Local constants
+    const unsigned int DEBUG_LINE_CIRCLE_SEGMENTS = 36;
+
+    //Forward declarations
+    class Shader;
+
+    //The DebugLineRenderer collects line segments over a frame and draws them all with a single draw call.
+    //Circles and boxes are built by scaling, rotating and translating a unit circle and a unit box that are
+    //computed once, so adding a shape doesn't call any trig functions or touch OpenGL. All positions are in
+    //pixels, in world space, the lines are drawn with the active camera's projection and view matrices
+    class DebugLineRenderer : public BaseObject
+    {
+    public:
+        DebugLineRenderer();
+        ~DebugLineRenderer();
+
+        //Adds a line segment
+        void AddLine(vec2 start, vec2 end, Color color);
+
+        //Adds a circle's outline, and a line from its center to its edge showing its angle (in radians)
+        void AddCircle(vec2 center, float radius, float angle, Color color);
+
+        //Adds the outline of a box centered on the center, rotated by the angle (in radians)
+        void AddBox(vec2 center, float width, float height, float angle, Color color);
+
+        //Adds an axis aligned rect's outline
+        void AddRect(vec2 lowerBound, vec2 upperBound, Color color);
+
+        //Adds a closed outline through the vertices
+        void AddLineLoop(const vec2* vertices, unsigned int count, Color color);
+
+        //Uploads the frame's lines to the vertex buffer, draws them in a single draw call and then clears them
+        void Draw();
+
+        //Removes every line, the vertices keep their memory
+        void Clear();
+
+        //Returns the number of lines added since the last Draw() or Clear()
+        unsigned int GetLineCount();
+
+    private:
+        //Appends a vertex, in pixels
+        void AddVertex(vec2 position, const vec4& color);
+
+        //Member variables
+        vector<float> m_Vertices;       //The position (x, y) and color (r, g, b, a) of each vertex, two vertices per line
+        vec2 m_UnitCircle[DEBUG_LINE_CIRCLE_SEGMENTS];
+        Shader* m_Shader;
+        unsigned int m_VertexArrayObject;
+        unsigned int m_VertexBufferObject;
+        bool m_ContainsAlpha;
+    };
+}
+
+#endif /* defined(__GameDev2D__DebugLineRenderer__) */
@@ -0,0 +1,261 @@
+#include "SpriteBatch.h"
+#include "Shader.h"
+#include "../OpenGL.h"
+#include "../Textures/Texture.h"
+#include "../Textures/TextureFrame.h"
+#include "../../Services/ServiceLocator.h"
+#include "../../Services/Graphics/Graphics.h"
+
+
+namespace GameDev2D
+{
+    //Local constants
+    const unsigned int SPRITE_BATCH_VERTEX_SIZE = 2;
+    const unsigned int SPRITE_BATCH_UV_SIZE = 2;
+    const unsigned int SPRITE_BATCH_COLOR_SIZE = 4;
+    const unsigned int SPRITE_BATCH_STRIDE = SPRITE_BATCH_VERTEX_SIZE + SPRITE_BATCH_UV_SIZE + SPRITE_BATCH_COLOR_SIZE;
+    const unsigned int SPRITE_BATCH_VERTICES_PER_SPRITE = 4;
+    const unsigned int SPRITE_BATCH_INDICES_PER_SPRITE = 6;
+
+    SpriteBatch::SpriteBatch() : BaseObject("SpriteBatch"),
+        m_TextureId(0),
+        m_Shader(nullptr),
+        m_IsBlended(false),
+        m_IsActive(false),
+        m_DrawCallCount(0),
+        m_SpriteCount(0),
+        m_VertexArrayObject(0),
+        m_VertexBufferObject(0),
+        m_IndexBufferObject(0)
+    {
+
+    }
+
+    SpriteBatch::~SpriteBatch()
+    {
+        //Set the shader to null
+        m_Shader = nullptr;
+
+        //Delete the VBO
+        if (m_VertexBufferObject != 0)
+        {
+            glDeleteBuffers(1, &m_VertexBufferObject);
+            m_VertexBufferObject = 0;
+        }
+
+        //Delete the index buffer object
+        if (m_IndexBufferObject != 0)
+        {
+            glDeleteBuffers(1, &m_IndexBufferObject);
+            m_IndexBufferObject = 0;
+        }
+
+        //Delete the VAO
+        if (m_VertexArrayObject != 0)
+        {
+            glDeleteVertexArrays(1, &m_VertexArrayObject);
+            m_VertexArrayObject = 0;
+        }
+    }
+
+    void SpriteBatch::Begin()
+    {
+        m_IsActive = true;
+        m_DrawCallCount = 0;
+        m_SpriteCount = 0;
+    }
+
+    void SpriteBatch::End()
+    {
+        Flush();
+        m_IsActive = false;
+    }
+
+    bool SpriteBatch::IsActive()
+    {
+        return m_IsActive;
+    }
+
+    void SpriteBatch::Draw(TextureFrame* aTextureFrame, const mat4& aModelMatrix)
+    {
+        //Safety check the texture and the shader
+        Texture* texture = aTextureFrame->GetTexture();
+        Shader* shader = aTextureFrame->GetShader();
+        if (texture == nullptr || shader == nullptr)
+        {
+            return;
+        }
+
+        //Blend if the texture has an alpha channel, the same as TextureFrame::Draw()
+        Color color = aTextureFrame->GetColor();
+        bool isBlended = aTextureFrame->GetFormat() == TextureFormat_RGBA || color.Alpha() != 1.0f;
+
+        //Draw the batched sprites if they can't be drawn together with this one
+        if (texture->GetId() != m_TextureId || shader != m_Shader || isBlended != m_IsBlended)
+        {
+            Flush();
+        }
+        else if (m_Vertices.size() >= SPRITE_BATCH_MAX_SPRITES * SPRITE_BATCH_VERTICES_PER_SPRITE * SPRITE_BATCH_STRIDE)
+        {
+            Flush();
+        }
+
+        m_TextureId = texture->GetId();
+        m_Shader = shader;
+        m_IsBlended = isBlended;
+
+        //The model matrix is a 2D transform, so the quad's corners are its translation plus its scaled x and y axes
+        vec2 size = aTextureFrame->GetSourceFrame().size;
+        vec2 origin = vec2(aModelMatrix[3].x, aModelMatrix[3].y);
+        vec2 axisX = vec2(aModelMatrix[0].x, aModelMatrix[0].y) * size.x;
+        vec2 axisY = vec2(aModelMatrix[1].x, aModelMatrix[1].y) * size.y;
+        vec2 corners[SPRITE_BATCH_VERTICES_PER_SPRITE];
+        corners[0] = origin;
+        corners[1] = origin + axisX;
+        corners[2] = origin + axisY;
+        corners[3] = origin + axisX + axisY;
+
+        //The uv coordinates of the same corners
+        vec2 lowerLeft;
+        vec2 upperRight;
+        aTextureFrame->GetUvCoordinates(&lowerLeft, &upperRight);
+        vec2 uvCoordinates[SPRITE_BATCH_VERTICES_PER_SPRITE];
+        uvCoordinates[0] = lowerLeft;
+        uvCoordinates[1] = vec2(upperRight.x, lowerLeft.y);
+        uvCoordinates[2] = vec2(lowerLeft.x, upperRight.y);
+        uvCoordinates[3] = upperRight;
+
+        //Append the vertices
+        for (unsigned int i = 0; i < SPRITE_BATCH_VERTICES_PER_SPRITE; i++)
+        {
+            m_Vertices.push_back(corners[i].x);
+            m_Vertices.push_back(corners[i].y);
+            m_Vertices.push_back(uvCoordinates[i].x);
+            m_Vertices.push_back(uvCoordinates[i].y);
+            m_Vertices.push_back(color.Red());
+            m_Vertices.push_back(color.Green());
+            m_Vertices.push_back(color.Blue());
+            m_Vertices.push_back(color.Alpha());
+        }
+
+        m_SpriteCount++;
+    }
+
+    void SpriteBatch::Flush()
+    {
+        //Is there anything to draw?
+        if (m_Vertices.empty() == true || m_Shader == nullptr)
+        {
+            return;
+        }
+
+        //Generate the buffers, if they haven't been generated yet
+        if (m_VertexArrayObject == 0)
+        {
+            CreateBuffers();
+        }
+
+        //Cache the graphics service
+        Graphics* graphics = ServiceLocator::GetGraphics();
+
+        //Use the shader and bind the vertex array object
+        m_Shader->Use();
+        graphics->BindVertexArray(m_VertexArrayObject);
+
+        //Replace the vertex buffer's data with the batched sprites
+        glBindBuffer(GL_ARRAY_BUFFER, m_VertexBufferObject);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * m_Vertices.size(), &m_Vertices[0], GL_DYNAMIC_DRAW);
+
+        //Set the shader's attributes, each shader can have them at different indices
+        int verticesIndex = m_Shader->GetAttribute("a_vertices");
+        glEnableVertexAttribArray(verticesIndex);
+        long verticesOffset = 0;
+        glVertexAttribPointer(verticesIndex, SPRITE_BATCH_VERTEX_SIZE, GL_FLOAT, GL_FALSE, sizeof(float) * SPRITE_BATCH_STRIDE, (const GLvoid*)verticesOffset);
+
+        int uvIndex = m_Shader->GetAttribute("a_textureCoordinates");
+        glEnableVertexAttribArray(uvIndex);
+        long uvOffset = SPRITE_BATCH_VERTEX_SIZE * sizeof(float);
+        glVertexAttribPointer(uvIndex, SPRITE_BATCH_UV_SIZE, GL_FLOAT, GL_FALSE, sizeof(float) * SPRITE_BATCH_STRIDE, (const GLvoid*)uvOffset);
+
+        int colorIndex = m_Shader->GetAttribute("a_textureColor");
+        glEnableVertexAttribArray(colorIndex);
+        long colorOffset = (SPRITE_BATCH_VERTEX_SIZE + SPRITE_BATCH_UV_SIZE) * sizeof(float);
+        glVertexAttribPointer(colorIndex, SPRITE_BATCH_COLOR_SIZE, GL_FLOAT, GL_FALSE, sizeof(float) * SPRITE_BATCH_STRIDE, (const GLvoid*)colorOffset);
+
+        //Set the model view projection matrix, the vertices are already in world space
+        mat4 mvp = graphics->GetProjectionMatrix() * graphics->GetViewMatrix();
+        glUniformMatrix4fv(m_Shader->GetModelViewProjectionUniform(), 1, 0, &mvp[0][0]);
+        glUniform1i(m_Shader->GetTextureUniform(), 0);
+
+        //Validate the shader
+        if (m_Shader->Validate() == true)
+        {
+            //Bind the texture
+            graphics->BindTexture(m_TextureId);
+
+            //Enable blending if the sprites need it
+            if (m_IsBlended == true)
+            {
+                graphics->EnableBlending();
+            }
+
+            //Draw every sprite in the batch
+            GLsizei indexCount = (GLsizei)(m_Vertices.size() / (SPRITE_BATCH_VERTICES_PER_SPRITE * SPRITE_BATCH_STRIDE) * SPRITE_BATCH_INDICES_PER_SPRITE);
+            glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, 0);
+            m_DrawCallCount++;
+
+            //Disable blending, if we did in fact have it enabled
+            if (m_IsBlended == true)
+            {
+                graphics->DisableBlending();
+            }
+        }
+
+        //Unbind the vertex array
+        graphics->BindVertexArray(0);
+
+        //The batch is empty again
+        m_Vertices.clear();
+    }
+
+    unsigned int SpriteBatch::GetDrawCallCount()
+    {
+        return m_DrawCallCount;
+    }
+
+    unsigned int SpriteBatch::GetSpriteCount()
+    {
+        return m_SpriteCount;
+    }
+
+    void SpriteBatch::CreateBuffers()
+    {
+        //Generate the VAO and bind it, the index buffer's binding is part of its state
+        glGenVertexArrays(1, &m_VertexArrayObject);
+        ServiceLocator::GetGraphics()->BindVertexArray(m_VertexArrayObject);
+
+        //Generate the VBO, its data is replaced every Flush()
+        glGenBuffers(1, &m_VertexBufferObject);
+
+        //Every sprite is two triangles, the indices never change so they are only set once
+        vector<unsigned short> indices;
+        indices.reserve(SPRITE_BATCH_MAX_SPRITES * SPRITE_BATCH_INDICES_PER_SPRITE);
+        for (unsigned int i = 0; i < SPRITE_BATCH_MAX_SPRITES; i++)
+        {
+            unsigned short first = (unsigned short)(i * SPRITE_BATCH_VERTICES_PER_SPRITE);
+            indices.push_back(first);
+            indices.push_back(first + 1);
+            indices.push_back(first + 2);
+            indices.push_back(first + 2);
+            indices.push_back(first + 1);
+            indices.push_back(first + 3);
+        }
+
+        glGenBuffers(1, &m_IndexBufferObject);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IndexBufferObject);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short) * indices.size(), &indices[0], GL_STATIC_DRAW);
+
+        //Unbind the VAO
+        ServiceLocator::GetGraphics()->BindVertexArray(0);
+    }
+}
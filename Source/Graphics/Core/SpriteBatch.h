@@ -0,0 +1,70 @@
+#ifndef __GameDev2D__SpriteBatch__
+#define __GameDev2D__SpriteBatch__
+
+#include "../../Core/BaseObject.h"
+
+
+using namespace glm;
+using namespace std;
+
+namespace GameDev2D
+{
+    //Local constants
+    const unsigned int SPRITE_BATCH_MAX_SPRITES = 4096;    //Per draw call, the indices are unsigned shorts so this can't be more than 16384
+
+    //Forward declarations
+    class TextureFrame;
+    class Shader;
+
+    //The SpriteBatch merges TextureFrame draws into a single streaming vertex buffer. Between Begin() and End(),
+    //TextureFrame::Draw() hands its quad to the batch instead of drawing it, the quad's corners are transformed by
+    //the model matrix on the CPU and appended to the batch. The batch is drawn with one draw call each time the
+    //texture, the shader or the blending changes, when it is full, and when End() or Flush() is called.
+    //The Graphics service owns the SpriteBatch, and flushes it before anything that would change how the batched
+    //sprites are drawn (the render target, the camera, the viewport and scissor clipping), anything that draws
+    //without the batch (Polygons and debug lines) must call Flush() first, so that sprites stay in draw order
+    class SpriteBatch : public BaseObject
+    {
+    public:
+        SpriteBatch();
+        ~SpriteBatch();
+
+        //Starts batching the TextureFrame draws
+        void Begin();
+
+        //Draws the batched sprites and stops batching
+        void End();
+
+        //Returns wether the TextureFrame draws are being batched
+        bool IsActive();
+
+        //Adds a TextureFrame's quad, transformed by the model matrix, to the batch. The TextureFrame's texture,
+        //source frame, shader and color are read now, so the TextureFrame can be changed right after
+        void Draw(TextureFrame* textureFrame, const mat4& modelMatrix);
+
+        //Draws the batched sprites with a single draw call, does nothing if the batch is empty
+        void Flush();
+
+        //Returns the number of draw calls and sprites since the last Begin()
+        unsigned int GetDrawCallCount();
+        unsigned int GetSpriteCount();
+
+    private:
+        //Generates the VAO, the VBO and the index buffer, on the first Flush() so the batch can be created before the graphics context
+        void CreateBuffers();
+
+        //Member variables
+        vector<float> m_Vertices;       //The position (x, y), uv coordinates (u, v) and color (r, g, b, a) of each vertex, four vertices per sprite
+        unsigned int m_TextureId;       //The texture, shader and blending of the batched sprites
+        Shader* m_Shader;
+        bool m_IsBlended;
+        bool m_IsActive;
+        unsigned int m_DrawCallCount;
+        unsigned int m_SpriteCount;
+        unsigned int m_VertexArrayObject;
+        unsigned int m_VertexBufferObject;
+        unsigned int m_IndexBufferObject;
+    };
+}
+
+#endif /* defined(__GameDev2D__SpriteBatch__) */
@@ -8,6 +8,7 @@
 
 #include "TextureFrame.h"
 #include "../Core/Shader.h"
+#include "../Core/SpriteBatch.h"
 #include "../../Platforms/PlatformLayer.h"
 #include "../../Services/ServiceLocator.h"
 #include "../../Services/ShaderManager/ShaderManager.h"
@@ -109,11 +110,19 @@ namespace GameDev2D
     
     void TextureFrame::Draw(mat4 aModelMatrix)
     {
-        //Set the shader to be used
-        m_Shader->Use();
-
         //Multiply the model matrix by the projection and view matrices
         Graphics* graphics = ServiceLocator::GetGraphics();
+
+        //If the sprite batch is active, add the TextureFrame to it instead of drawing it
+        SpriteBatch* spriteBatch = graphics->GetSpriteBatch();
+        if (spriteBatch->IsActive() == true)
+        {
+            spriteBatch->Draw(this, aModelMatrix);
+            return;
+        }
+
+        //Set the shader to be used
+        m_Shader->Use();
         
         //Bind the vertex array object
         graphics->BindVertexArray(m_VertexArrayObject);
@@ -248,6 +257,14 @@ namespace GameDev2D
         }
     }
     
+    void TextureFrame::GetUvCoordinates(vec2* aLowerLeft, vec2* aUpperRight) const
+    {
+        aLowerLeft->x = (float)m_SourceFrame.position.x / (float)m_Texture->GetWidth();
+        aLowerLeft->y = 1.0f - (((float)m_SourceFrame.position.y + m_SourceFrame.size.y) / (float)m_Texture->GetHeight());
+        aUpperRight->x = (float)(m_SourceFrame.position.x + m_SourceFrame.size.x) / (float)m_Texture->GetWidth();
+        aUpperRight->y = 1.0f - (m_SourceFrame.position.y / (float)m_Texture->GetHeight());
+    }
+    
     void TextureFrame::UpdateVertexBuffer(unsigned int aBufferObjectType)
     {
         //If the shader hasn't been set we can't update the vertex buffer, return
@@ -318,10 +335,13 @@ namespace GameDev2D
             glBindBuffer(GL_ARRAY_BUFFER, m_UvCoordinatesBufferObject);
             
             //Build the UV Coordinates
-            float x1 = (float)m_SourceFrame.position.x / (float)m_Texture->GetWidth();
-            float y1 = 1.0f - (((float)m_SourceFrame.position.y + m_SourceFrame.size.y) / (float)m_Texture->GetHeight());
-            float x2 = (float)(m_SourceFrame.position.x + m_SourceFrame.size.x) / (float)m_Texture->GetWidth();
-            float y2 = 1.0f - (m_SourceFrame.position.y / (float)m_Texture->GetHeight());
+            vec2 lowerLeft;
+            vec2 upperRight;
+            GetUvCoordinates(&lowerLeft, &upperRight);
+            float x1 = lowerLeft.x;
+            float y1 = lowerLeft.y;
+            float x2 = upperRight.x;
+            float y2 = upperRight.y;
             
             //Create the uv coordinates array
             const int uvSize = 2;
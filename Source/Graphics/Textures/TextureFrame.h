@@ -62,7 +62,8 @@ namespace GameDev2D
         //Destructor
         ~TextureFrame();
         
-        //Draw the TextureFrame for a given model matrix
+        //Draw the TextureFrame for a given model matrix, if the Graphics service's SpriteBatch
+        //is active the TextureFrame is added to the batch instead of being drawn right away
         void Draw(mat4 modelMatrix);
         
         //Returns the format of the Texture
@@ -96,11 +97,15 @@ namespace GameDev2D
         //Called from the TextureManager
         Texture* GetTexture() const;
         void SetTexture(Texture* texture, bool ownsTexture);
+
+        //Calculates the uv coordinates of the source frame's lower left and upper right corners
+        void GetUvCoordinates(vec2* lowerLeft, vec2* upperRight) const;
         
         //Friend classes that need to access protected methods
         friend class TextureManager;
         friend class RenderTarget;
         friend class Graphics;
+        friend class SpriteBatch;
     
     private:
         //Enum of the vertex buffer elements
@@ -0,0 +1,88 @@
+#ifndef __AABB_H__
+#define __AABB_H__
+
+
+using namespace glm;
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //Axis aligned bounding box, in meters. Used by the broadphase to quickly
+        //reject body pairs that can't possibly be colliding
+        struct AABB
+        {
+            AABB()
+            {
+                this->lowerBound = vec2(0.0f, 0.0f);
+                this->upperBound = vec2(0.0f, 0.0f);
+            }
+
+            AABB(vec2 lowerBound, vec2 upperBound)
+            {
+                this->lowerBound = lowerBound;
+                this->upperBound = upperBound;
+            }
+
+            //Returns wether this AABB overlaps the other AABB
+            bool Overlaps(const AABB& other) const
+            {
+                if (other.lowerBound.x > upperBound.x || other.lowerBound.y > upperBound.y)
+                {
+                    return false;
+                }
+
+                if (lowerBound.x > other.upperBound.x || lowerBound.y > other.upperBound.y)
+                {
+                    return false;
+                }
+
+                return true;
+            }
+
+            //Returns wether this AABB fully contains the other AABB
+            bool Contains(const AABB& other) const
+            {
+                return lowerBound.x <= other.lowerBound.x && lowerBound.y <= other.lowerBound.y &&
+                       other.upperBound.x <= upperBound.x && other.upperBound.y <= upperBound.y;
+            }
+
+            //Returns the smallest AABB that contains both AABBs
+            static AABB Combine(const AABB& a, const AABB& b)
+            {
+                return AABB(glm::min(a.lowerBound, b.lowerBound), glm::max(a.upperBound, b.upperBound));
+            }
+
+            //Returns a copy of the AABB grown by the margin on every side
+            AABB Expand(float margin) const
+            {
+                vec2 extension = vec2(margin, margin);
+                return AABB(lowerBound - extension, upperBound + extension);
+            }
+
+            //Returns the center of the AABB
+            vec2 GetCenter() const
+            {
+                return (lowerBound + upperBound) * 0.5f;
+            }
+
+            //Returns the half width and half height of the AABB
+            vec2 GetExtents() const
+            {
+                return (upperBound - lowerBound) * 0.5f;
+            }
+
+            //Returns the perimeter of the AABB, used as the cost metric by the dynamic tree
+            float GetPerimeter() const
+            {
+                return 2.0f * ((upperBound.x - lowerBound.x) + (upperBound.y - lowerBound.y));
+            }
+
+            //Member variables
+            vec2 lowerBound;
+            vec2 upperBound;
+        };
+    }
+}
+
+#endif
@@ -1,4 +1,6 @@
 #include "Body.h"
+#include "PhysicsMath.h"
+#include "BodyStorage.h"
 #include "Collider.h"
 #include "../../Game/GameObject.h"
 
@@ -7,203 +9,355 @@ namespace GameDev2D
 {
     namespace Physics
     {
-        Body::Body(Collider* aCollider, float aDensity) :
-            m_Position(0.0f, 0.0f),
-            m_Angle(0.0f),
-            m_LinearVelocity(0.0f, 0.0f),
-            m_AngularVelocity(0.0f),
-            m_Force(0.0f, 0.0f),
-            m_Torque(0.0f),
-            m_LinearDamping(0.0f, 0.0f),
-            m_AngularDamping(0.0f),
-            m_Mass(0.0f),
-            m_InverseMass(0.0f),
-            m_Inertia(0.0f),
-            m_InverseInertia(0.0f),
-            m_GameObject(nullptr),
-            m_Collider(aCollider)
-        {
-            SetMass(m_Collider->ComputeMass(aDensity));
-            SetInertia(m_Collider->ComputeInertia(GetMass()));
+        Body::Body(BodyStorage* aStorage, unsigned int aIndex, Collider* aCollider, float aDensity) :
+            m_Storage(aStorage),
+            m_Index(aIndex)
+        {
+            m_Storage->collider[m_Index] = aCollider;
+            SetMass(aCollider->ComputeMass(aDensity));
+            SetInertia(aCollider->ComputeInertia(GetMass()));
         }
 
-        Body::~Body()
+        Body::Body(BodyStorage* aStorage, unsigned int aIndex) :
+            m_Storage(aStorage),
+            m_Index(aIndex)
         {
-            if (m_Collider != nullptr)
-            {
-                delete m_Collider;
-                m_Collider = nullptr;
-            }
 
-            m_GameObject = nullptr;
+        }
+
+        Body::~Body()
+        {
+            //The collider is owned by the World, it can be shared by several bodies
+            m_Storage = nullptr;
         }
 
         void Body::SetPosition(vec2 aPosition)
         {
-            m_Position = aPosition;
+            m_Storage->positionX[m_Index] = aPosition.x;
+            m_Storage->positionY[m_Index] = aPosition.y;
+            m_Storage->previousPositionX[m_Index] = aPosition.x;
+            m_Storage->previousPositionY[m_Index] = aPosition.y;
+            m_Storage->isTransformDirty = true;
+            m_Storage->Wake(m_Index);
         }
 
         vec2 Body::GetPosition()
         {
-            return m_Position;
+            return vec2(m_Storage->positionX[m_Index], m_Storage->positionY[m_Index]);
         }
 
         void Body::SetAngle(float aAngle)
         {
-            m_Angle = aAngle;
-            m_Collider->SetAngle(m_Angle);
+            m_Storage->angle[m_Index] = aAngle;
+            m_Storage->previousAngle[m_Index] = aAngle;
+            m_Storage->isTransformDirty = true;
+            m_Storage->Wake(m_Index);
         }
 
         float Body::GetAngle()
         {
-            return m_Angle;
+            return m_Storage->angle[m_Index];
         }
 
         void Body::SetLinearVelocity(vec2 aLinearVelocity)
         {
-            m_LinearVelocity = aLinearVelocity;
+            m_Storage->linearVelocityX[m_Index] = aLinearVelocity.x;
+            m_Storage->linearVelocityY[m_Index] = aLinearVelocity.y;
+
+            if (aLinearVelocity.x != 0.0f || aLinearVelocity.y != 0.0f)
+            {
+                m_Storage->Wake(m_Index);
+            }
         }
 
         vec2 Body::GetLinearVelocity()
         {
-            return m_LinearVelocity;
+            return vec2(m_Storage->linearVelocityX[m_Index], m_Storage->linearVelocityY[m_Index]);
         }
 
         void Body::SetAngularVelocity(float aAngularVelocity)
         {
-            m_AngularVelocity = aAngularVelocity;
+            m_Storage->angularVelocity[m_Index] = aAngularVelocity;
+
+            if (aAngularVelocity != 0.0f)
+            {
+                m_Storage->Wake(m_Index);
+            }
         }
 
         float Body::GetAngularVelocity()
         {
-            return m_AngularVelocity;
+            return m_Storage->angularVelocity[m_Index];
         }
 
         void Body::SetLinearDamping(vec2 aLinearDamping)
         {
-            m_LinearDamping = aLinearDamping;
+            m_Storage->linearDampingX[m_Index] = aLinearDamping.x;
+            m_Storage->linearDampingY[m_Index] = aLinearDamping.y;
         }
 
         vec2 Body::GetLinearDamping()
         {
-            return m_LinearDamping;
+            return vec2(m_Storage->linearDampingX[m_Index], m_Storage->linearDampingY[m_Index]);
         }
 
         void Body::SetAngularDamping(float aAngularDamping)
         {
-            m_AngularDamping = aAngularDamping;
+            m_Storage->angularDamping[m_Index] = aAngularDamping;
         }
 
         float Body::GetAngularDamping()
         {
-            return m_AngularDamping;
+            return m_Storage->angularDamping[m_Index];
+        }
+
+        void Body::SetFriction(float aFriction)
+        {
+            m_Storage->friction[m_Index] = aFriction;
+        }
+
+        float Body::GetFriction()
+        {
+            return m_Storage->friction[m_Index];
+        }
+
+        void Body::SetRestitution(float aRestitution)
+        {
+            m_Storage->restitution[m_Index] = aRestitution;
+        }
+
+        float Body::GetRestitution()
+        {
+            return m_Storage->restitution[m_Index];
+        }
+
+        void Body::SetBullet(bool aIsBullet)
+        {
+            if (aIsBullet == true)
+            {
+                m_Storage->flags[m_Index] |= BodyFlag_Bullet;
+            }
+            else
+            {
+                m_Storage->flags[m_Index] &= ~BodyFlag_Bullet;
+            }
+        }
+
+        bool Body::IsBullet()
+        {
+            return (m_Storage->flags[m_Index] & BodyFlag_Bullet) != 0;
+        }
+
+        void Body::SetSensor(bool aIsSensor)
+        {
+            if (aIsSensor == true)
+            {
+                m_Storage->flags[m_Index] |= BodyFlag_Sensor;
+            }
+            else
+            {
+                m_Storage->flags[m_Index] &= ~BodyFlag_Sensor;
+            }
+
+            //The body moves between the broadphase and the sensors
+            m_Storage->isTransformDirty = true;
+        }
+
+        bool Body::IsSensor()
+        {
+            return (m_Storage->flags[m_Index] & BodyFlag_Sensor) != 0;
         }
 
         void Body::SetMass(float aMass)
         {
-            m_Mass = aMass;
-            m_InverseMass = (m_Mass == 0.0f ? 0.0f : 1.0f / m_Mass);
+            m_Storage->mass[m_Index] = aMass;
+            m_Storage->inverseMass[m_Index] = (aMass == 0.0f ? 0.0f : 1.0f / aMass);
         }
 
         float Body::GetMass()
         {
-            return m_Mass;
+            return m_Storage->mass[m_Index];
         }
 
         float Body::GetInverseMass()
         {
-            return m_InverseMass;
+            return m_Storage->inverseMass[m_Index];
         }
 
         void Body::SetInertia(float aInertia)
         {
-            m_Inertia = aInertia;
-            m_InverseInertia = (m_Inertia == 0.0f ? 0.0f : 1.0f / m_Inertia);
+            m_Storage->inertia[m_Index] = aInertia;
+            m_Storage->inverseInertia[m_Index] = (aInertia == 0.0f ? 0.0f : 1.0f / aInertia);
         }
 
         float Body::GetInertia()
         {
-            return m_Inertia;
+            return m_Storage->inertia[m_Index];
         }
 
         float Body::GetInverseInertia()
         {
-            return m_InverseInertia;
+            return m_Storage->inverseInertia[m_Index];
         }
 
-        void Body::ApplyForce(vec2 aForce)
+        void Body::SetAwake(bool aIsAwake)
         {
-            m_Force += aForce;
+            if (aIsAwake == true)
+            {
+                m_Storage->Wake(m_Index);
+            }
+            else
+            {
+                m_Storage->Sleep(m_Index);
+            }
         }
 
-        void Body::ApplyTorque(float aTorque)
+        bool Body::IsAwake()
         {
-            m_Torque += aTorque;
+            return m_Storage->IsSleeping(m_Index) == false;
         }
 
-        void Body::ApplyLinearImpulse(vec2 aLinearImpulse)
+        void Body::SetCategoryBits(unsigned short aCategoryBits)
         {
-            m_LinearVelocity += aLinearImpulse * m_InverseMass;
+            m_Storage->categoryBits[m_Index] = aCategoryBits;
         }
 
-        void Body::ApplyAngularImpulse(float aAngularImpulse)
+        unsigned short Body::GetCategoryBits()
         {
-            m_AngularVelocity += aAngularImpulse * m_InverseInertia;
+            return m_Storage->categoryBits[m_Index];
         }
 
-        void Body::ClearForces()
+        void Body::SetMaskBits(unsigned short aMaskBits)
         {
-            m_Force = vec2(0.0f, 0.0f);
-            m_Torque = 0.0f;
+            m_Storage->maskBits[m_Index] = aMaskBits;
         }
 
-        void Body::SyncForces(double aTimeStep, vec2 aGravity)
+        unsigned short Body::GetMaskBits()
         {
-            if (GetInverseMass() == 0.0f)
+            return m_Storage->maskBits[m_Index];
+        }
+
+        void Body::SetGroupIndex(short aGroupIndex)
+        {
+            m_Storage->groupIndex[m_Index] = aGroupIndex;
+        }
+
+        short Body::GetGroupIndex()
+        {
+            return m_Storage->groupIndex[m_Index];
+        }
+
+        bool Body::ShouldCollide(Body* aOther)
+        {
+            unsigned int a = m_Index;
+            unsigned int b = aOther->m_Index;
+
+            //The group index overrides the category and mask bits
+            if (m_Storage->groupIndex[a] == m_Storage->groupIndex[b] && m_Storage->groupIndex[a] != 0)
+            {
+                return m_Storage->groupIndex[a] > 0;
+            }
+
+            return (m_Storage->maskBits[a] & m_Storage->categoryBits[b]) != 0 && (m_Storage->categoryBits[a] & m_Storage->maskBits[b]) != 0;
+        }
+
+        void Body::ApplyForce(vec2 aForce)
+        {
+            if (aForce.x != 0.0f || aForce.y != 0.0f)
             {
-                return;
+                m_Storage->Wake(m_Index);
             }
 
-            //Calculate the acceleration based on the mass and force
-            vec2 acceleration = m_Force * GetInverseMass();
-            m_LinearVelocity.x += acceleration.x * aTimeStep;
-            m_LinearVelocity.y += acceleration.y * aTimeStep;
+            m_Storage->forceX[m_Index] += aForce.x;
+            m_Storage->forceY[m_Index] += aForce.y;
+        }
+
+        void Body::ApplyTorque(float aTorque)
+        {
+            if (aTorque != 0.0f)
+            {
+                m_Storage->Wake(m_Index);
+            }
 
-            //Next apply the effects of gravity
-            m_LinearVelocity.x += aGravity.x * aTimeStep;
-            m_LinearVelocity.y += aGravity.y * aTimeStep;
+            m_Storage->torque[m_Index] += aTorque;
+        }
 
-            //Calculate the angular acceleration
-            m_AngularVelocity += (m_Torque * GetInverseInertia()) * aTimeStep;
+        void Body::ApplyLinearImpulse(vec2 aLinearImpulse)
+        {
+            if (aLinearImpulse.x != 0.0f || aLinearImpulse.y != 0.0f)
+            {
+                m_Storage->Wake(m_Index);
+            }
 
-            //Lastly apply damping
-            m_LinearVelocity.x *= 1.0f / (1.0f + m_LinearDamping.x * aTimeStep);
-            m_LinearVelocity.y *= 1.0f / (1.0f + m_LinearDamping.y * aTimeStep);
-            m_AngularVelocity *= 1.0f / (1.0f + m_AngularDamping * aTimeStep);
+            m_Storage->linearVelocityX[m_Index] += aLinearImpulse.x * m_Storage->inverseMass[m_Index];
+            m_Storage->linearVelocityY[m_Index] += aLinearImpulse.y * m_Storage->inverseMass[m_Index];
         }
 
-        void Body::SyncVelocities(double aTimeStep)
+        void Body::ApplyAngularImpulse(float aAngularImpulse)
         {
-            m_Position.x += m_LinearVelocity.x * aTimeStep;
-            m_Position.y += m_LinearVelocity.y * aTimeStep;
-            m_Angle += m_AngularVelocity * aTimeStep;
+            if (aAngularImpulse != 0.0f)
+            {
+                m_Storage->Wake(m_Index);
+            }
 
-            m_Collider->SetAngle(m_Angle);
+            m_Storage->angularVelocity[m_Index] += aAngularImpulse * m_Storage->inverseInertia[m_Index];
+        }
+
+        void Body::ClearForces()
+        {
+            m_Storage->forceX[m_Index] = 0.0f;
+            m_Storage->forceY[m_Index] = 0.0f;
+            m_Storage->torque[m_Index] = 0.0f;
         }
 
         void Body::SetGameObject(GameObject* aGameObject)
         {
-            m_GameObject = aGameObject;
+            m_Storage->gameObject[m_Index] = aGameObject;
         }
 
         GameObject* Body::GetGameObject()
         {
-            return m_GameObject;
+            return m_Storage->gameObject[m_Index];
+        }
+
+        void Body::SetUserTag(unsigned int aUserTag)
+        {
+            m_Storage->userTag[m_Index] = aUserTag;
+        }
+
+        unsigned int Body::GetUserTag()
+        {
+            return m_Storage->userTag[m_Index];
+        }
+
+        void Body::SetUserId(int aUserId)
+        {
+            m_Storage->userId[m_Index] = aUserId;
+        }
+
+        int Body::GetUserId()
+        {
+            return m_Storage->userId[m_Index];
         }
 
         Collider* Body::GetCollider()
         {
-            return m_Collider;
+            return m_Storage->collider[m_Index];
+        }
+
+        AABB Body::ComputeAABB()
+        {
+            return GetCollider()->ComputeAABB(GetPosition(), GetAngle());
+        }
+
+        unsigned int Body::GetIndex()
+        {
+            return m_Index;
+        }
+
+        BodyHandle Body::GetHandle()
+        {
+            return BodyHandle(m_Index, m_Storage->generation[m_Index]);
         }
     }
 }
\ No newline at end of file
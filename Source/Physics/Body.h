@@ -1,6 +1,8 @@
 #ifndef __BODY_H__
 #define __BODY_H__
 
+#include "AABB.h"
+
 
 using namespace glm;
 
@@ -13,13 +15,41 @@ namespace GameDev2D
     {
         //Forward declaration
         class Collider;
+        struct BodyStorage;
+
+        //A generation checked reference to a body, World::GetBody() returns null once the body has been destroyed,
+        //even if its slot has since been reused by another body
+        struct BodyHandle
+        {
+            BodyHandle()
+            {
+                this->index = 0;
+                this->generation = 0xffffffff;
+            }
+
+            BodyHandle(unsigned int index, unsigned int generation)
+            {
+                this->index = index;
+                this->generation = generation;
+            }
+
+            //Member variables
+            unsigned int index;
+            unsigned int generation;
+        };
 
+        //A Body is a handle to a body's state, which is stored in the World's BodyStorage arrays. Bodies
+        //are created by the World, using World::CreateBody(), and destroyed with World::DestroyBody()
         class Body
         {
         public:
-            Body(Collider* collider, float density);
+            Body(BodyStorage* storage, unsigned int index, Collider* collider, float density);
+
+            //Binds to a slot whose state is already in the storage, used when a World snapshot is restored
+            Body(BodyStorage* storage, unsigned int index);
             ~Body();
 
+            //Setting the transform moves the body without interpolating from its old transform
             void SetPosition(vec2 position);
             vec2 GetPosition();
 
@@ -38,6 +68,14 @@ namespace GameDev2D
             void SetAngularDamping(float angularDamping);
             float GetAngularDamping();
 
+            //Friction is combined between two bodies using the square root of their product
+            void SetFriction(float friction);
+            float GetFriction();
+
+            //Restitution (bounciness) is combined between two bodies using the larger value
+            void SetRestitution(float restitution);
+            float GetRestitution();
+
             void SetMass(float mass);
             float GetMass();
             float GetInverseMass();
@@ -46,6 +84,38 @@ namespace GameDev2D
             float GetInertia();
             float GetInverseInertia();
 
+            //Bullets are swept from their previous position to their new position each step, and
+            //are stopped at the first body in their path. Use for small fast moving bodies that
+            //would otherwise pass through other bodies in a single step
+            void SetBullet(bool isBullet);
+            bool IsBullet();
+
+            //Sensors only detect overlaps, they report begin, persist and end contact events but get no
+            //collision response, aren't moved by the simulation and aren't found by the World's queries.
+            //Sensors are kept out of the broadphase and are only checked against bodies that aren't sensors
+            void SetSensor(bool isSensor);
+            bool IsSensor();
+
+            //Sleeping bodies aren't simulated until they are woken up, by a contact with an awake body,
+            //or by setting their transform or velocities, or applying a force or impulse to them
+            void SetAwake(bool isAwake);
+            bool IsAwake();
+
+            //Collision filtering, two bodies only collide if each body's category bits are in the other's mask
+            //bits. Bodies that share a non-zero group index always collide if it's positive, and never collide if
+            //it's negative, whatever their category and mask bits. Filtered pairs are rejected by the broadphase
+            void SetCategoryBits(unsigned short categoryBits);
+            unsigned short GetCategoryBits();
+
+            void SetMaskBits(unsigned short maskBits);
+            unsigned short GetMaskBits();
+
+            void SetGroupIndex(short groupIndex);
+            short GetGroupIndex();
+
+            //Returns wether the collision filters of the two bodies let them collide
+            bool ShouldCollide(Body* other);
+
             void ApplyForce(vec2 force);
             void ApplyTorque(float torque);
 
@@ -54,35 +124,33 @@ namespace GameDev2D
 
             void ClearForces();
 
-            void SyncForces(double timeStep, vec2 gravity);
-            void SyncVelocities(double timeStep);
-
             void SetGameObject(GameObject* gameObject);
             GameObject* GetGameObject();
 
-            Collider* GetCollider();
+            //User data, the tag tells the game what kind of object the body belongs to and the id which one it
+            //is (an index into the game's arrays for example), so contacts can be dispatched without a search.
+            //The World doesn't use either, the tag defaults to 0 and the id to -1
+            void SetUserTag(unsigned int userTag);
+            unsigned int GetUserTag();
 
-        private:
-            //Member variables
-            vec2 m_Position;    //In meters
-            float m_Angle;      //In radians
+            void SetUserId(int userId);
+            int GetUserId();
 
-            vec2 m_LinearVelocity;   //In m/s
-            float m_AngularVelocity; //In radians/second
+            Collider* GetCollider();
 
-            vec2 m_Force;   //In Newtons
-            float m_Torque; //Angular force
+            //Returns the AABB of the body's collider at the body's current position
+            AABB ComputeAABB();
 
-            vec2 m_LinearDamping;
-            float m_AngularDamping;
+            //Returns the index of the body's state in the World's BodyStorage
+            unsigned int GetIndex();
 
-            float m_Mass;       //In kg
-            float m_InverseMass;
-            float m_Inertia;    //In kg-square meters
-            float m_InverseInertia;
+            //Returns a handle to the body, which can be checked with World::GetBody()
+            BodyHandle GetHandle();
 
-            GameObject* m_GameObject;
-            Collider* m_Collider;
+        private:
+            //Member variables
+            BodyStorage* m_Storage;
+            unsigned int m_Index;
         };
     }
 }
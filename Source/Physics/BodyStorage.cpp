@@ -0,0 +1,556 @@
+#include "BodyStorage.h"
+#include "PhysicsMath.h"
+#include "PhysicsSIMD.h"
+
+//The bodies at the end of the storage are integrated by the scalar methods, which bodies those are depends on the
+//body count. Stop the compiler from fusing their multiplies and adds into FMA instructions even when
+//PHYSICS_DETERMINISTIC is off, so the SIMD and scalar methods give the same results
+#if defined(_MSC_VER)
+    #pragma fp_contract(off)
+#elif defined(__clang__)
+    #pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+    #pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //The SIMD and scalar methods below perform the same operations in the same order, so they give the same results
+        //The bodies with any of these flags are skipped by the integration, but their forces are still cleared every step
+        const unsigned int BODY_UNSIMULATED_FLAGS = BodyFlag_Sleeping | BodyFlag_Sensor;
+
+#if PHYSICS_SIMD_SSE
+        //Returns a mask with every bit set for the bodies that are awake, and aren't sensors, for the 4 bodies starting at index i
+        static inline __m128 AwakeMask4(BodyStorage& aStorage, unsigned int i)
+        {
+            __m128i flags = _mm_loadu_si128((const __m128i*)&aStorage.flags[i]);
+            __m128i unsimulated = _mm_and_si128(flags, _mm_set1_epi32(BODY_UNSIMULATED_FLAGS));
+            return _mm_castsi128_ps(_mm_cmpeq_epi32(unsimulated, _mm_setzero_si128()));
+        }
+#endif
+
+#if PHYSICS_SIMD_AVX
+        //Returns a mask with every bit set for the bodies that are awake, and aren't sensors, for the 8 bodies starting at index i
+        static inline __m256 AwakeMask8(BodyStorage& aStorage, unsigned int i)
+        {
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(AwakeMask4(aStorage, i)), AwakeMask4(aStorage, i + 4), 1);
+        }
+
+        //Integrates the forces, gravity and damping into the velocities of 8 bodies, starting at index i
+        static inline void IntegrateVelocities8(BodyStorage& aStorage, unsigned int i, __m256 aTimeStep, __m256 aGravityX, __m256 aGravityY)
+        {
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 one = _mm256_set1_ps(1.0f);
+
+            //Skip the block if all 8 bodies are asleep or sensors
+            __m256 awake = AwakeMask8(aStorage, i);
+            if (_mm256_movemask_ps(awake) == 0)
+            {
+                _mm256_storeu_ps(&aStorage.forceX[i], zero);
+                _mm256_storeu_ps(&aStorage.forceY[i], zero);
+                _mm256_storeu_ps(&aStorage.torque[i], zero);
+                return;
+            }
+
+            __m256 invMass = _mm256_loadu_ps(&aStorage.inverseMass[i]);
+            __m256 invInertia = _mm256_loadu_ps(&aStorage.inverseInertia[i]);
+            __m256 hasMass = _mm256_and_ps(_mm256_cmp_ps(invMass, zero, _CMP_NEQ_OQ), awake);
+
+            __m256 vx = _mm256_loadu_ps(&aStorage.linearVelocityX[i]);
+            __m256 vy = _mm256_loadu_ps(&aStorage.linearVelocityY[i]);
+            __m256 w = _mm256_loadu_ps(&aStorage.angularVelocity[i]);
+
+            //Apply the forces, gravity and damping
+            __m256 newVx = _mm256_add_ps(vx, _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&aStorage.forceX[i]), invMass), aTimeStep));
+            __m256 newVy = _mm256_add_ps(vy, _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&aStorage.forceY[i]), invMass), aTimeStep));
+            __m256 newW = _mm256_add_ps(w, _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&aStorage.torque[i]), invInertia), aTimeStep));
+            newVx = _mm256_add_ps(newVx, aGravityX);
+            newVy = _mm256_add_ps(newVy, aGravityY);
+            newVx = _mm256_mul_ps(newVx, _mm256_div_ps(one, _mm256_add_ps(one, _mm256_mul_ps(_mm256_loadu_ps(&aStorage.linearDampingX[i]), aTimeStep))));
+            newVy = _mm256_mul_ps(newVy, _mm256_div_ps(one, _mm256_add_ps(one, _mm256_mul_ps(_mm256_loadu_ps(&aStorage.linearDampingY[i]), aTimeStep))));
+            newW = _mm256_mul_ps(newW, _mm256_div_ps(one, _mm256_add_ps(one, _mm256_mul_ps(_mm256_loadu_ps(&aStorage.angularDamping[i]), aTimeStep))));
+
+            //Bodies without mass, sleeping bodies and sensors keep their velocities
+            _mm256_storeu_ps(&aStorage.linearVelocityX[i], _mm256_blendv_ps(vx, newVx, hasMass));
+            _mm256_storeu_ps(&aStorage.linearVelocityY[i], _mm256_blendv_ps(vy, newVy, hasMass));
+            _mm256_storeu_ps(&aStorage.angularVelocity[i], _mm256_blendv_ps(w, newW, hasMass));
+
+            //Clear the forces
+            _mm256_storeu_ps(&aStorage.forceX[i], zero);
+            _mm256_storeu_ps(&aStorage.forceY[i], zero);
+            _mm256_storeu_ps(&aStorage.torque[i], zero);
+        }
+
+        //Integrates the velocities into the positions and angles of 8 bodies, starting at index i
+        static inline void IntegratePositions8(BodyStorage& aStorage, unsigned int i, __m256 aTimeStep)
+        {
+            //Skip the block if all 8 bodies are asleep or sensors, the velocities of the others are masked
+            //out, sleeping bodies have no velocity but a sensor can have been given one by the game
+            __m256 awake = AwakeMask8(aStorage, i);
+            if (_mm256_movemask_ps(awake) == 0)
+            {
+                return;
+            }
+
+            __m256 x = _mm256_loadu_ps(&aStorage.positionX[i]);
+            __m256 y = _mm256_loadu_ps(&aStorage.positionY[i]);
+            __m256 a = _mm256_loadu_ps(&aStorage.angle[i]);
+            __m256 newX = _mm256_add_ps(x, _mm256_mul_ps(_mm256_loadu_ps(&aStorage.linearVelocityX[i]), aTimeStep));
+            __m256 newY = _mm256_add_ps(y, _mm256_mul_ps(_mm256_loadu_ps(&aStorage.linearVelocityY[i]), aTimeStep));
+            __m256 newA = _mm256_add_ps(a, _mm256_mul_ps(_mm256_loadu_ps(&aStorage.angularVelocity[i]), aTimeStep));
+            _mm256_storeu_ps(&aStorage.positionX[i], _mm256_blendv_ps(x, newX, awake));
+            _mm256_storeu_ps(&aStorage.positionY[i], _mm256_blendv_ps(y, newY, awake));
+            _mm256_storeu_ps(&aStorage.angle[i], _mm256_blendv_ps(a, newA, awake));
+        }
+#endif
+
+#if PHYSICS_SIMD_SSE
+        //Integrates the forces, gravity and damping into the velocities of 4 bodies, starting at index i
+        static inline void IntegrateVelocities4(BodyStorage& aStorage, unsigned int i, __m128 aTimeStep, __m128 aGravityX, __m128 aGravityY)
+        {
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+
+            //Skip the block if all 4 bodies are asleep or sensors
+            __m128 awake = AwakeMask4(aStorage, i);
+            if (_mm_movemask_ps(awake) == 0)
+            {
+                _mm_storeu_ps(&aStorage.forceX[i], zero);
+                _mm_storeu_ps(&aStorage.forceY[i], zero);
+                _mm_storeu_ps(&aStorage.torque[i], zero);
+                return;
+            }
+
+            __m128 invMass = _mm_loadu_ps(&aStorage.inverseMass[i]);
+            __m128 invInertia = _mm_loadu_ps(&aStorage.inverseInertia[i]);
+            __m128 hasMass = _mm_and_ps(_mm_cmpneq_ps(invMass, zero), awake);
+
+            __m128 vx = _mm_loadu_ps(&aStorage.linearVelocityX[i]);
+            __m128 vy = _mm_loadu_ps(&aStorage.linearVelocityY[i]);
+            __m128 w = _mm_loadu_ps(&aStorage.angularVelocity[i]);
+
+            //Apply the forces, gravity and damping
+            __m128 newVx = _mm_add_ps(vx, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&aStorage.forceX[i]), invMass), aTimeStep));
+            __m128 newVy = _mm_add_ps(vy, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&aStorage.forceY[i]), invMass), aTimeStep));
+            __m128 newW = _mm_add_ps(w, _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&aStorage.torque[i]), invInertia), aTimeStep));
+            newVx = _mm_add_ps(newVx, aGravityX);
+            newVy = _mm_add_ps(newVy, aGravityY);
+            newVx = _mm_mul_ps(newVx, _mm_div_ps(one, _mm_add_ps(one, _mm_mul_ps(_mm_loadu_ps(&aStorage.linearDampingX[i]), aTimeStep))));
+            newVy = _mm_mul_ps(newVy, _mm_div_ps(one, _mm_add_ps(one, _mm_mul_ps(_mm_loadu_ps(&aStorage.linearDampingY[i]), aTimeStep))));
+            newW = _mm_mul_ps(newW, _mm_div_ps(one, _mm_add_ps(one, _mm_mul_ps(_mm_loadu_ps(&aStorage.angularDamping[i]), aTimeStep))));
+
+            //Bodies without mass, sleeping bodies and sensors keep their velocities
+            _mm_storeu_ps(&aStorage.linearVelocityX[i], _mm_or_ps(_mm_and_ps(hasMass, newVx), _mm_andnot_ps(hasMass, vx)));
+            _mm_storeu_ps(&aStorage.linearVelocityY[i], _mm_or_ps(_mm_and_ps(hasMass, newVy), _mm_andnot_ps(hasMass, vy)));
+            _mm_storeu_ps(&aStorage.angularVelocity[i], _mm_or_ps(_mm_and_ps(hasMass, newW), _mm_andnot_ps(hasMass, w)));
+
+            //Clear the forces
+            _mm_storeu_ps(&aStorage.forceX[i], zero);
+            _mm_storeu_ps(&aStorage.forceY[i], zero);
+            _mm_storeu_ps(&aStorage.torque[i], zero);
+        }
+
+        //Integrates the velocities into the positions and angles of 4 bodies, starting at index i
+        static inline void IntegratePositions4(BodyStorage& aStorage, unsigned int i, __m128 aTimeStep)
+        {
+            __m128 awake = AwakeMask4(aStorage, i);
+            if (_mm_movemask_ps(awake) == 0)
+            {
+                return;
+            }
+
+            __m128 x = _mm_loadu_ps(&aStorage.positionX[i]);
+            __m128 y = _mm_loadu_ps(&aStorage.positionY[i]);
+            __m128 a = _mm_loadu_ps(&aStorage.angle[i]);
+            __m128 newX = _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(&aStorage.linearVelocityX[i]), aTimeStep));
+            __m128 newY = _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(&aStorage.linearVelocityY[i]), aTimeStep));
+            __m128 newA = _mm_add_ps(a, _mm_mul_ps(_mm_loadu_ps(&aStorage.angularVelocity[i]), aTimeStep));
+            _mm_storeu_ps(&aStorage.positionX[i], _mm_or_ps(_mm_and_ps(awake, newX), _mm_andnot_ps(awake, x)));
+            _mm_storeu_ps(&aStorage.positionY[i], _mm_or_ps(_mm_and_ps(awake, newY), _mm_andnot_ps(awake, y)));
+            _mm_storeu_ps(&aStorage.angle[i], _mm_or_ps(_mm_and_ps(awake, newA), _mm_andnot_ps(awake, a)));
+        }
+#endif
+
+        //Integrates the forces, gravity and damping into the velocities of a single body
+        static inline void IntegrateVelocities1(BodyStorage& aStorage, unsigned int i, float aTimeStep, float aGravityX, float aGravityY)
+        {
+            //Bodies without mass, sleeping bodies and sensors keep their velocities
+            if ((aStorage.flags[i] & BODY_UNSIMULATED_FLAGS) == 0 && aStorage.inverseMass[i] != 0.0f)
+            {
+                //Apply the forces and gravity
+                float vx = aStorage.linearVelocityX[i] + (aStorage.forceX[i] * aStorage.inverseMass[i]) * aTimeStep;
+                float vy = aStorage.linearVelocityY[i] + (aStorage.forceY[i] * aStorage.inverseMass[i]) * aTimeStep;
+                float w = aStorage.angularVelocity[i] + (aStorage.torque[i] * aStorage.inverseInertia[i]) * aTimeStep;
+                vx += aGravityX;
+                vy += aGravityY;
+
+                //Lastly apply damping
+                aStorage.linearVelocityX[i] = vx * (1.0f / (1.0f + aStorage.linearDampingX[i] * aTimeStep));
+                aStorage.linearVelocityY[i] = vy * (1.0f / (1.0f + aStorage.linearDampingY[i] * aTimeStep));
+                aStorage.angularVelocity[i] = w * (1.0f / (1.0f + aStorage.angularDamping[i] * aTimeStep));
+            }
+
+            //Clear the forces
+            aStorage.forceX[i] = 0.0f;
+            aStorage.forceY[i] = 0.0f;
+            aStorage.torque[i] = 0.0f;
+        }
+
+        //Integrates the velocities into the position and angle of a single body
+        static inline void IntegratePositions1(BodyStorage& aStorage, unsigned int i, float aTimeStep)
+        {
+            if ((aStorage.flags[i] & BODY_UNSIMULATED_FLAGS) != 0)
+            {
+                return;
+            }
+
+            aStorage.positionX[i] += aStorage.linearVelocityX[i] * aTimeStep;
+            aStorage.positionY[i] += aStorage.linearVelocityY[i] * aTimeStep;
+            aStorage.angle[i] += aStorage.angularVelocity[i] * aTimeStep;
+        }
+
+        BodyStorage::BodyStorage() :
+            sleepCount(0),
+            wakeCount(0),
+            isTransformDirty(false)
+        {
+
+        }
+
+        unsigned int BodyStorage::Add(Collider* aCollider)
+        {
+            unsigned int index = GetCount();
+
+            positionX.push_back(0.0f);
+            positionY.push_back(0.0f);
+            angle.push_back(0.0f);
+            previousPositionX.push_back(0.0f);
+            previousPositionY.push_back(0.0f);
+            previousAngle.push_back(0.0f);
+            linearVelocityX.push_back(0.0f);
+            linearVelocityY.push_back(0.0f);
+            angularVelocity.push_back(0.0f);
+            forceX.push_back(0.0f);
+            forceY.push_back(0.0f);
+            torque.push_back(0.0f);
+            linearDampingX.push_back(0.0f);
+            linearDampingY.push_back(0.0f);
+            angularDamping.push_back(0.0f);
+            mass.push_back(0.0f);
+            inverseMass.push_back(0.0f);
+            inertia.push_back(0.0f);
+            inverseInertia.push_back(0.0f);
+            friction.push_back(BODY_DEFAULT_FRICTION);
+            restitution.push_back(BODY_DEFAULT_RESTITUTION);
+            categoryBits.push_back(BODY_DEFAULT_CATEGORY_BITS);
+            maskBits.push_back(BODY_DEFAULT_MASK_BITS);
+            groupIndex.push_back(0);
+            flags.push_back(0);
+            sleepTime.push_back(0.0f);
+            gameObject.push_back(nullptr);
+            userTag.push_back(0);
+            userId.push_back(-1);
+            collider.push_back(aCollider);
+            generation.push_back(0);
+            isTransformDirty = true;
+
+            return index;
+        }
+
+        void BodyStorage::Reset(unsigned int aIndex, Collider* aCollider)
+        {
+            positionX[aIndex] = 0.0f;
+            positionY[aIndex] = 0.0f;
+            angle[aIndex] = 0.0f;
+            previousPositionX[aIndex] = 0.0f;
+            previousPositionY[aIndex] = 0.0f;
+            previousAngle[aIndex] = 0.0f;
+            linearVelocityX[aIndex] = 0.0f;
+            linearVelocityY[aIndex] = 0.0f;
+            angularVelocity[aIndex] = 0.0f;
+            forceX[aIndex] = 0.0f;
+            forceY[aIndex] = 0.0f;
+            torque[aIndex] = 0.0f;
+            linearDampingX[aIndex] = 0.0f;
+            linearDampingY[aIndex] = 0.0f;
+            angularDamping[aIndex] = 0.0f;
+            mass[aIndex] = 0.0f;
+            inverseMass[aIndex] = 0.0f;
+            inertia[aIndex] = 0.0f;
+            inverseInertia[aIndex] = 0.0f;
+            friction[aIndex] = BODY_DEFAULT_FRICTION;
+            restitution[aIndex] = BODY_DEFAULT_RESTITUTION;
+            categoryBits[aIndex] = BODY_DEFAULT_CATEGORY_BITS;
+            maskBits[aIndex] = BODY_DEFAULT_MASK_BITS;
+            groupIndex[aIndex] = 0;
+            flags[aIndex] = 0;
+            sleepTime[aIndex] = 0.0f;
+            gameObject[aIndex] = nullptr;
+            userTag[aIndex] = 0;
+            userId[aIndex] = -1;
+            collider[aIndex] = aCollider;
+            isTransformDirty = true;
+        }
+
+        void BodyStorage::Remove(unsigned int aIndex)
+        {
+            Reset(aIndex, nullptr);
+            flags[aIndex] = BodyFlag_Sleeping | BodyFlag_Free;
+            generation[aIndex]++;
+        }
+
+        bool BodyStorage::IsFree(unsigned int aIndex)
+        {
+            return (flags[aIndex] & BodyFlag_Free) != 0;
+        }
+
+        unsigned int BodyStorage::GetCount()
+        {
+            return positionX.size();
+        }
+
+        //Appends each array to the buffer
+        struct SaveArrays
+        {
+            SaveArrays(vector<unsigned char>& aBuffer) :
+                buffer(aBuffer)
+            {
+                buffer.clear();
+            }
+
+            template <typename T>
+            void operator()(vector<T>& aArray)
+            {
+                size_t offset = buffer.size();
+                size_t size = aArray.size() * sizeof(T);
+                buffer.resize(offset + size);
+
+                if (size > 0)
+                {
+                    memcpy(&buffer[offset], aArray.data(), size);
+                }
+            }
+
+            vector<unsigned char>& buffer;
+        };
+
+        //Reads each array back from the buffer, in the order they were appended
+        struct RestoreArrays
+        {
+            RestoreArrays(const vector<unsigned char>& aBuffer, unsigned int aCount) :
+                buffer(aBuffer),
+                count(aCount),
+                offset(0)
+            {
+
+            }
+
+            template <typename T>
+            void operator()(vector<T>& aArray)
+            {
+                size_t size = count * sizeof(T);
+                assert(offset + size <= buffer.size());
+                aArray.resize(count);
+
+                if (size > 0)
+                {
+                    memcpy(aArray.data(), &buffer[offset], size);
+                }
+                offset += size;
+            }
+
+            const vector<unsigned char>& buffer;
+            unsigned int count;
+            size_t offset;
+        };
+
+        template <typename Visitor>
+        void BodyStorage::VisitArrays(Visitor& aVisitor)
+        {
+            aVisitor(positionX);
+            aVisitor(positionY);
+            aVisitor(angle);
+            aVisitor(previousPositionX);
+            aVisitor(previousPositionY);
+            aVisitor(previousAngle);
+            aVisitor(linearVelocityX);
+            aVisitor(linearVelocityY);
+            aVisitor(angularVelocity);
+            aVisitor(forceX);
+            aVisitor(forceY);
+            aVisitor(torque);
+            aVisitor(linearDampingX);
+            aVisitor(linearDampingY);
+            aVisitor(angularDamping);
+            aVisitor(mass);
+            aVisitor(inverseMass);
+            aVisitor(inertia);
+            aVisitor(inverseInertia);
+            aVisitor(friction);
+            aVisitor(restitution);
+            aVisitor(categoryBits);
+            aVisitor(maskBits);
+            aVisitor(groupIndex);
+            aVisitor(flags);
+            aVisitor(sleepTime);
+            aVisitor(gameObject);
+            aVisitor(userTag);
+            aVisitor(userId);
+            aVisitor(collider);
+            aVisitor(generation);
+        }
+
+        void BodyStorage::Save(vector<unsigned char>& aBuffer)
+        {
+            SaveArrays visitor(aBuffer);
+            VisitArrays(visitor);
+        }
+
+        void BodyStorage::Restore(const vector<unsigned char>& aBuffer, unsigned int aCount)
+        {
+            RestoreArrays visitor(aBuffer, aCount);
+            VisitArrays(visitor);
+            isTransformDirty = true;
+        }
+
+        void BodyStorage::Sleep(unsigned int aIndex)
+        {
+            if ((flags[aIndex] & BodyFlag_Sleeping) == 0)
+            {
+                flags[aIndex] |= BodyFlag_Sleeping;
+                sleepCount++;
+            }
+
+            sleepTime[aIndex] = 0.0f;
+            previousPositionX[aIndex] = positionX[aIndex];
+            previousPositionY[aIndex] = positionY[aIndex];
+            previousAngle[aIndex] = angle[aIndex];
+            linearVelocityX[aIndex] = 0.0f;
+            linearVelocityY[aIndex] = 0.0f;
+            angularVelocity[aIndex] = 0.0f;
+            forceX[aIndex] = 0.0f;
+            forceY[aIndex] = 0.0f;
+            torque[aIndex] = 0.0f;
+        }
+
+        void BodyStorage::Wake(unsigned int aIndex)
+        {
+            //Free slots stay asleep until they are reused
+            if ((flags[aIndex] & (BodyFlag_Sleeping | BodyFlag_Free)) == BodyFlag_Sleeping)
+            {
+                flags[aIndex] &= ~BodyFlag_Sleeping;
+                sleepTime[aIndex] = 0.0f;
+                wakeCount++;
+            }
+        }
+
+        bool BodyStorage::IsSleeping(unsigned int aIndex)
+        {
+            return (flags[aIndex] & BodyFlag_Sleeping) != 0;
+        }
+
+        void BodyStorage::StoreTransforms()
+        {
+            std::copy(positionX.begin(), positionX.end(), previousPositionX.begin());
+            std::copy(positionY.begin(), positionY.end(), previousPositionY.begin());
+            std::copy(angle.begin(), angle.end(), previousAngle.begin());
+        }
+
+        void BodyStorage::Integrate(float aTimeStep, vec2 aGravity)
+        {
+            unsigned int count = GetCount();
+            unsigned int i = 0;
+
+#if PHYSICS_SIMD_AVX
+            //Integrate 8 bodies at a time
+            const __m256 dt8 = _mm256_set1_ps(aTimeStep);
+            const __m256 gx8 = _mm256_set1_ps(aGravity.x * aTimeStep);
+            const __m256 gy8 = _mm256_set1_ps(aGravity.y * aTimeStep);
+            for (; i + 8 <= count; i += 8)
+            {
+                IntegrateVelocities8(*this, i, dt8, gx8, gy8);
+                IntegratePositions8(*this, i, dt8);
+            }
+#endif
+
+#if PHYSICS_SIMD_SSE
+            //Integrate 4 bodies at a time
+            const __m128 dt4 = _mm_set1_ps(aTimeStep);
+            const __m128 gx4 = _mm_set1_ps(aGravity.x * aTimeStep);
+            const __m128 gy4 = _mm_set1_ps(aGravity.y * aTimeStep);
+            for (; i + 4 <= count; i += 4)
+            {
+                IntegrateVelocities4(*this, i, dt4, gx4, gy4);
+                IntegratePositions4(*this, i, dt4);
+            }
+#endif
+
+            //Integrate the remaining bodies
+            for (; i < count; i++)
+            {
+                IntegrateVelocities1(*this, i, aTimeStep, aGravity.x * aTimeStep, aGravity.y * aTimeStep);
+                IntegratePositions1(*this, i, aTimeStep);
+            }
+        }
+
+        void BodyStorage::IntegrateVelocities(float aTimeStep, vec2 aGravity)
+        {
+            unsigned int count = GetCount();
+            unsigned int i = 0;
+
+#if PHYSICS_SIMD_AVX
+            const __m256 dt8 = _mm256_set1_ps(aTimeStep);
+            const __m256 gx8 = _mm256_set1_ps(aGravity.x * aTimeStep);
+            const __m256 gy8 = _mm256_set1_ps(aGravity.y * aTimeStep);
+            for (; i + 8 <= count; i += 8)
+            {
+                IntegrateVelocities8(*this, i, dt8, gx8, gy8);
+            }
+#endif
+
+#if PHYSICS_SIMD_SSE
+            const __m128 dt4 = _mm_set1_ps(aTimeStep);
+            const __m128 gx4 = _mm_set1_ps(aGravity.x * aTimeStep);
+            const __m128 gy4 = _mm_set1_ps(aGravity.y * aTimeStep);
+            for (; i + 4 <= count; i += 4)
+            {
+                IntegrateVelocities4(*this, i, dt4, gx4, gy4);
+            }
+#endif
+
+            for (; i < count; i++)
+            {
+                IntegrateVelocities1(*this, i, aTimeStep, aGravity.x * aTimeStep, aGravity.y * aTimeStep);
+            }
+        }
+
+        void BodyStorage::IntegratePositions(float aTimeStep)
+        {
+            unsigned int count = GetCount();
+            unsigned int i = 0;
+
+#if PHYSICS_SIMD_AVX
+            const __m256 dt8 = _mm256_set1_ps(aTimeStep);
+            for (; i + 8 <= count; i += 8)
+            {
+                IntegratePositions8(*this, i, dt8);
+            }
+#endif
+
+#if PHYSICS_SIMD_SSE
+            const __m128 dt4 = _mm_set1_ps(aTimeStep);
+            for (; i + 4 <= count; i += 4)
+            {
+                IntegratePositions4(*this, i, dt4);
+            }
+#endif
+
+            for (; i < count; i++)
+            {
+                IntegratePositions1(*this, i, aTimeStep);
+            }
+        }
+    }
+}
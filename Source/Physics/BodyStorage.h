@@ -0,0 +1,125 @@
+#ifndef __BODY_STORAGE_H__
+#define __BODY_STORAGE_H__
+
+
+using namespace std;
+using namespace glm;
+
+namespace GameDev2D
+{
+    //Forward declaration
+    class GameObject;
+
+    namespace Physics
+    {
+        //Local constants
+        const float BODY_DEFAULT_FRICTION = 0.2f;
+        const float BODY_DEFAULT_RESTITUTION = 0.0f;
+        const unsigned short BODY_DEFAULT_CATEGORY_BITS = 0x0001;
+        const unsigned short BODY_DEFAULT_MASK_BITS = 0xffff;    //Collides with every category
+
+        //Body flags, stored as a bit mask per body
+        enum BodyFlag
+        {
+            BodyFlag_Bullet = 1 << 0,   //Swept against the other bodies to stop it tunnelling
+            BodyFlag_Sleeping = 1 << 1, //Skipped by the integration, narrowphase and GameObject sync
+            BodyFlag_Free = 1 << 2,     //The body was destroyed, the slot is waiting to be reused
+            BodyFlag_Sensor = 1 << 3    //Only reports overlaps, skipped by the integration and the contact solver
+        };
+
+        //Forward declaration
+        class Collider;
+
+        //Structure of arrays holding the state of every body in the World, each Body is a
+        //handle holding an index into these arrays. Keeping each property contiguous lets
+        //the World integrate every body in a single vectorised pass
+        struct BodyStorage
+        {
+            BodyStorage();
+
+            //Appends a body, at rest, with no mass, returns the index of the body
+            unsigned int Add(Collider* collider);
+
+            //Resets a free slot to a body at rest, with no mass, so it can be reused
+            void Reset(unsigned int index, Collider* collider);
+
+            //Frees a body's slot, the slot is left asleep with no mass so every pass skips it, and
+            //its generation is incremented so the handles to the destroyed body become invalid
+            void Remove(unsigned int index);
+            bool IsFree(unsigned int index);
+
+            //Returns the number of bodies
+            unsigned int GetCount();
+
+            //Copies every array into the buffer, back to back, so the whole storage can be saved with a memcpy
+            //per array. The buffer's memory is reused, so saving every frame doesn't allocate once it has grown
+            void Save(vector<unsigned char>& buffer);
+
+            //Resizes the arrays to the count and copies them back from a buffer filled by Save()
+            void Restore(const vector<unsigned char>& buffer, unsigned int count);
+
+            //Puts a body to sleep, clearing its velocities and forces, or wakes it up. Both
+            //increment their counter if the body's state changes
+            void Sleep(unsigned int index);
+            void Wake(unsigned int index);
+            bool IsSleeping(unsigned int index);
+
+            //Integrates the forces, gravity and damping into the velocities, then the
+            //velocities into the positions and angles, and clears the forces. Bodies with
+            //no mass (an inverse mass of zero) are not affected by forces, gravity or damping,
+            //sleeping bodies and sensors are skipped
+            void Integrate(float timeStep, vec2 gravity);
+
+            //The two halves of Integrate(), used when the contact solver needs to
+            //adjust the velocities before they are integrated into the positions
+            void IntegrateVelocities(float timeStep, vec2 gravity);
+            void IntegratePositions(float timeStep);
+
+            //Copies the current positions and angles into the previous positions and angles
+            void StoreTransforms();
+
+            //Member variables
+            vector<float> positionX;            //In meters
+            vector<float> positionY;
+            vector<float> angle;                //In radians
+            vector<float> previousPositionX;    //The transform at the start of the last step, used for interpolation
+            vector<float> previousPositionY;
+            vector<float> previousAngle;
+            vector<float> linearVelocityX;      //In m/s
+            vector<float> linearVelocityY;
+            vector<float> angularVelocity;      //In radians/second
+            vector<float> forceX;               //In Newtons
+            vector<float> forceY;
+            vector<float> torque;
+            vector<float> linearDampingX;
+            vector<float> linearDampingY;
+            vector<float> angularDamping;
+            vector<float> mass;                 //In kg
+            vector<float> inverseMass;
+            vector<float> inertia;              //In kg-square meters
+            vector<float> inverseInertia;
+            vector<float> friction;
+            vector<float> restitution;
+            vector<unsigned short> categoryBits;
+            vector<unsigned short> maskBits;
+            vector<short> groupIndex;
+            vector<unsigned int> flags;         //BodyFlag bits
+            vector<float> sleepTime;            //In seconds, how long the body has been below the sleep tolerances
+            vector<GameObject*> gameObject;
+            vector<unsigned int> userTag;
+            vector<int> userId;
+            vector<Collider*> collider;
+            vector<unsigned int> generation;    //Incremented each time the slot is freed
+            unsigned int sleepCount;            //Number of times a body was put to sleep
+            unsigned int wakeCount;             //Number of times a body was woken up
+            bool isTransformDirty;              //Set when a body is added or moved outside of a step, the World's queries then refresh the broadphase
+
+        private:
+            //Calls the visitor with each of the per body arrays, in the order they are saved
+            template <typename Visitor>
+            void VisitArrays(Visitor& visitor);
+        };
+    }
+}
+
+#endif
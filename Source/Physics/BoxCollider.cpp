@@ -1,4 +1,5 @@
 #include "BoxCollider.h"
+#include "PhysicsMath.h"
 #include "../Utils/Math/Math.h"
 
 
@@ -8,8 +9,7 @@ namespace GameDev2D
     {
         BoxCollider::BoxCollider(float aWidth, float aHeight) :
             m_Width(aWidth),
-            m_Height(aHeight),
-            m_Angle(0.0f)
+            m_Height(aHeight)
         {
             //Calculate the box's half width and half height
             float halfWidth = m_Width / 2.0f;
@@ -43,6 +43,20 @@ namespace GameDev2D
             return aMass * (m_Width * m_Width + m_Height * m_Height) / 12.0f;
         }
 
+        AABB BoxCollider::ComputeAABB(vec2 aPosition, float aAngleInRadians)
+        {
+            //Project the rotated half width and half height onto the x and y axes
+            float s = 0.0f;
+            float c = 0.0f;
+            PhysicsSinCos(aAngleInRadians, &s, &c);
+            c = fabsf(c);
+            s = fabsf(s);
+            float halfWidth = m_Width / 2.0f;
+            float halfHeight = m_Height / 2.0f;
+            vec2 extents = vec2(c * halfWidth + s * halfHeight, s * halfWidth + c * halfHeight);
+            return AABB(aPosition - extents, aPosition + extents);
+        }
+
         float BoxCollider::GetWidth()
         {
             return m_Width;
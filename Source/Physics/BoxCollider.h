@@ -23,6 +23,8 @@ namespace GameDev2D
 
             float ComputeMass(float density);
             float ComputeInertia(float mass);
+
+            AABB ComputeAABB(vec2 position, float angleInRadians);
             
             float GetWidth();
             float GetHeight();
@@ -34,7 +36,6 @@ namespace GameDev2D
             //Member variables
             float m_Width;
             float m_Height;
-            float m_Angle;
             vec2 m_Vertices[BOX_COLLIDER_VERTEX_COUNT];
             vec2 m_Normals[BOX_COLLIDER_VERTEX_COUNT];
         };
@@ -0,0 +1,32 @@
+#include "BroadPhase.h"
+
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        static bool ComparePairs(const BroadPhasePair& aPairA, const BroadPhasePair& aPairB)
+        {
+            if (aPairA.indexA != aPairB.indexA)
+            {
+                return aPairA.indexA < aPairB.indexA;
+            }
+            return aPairA.indexB < aPairB.indexB;
+        }
+
+        BroadPhase::BroadPhase(const string& aType) : BaseObject(aType)
+        {
+
+        }
+
+        BroadPhase::~BroadPhase()
+        {
+
+        }
+
+        void BroadPhase::SortPairs(vector<BroadPhasePair>& aPairs)
+        {
+            std::sort(aPairs.begin(), aPairs.end(), ComparePairs);
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef __BROAD_PHASE_H__
+#define __BROAD_PHASE_H__
+
+#include "../Core/BaseObject.h"
+#include "AABB.h"
+
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //Forward declaration
+        class Body;
+
+        enum BroadPhaseType
+        {
+            BroadPhaseType_SpatialHash,
+            BroadPhaseType_DynamicTree
+        };
+
+        //A candidate pair of bodies whose AABBs overlap, the indices refer to
+        //the body vector that was passed into the broadphase. indexA is always
+        //less than indexB
+        struct BroadPhasePair
+        {
+            BroadPhasePair(unsigned int indexA, unsigned int indexB)
+            {
+                this->indexA = indexA;
+                this->indexB = indexB;
+            }
+
+            //Member variables
+            unsigned int indexA;
+            unsigned int indexB;
+        };
+
+        //The BroadPhase class is an abstract class, used as an interface for the structures
+        //that cull the body pairs before the World runs the (expensive) narrowphase on them
+        class BroadPhase : public BaseObject
+        {
+        public:
+            BroadPhase(const string& type);
+            virtual ~BroadPhase();
+
+            //Updates the broadphase with the bodies' current AABBs, the AABBs are indexed the same as the bodies
+            virtual void Update(const vector<Body*>& bodies, const vector<AABB>& aabbs) = 0;
+
+            //Updates the broadphase, then fills the pairs vector with every pair of bodies whose AABBs
+            //overlap, the pairs are sorted by indexA then indexB so the order is deterministic
+            virtual void FindPairs(const vector<Body*>& bodies, const vector<AABB>& aabbs, vector<BroadPhasePair>& pairs) = 0;
+
+            //Fills the bodies vector with the index of every body whose AABB overlaps the AABB, in
+            //ascending order. Uses the body AABBs from the last call to Update() or FindPairs()
+            virtual void Query(const AABB& aabb, vector<unsigned int>& bodies) = 0;
+
+        protected:
+            //Sorts the pairs by indexA then indexB
+            static void SortPairs(vector<BroadPhasePair>& pairs);
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,206 @@
+#include "CircleBatch.h"
+#include "PhysicsMath.h"
+#include "PhysicsSIMD.h"
+#include "../Utils/Math/Math.h"
+
+//The narrowphase tasks split the pairs differently depending on the thread count, so a pair can be checked
+//by either the SIMD or the scalar path. Stop the compiler from fusing their multiplies and adds into FMA
+//instructions even when PHYSICS_DETERMINISTIC is off, so both paths give the same results
+#if defined(_MSC_VER)
+    #pragma fp_contract(off)
+#elif defined(__clang__)
+    #pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+    #pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //The SIMD and scalar methods below perform the same operations in the same order, so they give the same results
+#if PHYSICS_SIMD_AVX
+        //Checks the 8 pairs starting at index i
+        static inline void CollideCircles8(CircleBatch& aBatch, unsigned int i)
+        {
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 half = _mm256_set1_ps(0.5f);
+            const __m256 epsilon = _mm256_set1_ps(EPSILON);
+
+            __m256 ax = _mm256_loadu_ps(&aBatch.centerAX[i]);
+            __m256 ay = _mm256_loadu_ps(&aBatch.centerAY[i]);
+            __m256 radiusA = _mm256_loadu_ps(&aBatch.radiusA[i]);
+            __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(&aBatch.centerBX[i]), ax);
+            __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(&aBatch.centerBY[i]), ay);
+
+            //Check the distance against the radii for collision
+            __m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            __m256 combinedRadii = _mm256_add_ps(radiusA, _mm256_loadu_ps(&aBatch.radiusB[i]));
+            __m256 touching = _mm256_cmp_ps(distanceSquared, _mm256_mul_ps(combinedRadii, combinedRadii), _CMP_LE_OQ);
+
+            //Calculate the overlap and the collision normal, the centers that are on top of each other get an arbitrary normal
+            __m256 distance = _mm256_sqrt_ps(distanceSquared);
+            __m256 overlap = _mm256_sub_ps(combinedRadii, distance);
+            __m256 separated = _mm256_cmp_ps(distance, epsilon, _CMP_GT_OQ);
+            __m256 normalX = _mm256_blendv_ps(one, _mm256_div_ps(dx, distance), separated);
+            __m256 normalY = _mm256_blendv_ps(zero, _mm256_div_ps(dy, distance), separated);
+
+            //The contact point is halfway through the overlapping region
+            __m256 offset = _mm256_sub_ps(radiusA, _mm256_mul_ps(overlap, half));
+
+            _mm256_storeu_ps((float*)&aBatch.touching[i], touching);
+            _mm256_storeu_ps(&aBatch.overlap[i], overlap);
+            _mm256_storeu_ps(&aBatch.normalX[i], normalX);
+            _mm256_storeu_ps(&aBatch.normalY[i], normalY);
+            _mm256_storeu_ps(&aBatch.pointX[i], _mm256_add_ps(ax, _mm256_mul_ps(normalX, offset)));
+            _mm256_storeu_ps(&aBatch.pointY[i], _mm256_add_ps(ay, _mm256_mul_ps(normalY, offset)));
+        }
+#endif
+
+#if PHYSICS_SIMD_SSE
+        //Checks the 4 pairs starting at index i
+        static inline void CollideCircles4(CircleBatch& aBatch, unsigned int i)
+        {
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 half = _mm_set1_ps(0.5f);
+            const __m128 epsilon = _mm_set1_ps(EPSILON);
+
+            __m128 ax = _mm_loadu_ps(&aBatch.centerAX[i]);
+            __m128 ay = _mm_loadu_ps(&aBatch.centerAY[i]);
+            __m128 radiusA = _mm_loadu_ps(&aBatch.radiusA[i]);
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(&aBatch.centerBX[i]), ax);
+            __m128 dy = _mm_sub_ps(_mm_loadu_ps(&aBatch.centerBY[i]), ay);
+
+            //Check the distance against the radii for collision
+            __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            __m128 combinedRadii = _mm_add_ps(radiusA, _mm_loadu_ps(&aBatch.radiusB[i]));
+            __m128 touching = _mm_cmple_ps(distanceSquared, _mm_mul_ps(combinedRadii, combinedRadii));
+
+            //Calculate the overlap and the collision normal, the centers that are on top of each other get an arbitrary normal
+            __m128 distance = _mm_sqrt_ps(distanceSquared);
+            __m128 overlap = _mm_sub_ps(combinedRadii, distance);
+            __m128 separated = _mm_cmpgt_ps(distance, epsilon);
+            __m128 normalX = _mm_or_ps(_mm_and_ps(separated, _mm_div_ps(dx, distance)), _mm_andnot_ps(separated, one));
+            __m128 normalY = _mm_or_ps(_mm_and_ps(separated, _mm_div_ps(dy, distance)), _mm_andnot_ps(separated, zero));
+
+            //The contact point is halfway through the overlapping region
+            __m128 offset = _mm_sub_ps(radiusA, _mm_mul_ps(overlap, half));
+
+            _mm_storeu_ps((float*)&aBatch.touching[i], touching);
+            _mm_storeu_ps(&aBatch.overlap[i], overlap);
+            _mm_storeu_ps(&aBatch.normalX[i], normalX);
+            _mm_storeu_ps(&aBatch.normalY[i], normalY);
+            _mm_storeu_ps(&aBatch.pointX[i], _mm_add_ps(ax, _mm_mul_ps(normalX, offset)));
+            _mm_storeu_ps(&aBatch.pointY[i], _mm_add_ps(ay, _mm_mul_ps(normalY, offset)));
+        }
+#endif
+
+        //Checks a single pair
+        static inline void CollideCircles1(CircleBatch& aBatch, unsigned int i)
+        {
+            float dx = aBatch.centerBX[i] - aBatch.centerAX[i];
+            float dy = aBatch.centerBY[i] - aBatch.centerAY[i];
+
+            //Check the distance against the radii for collision
+            float distanceSquared = dx * dx + dy * dy;
+            float combinedRadii = aBatch.radiusA[i] + aBatch.radiusB[i];
+            aBatch.touching[i] = distanceSquared <= combinedRadii * combinedRadii ? 0xffffffff : 0;
+
+            //Calculate the overlap and the collision normal, the centers that are on top of each other get an arbitrary normal
+            float distance = sqrtf(distanceSquared);
+            float overlap = combinedRadii - distance;
+            bool separated = distance > EPSILON;
+            float normalX = separated == true ? dx / distance : 1.0f;
+            float normalY = separated == true ? dy / distance : 0.0f;
+
+            //The contact point is halfway through the overlapping region
+            float offset = aBatch.radiusA[i] - overlap * 0.5f;
+
+            aBatch.overlap[i] = overlap;
+            aBatch.normalX[i] = normalX;
+            aBatch.normalY[i] = normalY;
+            aBatch.pointX[i] = aBatch.centerAX[i] + normalX * offset;
+            aBatch.pointY[i] = aBatch.centerAY[i] + normalY * offset;
+        }
+
+        CircleBatch::CircleBatch()
+        {
+
+        }
+
+        void CircleBatch::Clear()
+        {
+            id.clear();
+            centerAX.clear();
+            centerAY.clear();
+            radiusA.clear();
+            centerBX.clear();
+            centerBY.clear();
+            radiusB.clear();
+        }
+
+        void CircleBatch::Add(unsigned int aId, vec2 aCenterA, float aRadiusA, vec2 aCenterB, float aRadiusB)
+        {
+            id.push_back(aId);
+            centerAX.push_back(aCenterA.x);
+            centerAY.push_back(aCenterA.y);
+            radiusA.push_back(aRadiusA);
+            centerBX.push_back(aCenterB.x);
+            centerBY.push_back(aCenterB.y);
+            radiusB.push_back(aRadiusB);
+        }
+
+        unsigned int CircleBatch::GetCount()
+        {
+            return id.size();
+        }
+
+        void CircleBatch::Collide()
+        {
+            Collide(CircleBatchPath_AVX);
+        }
+
+        void CircleBatch::Collide(CircleBatchPath aPath)
+        {
+            unsigned int count = GetCount();
+            touching.resize(count);
+            overlap.resize(count);
+            normalX.resize(count);
+            normalY.resize(count);
+            pointX.resize(count);
+            pointY.resize(count);
+
+            unsigned int i = 0;
+
+#if PHYSICS_SIMD_AVX
+            //Check 8 pairs at a time
+            if (aPath == CircleBatchPath_AVX)
+            {
+                for (; i + 8 <= count; i += 8)
+                {
+                    CollideCircles8(*this, i);
+                }
+            }
+#endif
+
+#if PHYSICS_SIMD_SSE
+            //Check 4 pairs at a time
+            if (aPath != CircleBatchPath_Scalar)
+            {
+                for (; i + 4 <= count; i += 4)
+                {
+                    CollideCircles4(*this, i);
+                }
+            }
+#endif
+
+            //Check the remaining pairs
+            for (; i < count; i++)
+            {
+                CollideCircles1(*this, i);
+            }
+        }
+    }
+}
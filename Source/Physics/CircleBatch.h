@@ -0,0 +1,65 @@
+#ifndef __CIRCLE_BATCH_H__
+#define __CIRCLE_BATCH_H__
+
+
+using namespace std;
+using namespace glm;
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //The widest path CircleBatch::Collide() may use, paths that weren't compiled in (see PhysicsSIMD.h)
+        //fall back to the next narrower one
+        enum CircleBatchPath
+        {
+            CircleBatchPath_AVX = 0,    //8 pairs at a time, then SSE and scalar for the remainder
+            CircleBatchPath_SSE,        //4 pairs at a time, then scalar for the remainder
+            CircleBatchPath_Scalar      //One pair at a time
+        };
+
+        //Structure of arrays holding a batch of circle vs circle pairs for the narrowphase. The World gathers
+        //the centers and radii of every circle pair in a range of the broadphase's pairs, then Collide()
+        //checks them 8 (AVX) or 4 (SSE) pairs at a time. The SIMD and scalar paths perform the same
+        //operations in the same order as World::CheckCircleToCircle(), so they give the same results
+        struct CircleBatch
+        {
+            CircleBatch();
+
+            //Removes every pair, the arrays keep their memory
+            void Clear();
+
+            //Appends a pair, the id is returned with the results (the pair's index in the World's pairs)
+            void Add(unsigned int id, vec2 centerA, float radiusA, vec2 centerB, float radiusB);
+
+            //Returns the number of pairs
+            unsigned int GetCount();
+
+            //Checks every pair, filling in the output arrays
+            void Collide();
+
+            //Checks every pair using at most the path's width, used to verify that the SIMD paths give
+            //bitwise the same results as the scalar path (PhysicsBenchmark --verify-circle-batch)
+            void Collide(CircleBatchPath path);
+
+            //Member variables
+            vector<unsigned int> id;
+            vector<float> centerAX;         //In meters
+            vector<float> centerAY;
+            vector<float> radiusA;
+            vector<float> centerBX;
+            vector<float> centerBY;
+            vector<float> radiusB;
+
+            //Outputs, filled in by Collide(), only valid for the pairs that are touching
+            vector<unsigned int> touching;  //Every bit set if the circles overlap, 0 if they don't
+            vector<float> overlap;
+            vector<float> normalX;          //From A to B
+            vector<float> normalY;
+            vector<float> pointX;           //Halfway through the overlapping region
+            vector<float> pointY;
+        };
+    }
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "CircleCollider.h"
+#include "PhysicsMath.h"
 
 
 namespace GameDev2D
@@ -26,6 +27,13 @@ namespace GameDev2D
             return aMass * m_Radius * m_Radius;
         }
 
+        AABB CircleCollider::ComputeAABB(vec2 aPosition, float)
+        {
+            //A circle's AABB doesn't depend on its angle
+            vec2 extents = vec2(m_Radius, m_Radius);
+            return AABB(aPosition - extents, aPosition + extents);
+        }
+
         float CircleCollider::GetRadius()
         {
             return m_Radius;
@@ -17,6 +17,8 @@ namespace GameDev2D
 
             float ComputeMass(float density);
             float ComputeInertia(float mass);
+
+            AABB ComputeAABB(vec2 position, float angleInRadians);
             
             float GetRadius();
 
@@ -5,8 +5,7 @@ namespace GameDev2D
 {
     namespace Physics
     {
-        Collider::Collider() :
-            m_Angle(0.0f)
+        Collider::Collider()
         {
 
         }
@@ -15,15 +14,5 @@ namespace GameDev2D
         {
 
         }
-
-        void Collider::SetAngle(float aAngleInRadians)
-        {
-            m_Angle = aAngleInRadians;
-        }
-
-        float Collider::GetAngle()
-        {
-            return m_Angle;
-        }
     }
 }
\ No newline at end of file
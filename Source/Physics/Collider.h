@@ -1,6 +1,8 @@
 #ifndef __COLLIDER_H__
 #define __COLLIDER_H__
 
+#include "AABB.h"
+
 namespace GameDev2D
 {
     namespace Physics
@@ -8,7 +10,9 @@ namespace GameDev2D
         enum ColliderType
         {
             ColliderType_Circle,
-            ColliderType_Box
+            ColliderType_Box,
+            ColliderType_Polygon,
+            ColliderType_Count  //Must be last, used to size the World's collision dispatch table
         };
 
 
@@ -23,11 +27,8 @@ namespace GameDev2D
             virtual float ComputeMass(float density) = 0;
             virtual float ComputeInertia(float mass) = 0;
 
-            void SetAngle(float angleInRadians);
-            float GetAngle();
-
-        private:
-            float m_Angle;
+            //Returns the collider's AABB at the given position (in meters) and angle (in radians)
+            virtual AABB ComputeAABB(vec2 position, float angleInRadians) = 0;
         };
     }
 }
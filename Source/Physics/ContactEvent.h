@@ -0,0 +1,43 @@
+#ifndef __CONTACT_EVENT_H__
+#define __CONTACT_EVENT_H__
+
+
+using namespace glm;
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //Forward declaration
+        class Body;
+
+        //A contact between two bodies that began, persisted or ended during a step, collected by the
+        //World. The point and normal are those of the contact's first manifold point, end events have none
+        struct ContactEvent
+        {
+            ContactEvent()
+            {
+                this->bodyA = nullptr;
+                this->bodyB = nullptr;
+                this->point = vec2(0.0f, 0.0f);
+                this->normal = vec2(0.0f, 0.0f);
+            }
+
+            ContactEvent(Body* bodyA, Body* bodyB)
+            {
+                this->bodyA = bodyA;
+                this->bodyB = bodyB;
+                this->point = vec2(0.0f, 0.0f);
+                this->normal = vec2(0.0f, 0.0f);
+            }
+
+            //Member variables
+            Body* bodyA;
+            Body* bodyB;
+            vec2 point;     //In meters
+            vec2 normal;    //Points from body A to body B
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,1157 @@
+#include "ContactSolver.h"
+#include "PhysicsMath.h"
+#include "Body.h"
+#include "BodyStorage.h"
+#include "PhysicsSIMD.h"
+#include "../Utils/ThreadPool/ThreadPool.h"
+
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //2D cross product of two vectors, returns a scalar
+        static inline float Cross(vec2 aA, vec2 aB)
+        {
+            return aA.x * aB.y - aA.y * aB.x;
+        }
+
+        //2D cross product of a scalar (angular velocity) and a vector, returns a vector
+        static inline vec2 Cross(float aS, vec2 aV)
+        {
+            return vec2(-aS * aV.y, aS * aV.x);
+        }
+
+        static bool CompareCachedContacts(const CachedContact& aA, const CachedContact& aB)
+        {
+            return aA.key < aB.key;
+        }
+
+        //The coloured velocity solve. The SIMD and scalar methods below perform the same operations in the same
+        //order, so they give the same results. The lanes gather the velocities of their bodies, the constraints
+        //of a colour don't share a dynamic body, so the velocities can be scattered back in any order. The shared
+        //static bodies are never written to. Which method solves a constraint depends on how the colours are
+        //split into groups, so FMA contraction is turned off for them even when PHYSICS_DETERMINISTIC is off
+#if defined(_MSC_VER)
+    #pragma fp_contract(off)
+#elif defined(__clang__)
+    #pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+    #pragma GCC push_options
+    #pragma GCC optimize("fp-contract=off")
+#endif
+
+#if PHYSICS_SIMD_AVX
+        //Solves the 8 constraints starting at slot i
+        static inline void SolveVelocityLanes8(ContactConstraintLanes& aLanes, BodyStorage* aStorage, unsigned int i)
+        {
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+            //Gather the velocities of the lanes' bodies
+            alignas(32) float velocities[6][8];
+            for (unsigned int k = 0; k < 8; k++)
+            {
+                unsigned int a = aLanes.indexA[i + k];
+                unsigned int b = aLanes.indexB[i + k];
+                velocities[0][k] = aStorage->linearVelocityX[a];
+                velocities[1][k] = aStorage->linearVelocityY[a];
+                velocities[2][k] = aStorage->angularVelocity[a];
+                velocities[3][k] = aStorage->linearVelocityX[b];
+                velocities[4][k] = aStorage->linearVelocityY[b];
+                velocities[5][k] = aStorage->angularVelocity[b];
+            }
+
+            __m256 vAX = _mm256_load_ps(velocities[0]);
+            __m256 vAY = _mm256_load_ps(velocities[1]);
+            __m256 wA = _mm256_load_ps(velocities[2]);
+            __m256 vBX = _mm256_load_ps(velocities[3]);
+            __m256 vBY = _mm256_load_ps(velocities[4]);
+            __m256 wB = _mm256_load_ps(velocities[5]);
+
+            __m256 inverseMassA = _mm256_loadu_ps(&aLanes.inverseMassA[i]);
+            __m256 inverseMassB = _mm256_loadu_ps(&aLanes.inverseMassB[i]);
+            __m256 inverseInertiaA = _mm256_loadu_ps(&aLanes.inverseInertiaA[i]);
+            __m256 inverseInertiaB = _mm256_loadu_ps(&aLanes.inverseInertiaB[i]);
+            __m256 normalX = _mm256_loadu_ps(&aLanes.normalX[i]);
+            __m256 normalY = _mm256_loadu_ps(&aLanes.normalY[i]);
+            __m256 friction = _mm256_loadu_ps(&aLanes.friction[i]);
+            __m256 tangentX = normalY;
+            __m256 tangentY = _mm256_xor_ps(normalX, signMask);
+
+            //Solve the tangent constraints first, the normal constraints are more important
+            for (unsigned int j = 0; j < MANIFOLD_MAX_POINTS; j++)
+            {
+                __m256 rAX = _mm256_loadu_ps(&aLanes.rAX[j][i]);
+                __m256 rAY = _mm256_loadu_ps(&aLanes.rAY[j][i]);
+                __m256 rBX = _mm256_loadu_ps(&aLanes.rBX[j][i]);
+                __m256 rBY = _mm256_loadu_ps(&aLanes.rBY[j][i]);
+                __m256 tangentImpulse = _mm256_loadu_ps(&aLanes.tangentImpulse[j][i]);
+
+                __m256 dvX = _mm256_add_ps(_mm256_sub_ps(_mm256_sub_ps(vBX, _mm256_mul_ps(wB, rBY)), vAX), _mm256_mul_ps(wA, rAY));
+                __m256 dvY = _mm256_sub_ps(_mm256_sub_ps(_mm256_add_ps(vBY, _mm256_mul_ps(wB, rBX)), vAY), _mm256_mul_ps(wA, rAX));
+                __m256 speed = _mm256_add_ps(_mm256_mul_ps(dvX, tangentX), _mm256_mul_ps(dvY, tangentY));
+                __m256 lambda = _mm256_xor_ps(_mm256_mul_ps(_mm256_loadu_ps(&aLanes.tangentMass[j][i]), speed), signMask);
+
+                //Clamp the accumulated friction impulse
+                __m256 maxFriction = _mm256_mul_ps(friction, _mm256_loadu_ps(&aLanes.normalImpulse[j][i]));
+                __m256 newImpulse = _mm256_max_ps(_mm256_add_ps(tangentImpulse, lambda), _mm256_xor_ps(maxFriction, signMask));
+                newImpulse = _mm256_min_ps(newImpulse, maxFriction);
+                lambda = _mm256_sub_ps(newImpulse, tangentImpulse);
+                _mm256_storeu_ps(&aLanes.tangentImpulse[j][i], newImpulse);
+
+                __m256 impulseX = _mm256_mul_ps(lambda, tangentX);
+                __m256 impulseY = _mm256_mul_ps(lambda, tangentY);
+                vAX = _mm256_sub_ps(vAX, _mm256_mul_ps(inverseMassA, impulseX));
+                vAY = _mm256_sub_ps(vAY, _mm256_mul_ps(inverseMassA, impulseY));
+                wA = _mm256_sub_ps(wA, _mm256_mul_ps(inverseInertiaA, _mm256_sub_ps(_mm256_mul_ps(rAX, impulseY), _mm256_mul_ps(rAY, impulseX))));
+                vBX = _mm256_add_ps(vBX, _mm256_mul_ps(inverseMassB, impulseX));
+                vBY = _mm256_add_ps(vBY, _mm256_mul_ps(inverseMassB, impulseY));
+                wB = _mm256_add_ps(wB, _mm256_mul_ps(inverseInertiaB, _mm256_sub_ps(_mm256_mul_ps(rBX, impulseY), _mm256_mul_ps(rBY, impulseX))));
+            }
+
+            for (unsigned int j = 0; j < MANIFOLD_MAX_POINTS; j++)
+            {
+                __m256 rAX = _mm256_loadu_ps(&aLanes.rAX[j][i]);
+                __m256 rAY = _mm256_loadu_ps(&aLanes.rAY[j][i]);
+                __m256 rBX = _mm256_loadu_ps(&aLanes.rBX[j][i]);
+                __m256 rBY = _mm256_loadu_ps(&aLanes.rBY[j][i]);
+                __m256 normalImpulse = _mm256_loadu_ps(&aLanes.normalImpulse[j][i]);
+
+                __m256 dvX = _mm256_add_ps(_mm256_sub_ps(_mm256_sub_ps(vBX, _mm256_mul_ps(wB, rBY)), vAX), _mm256_mul_ps(wA, rAY));
+                __m256 dvY = _mm256_sub_ps(_mm256_sub_ps(_mm256_add_ps(vBY, _mm256_mul_ps(wB, rBX)), vAY), _mm256_mul_ps(wA, rAX));
+                __m256 speed = _mm256_add_ps(_mm256_mul_ps(dvX, normalX), _mm256_mul_ps(dvY, normalY));
+                __m256 lambda = _mm256_xor_ps(_mm256_mul_ps(_mm256_loadu_ps(&aLanes.normalMass[j][i]), _mm256_sub_ps(speed, _mm256_loadu_ps(&aLanes.velocityBias[j][i]))), signMask);
+
+                //Clamp the accumulated impulse, contacts can only push
+                __m256 newImpulse = _mm256_max_ps(_mm256_add_ps(normalImpulse, lambda), zero);
+                lambda = _mm256_sub_ps(newImpulse, normalImpulse);
+                _mm256_storeu_ps(&aLanes.normalImpulse[j][i], newImpulse);
+
+                __m256 impulseX = _mm256_mul_ps(lambda, normalX);
+                __m256 impulseY = _mm256_mul_ps(lambda, normalY);
+                vAX = _mm256_sub_ps(vAX, _mm256_mul_ps(inverseMassA, impulseX));
+                vAY = _mm256_sub_ps(vAY, _mm256_mul_ps(inverseMassA, impulseY));
+                wA = _mm256_sub_ps(wA, _mm256_mul_ps(inverseInertiaA, _mm256_sub_ps(_mm256_mul_ps(rAX, impulseY), _mm256_mul_ps(rAY, impulseX))));
+                vBX = _mm256_add_ps(vBX, _mm256_mul_ps(inverseMassB, impulseX));
+                vBY = _mm256_add_ps(vBY, _mm256_mul_ps(inverseMassB, impulseY));
+                wB = _mm256_add_ps(wB, _mm256_mul_ps(inverseInertiaB, _mm256_sub_ps(_mm256_mul_ps(rBX, impulseY), _mm256_mul_ps(rBY, impulseX))));
+            }
+
+            //Scatter the velocities back to the bodies
+            _mm256_store_ps(velocities[0], vAX);
+            _mm256_store_ps(velocities[1], vAY);
+            _mm256_store_ps(velocities[2], wA);
+            _mm256_store_ps(velocities[3], vBX);
+            _mm256_store_ps(velocities[4], vBY);
+            _mm256_store_ps(velocities[5], wB);
+
+            for (unsigned int k = 0; k < 8; k++)
+            {
+                if (aLanes.inverseMassA[i + k] != 0.0f || aLanes.inverseInertiaA[i + k] != 0.0f)
+                {
+                    unsigned int a = aLanes.indexA[i + k];
+                    aStorage->linearVelocityX[a] = velocities[0][k];
+                    aStorage->linearVelocityY[a] = velocities[1][k];
+                    aStorage->angularVelocity[a] = velocities[2][k];
+                }
+
+                if (aLanes.inverseMassB[i + k] != 0.0f || aLanes.inverseInertiaB[i + k] != 0.0f)
+                {
+                    unsigned int b = aLanes.indexB[i + k];
+                    aStorage->linearVelocityX[b] = velocities[3][k];
+                    aStorage->linearVelocityY[b] = velocities[4][k];
+                    aStorage->angularVelocity[b] = velocities[5][k];
+                }
+            }
+        }
+#endif
+
+#if PHYSICS_SIMD_SSE
+        //Solves the 4 constraints starting at slot i
+        static inline void SolveVelocityLanes4(ContactConstraintLanes& aLanes, BodyStorage* aStorage, unsigned int i)
+        {
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 signMask = _mm_set1_ps(-0.0f);
+
+            //Gather the velocities of the lanes' bodies
+            alignas(16) float velocities[6][4];
+            for (unsigned int k = 0; k < 4; k++)
+            {
+                unsigned int a = aLanes.indexA[i + k];
+                unsigned int b = aLanes.indexB[i + k];
+                velocities[0][k] = aStorage->linearVelocityX[a];
+                velocities[1][k] = aStorage->linearVelocityY[a];
+                velocities[2][k] = aStorage->angularVelocity[a];
+                velocities[3][k] = aStorage->linearVelocityX[b];
+                velocities[4][k] = aStorage->linearVelocityY[b];
+                velocities[5][k] = aStorage->angularVelocity[b];
+            }
+
+            __m128 vAX = _mm_load_ps(velocities[0]);
+            __m128 vAY = _mm_load_ps(velocities[1]);
+            __m128 wA = _mm_load_ps(velocities[2]);
+            __m128 vBX = _mm_load_ps(velocities[3]);
+            __m128 vBY = _mm_load_ps(velocities[4]);
+            __m128 wB = _mm_load_ps(velocities[5]);
+
+            __m128 inverseMassA = _mm_loadu_ps(&aLanes.inverseMassA[i]);
+            __m128 inverseMassB = _mm_loadu_ps(&aLanes.inverseMassB[i]);
+            __m128 inverseInertiaA = _mm_loadu_ps(&aLanes.inverseInertiaA[i]);
+            __m128 inverseInertiaB = _mm_loadu_ps(&aLanes.inverseInertiaB[i]);
+            __m128 normalX = _mm_loadu_ps(&aLanes.normalX[i]);
+            __m128 normalY = _mm_loadu_ps(&aLanes.normalY[i]);
+            __m128 friction = _mm_loadu_ps(&aLanes.friction[i]);
+            __m128 tangentX = normalY;
+            __m128 tangentY = _mm_xor_ps(normalX, signMask);
+
+            //Solve the tangent constraints first, the normal constraints are more important
+            for (unsigned int j = 0; j < MANIFOLD_MAX_POINTS; j++)
+            {
+                __m128 rAX = _mm_loadu_ps(&aLanes.rAX[j][i]);
+                __m128 rAY = _mm_loadu_ps(&aLanes.rAY[j][i]);
+                __m128 rBX = _mm_loadu_ps(&aLanes.rBX[j][i]);
+                __m128 rBY = _mm_loadu_ps(&aLanes.rBY[j][i]);
+                __m128 tangentImpulse = _mm_loadu_ps(&aLanes.tangentImpulse[j][i]);
+
+                __m128 dvX = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(vBX, _mm_mul_ps(wB, rBY)), vAX), _mm_mul_ps(wA, rAY));
+                __m128 dvY = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(vBY, _mm_mul_ps(wB, rBX)), vAY), _mm_mul_ps(wA, rAX));
+                __m128 speed = _mm_add_ps(_mm_mul_ps(dvX, tangentX), _mm_mul_ps(dvY, tangentY));
+                __m128 lambda = _mm_xor_ps(_mm_mul_ps(_mm_loadu_ps(&aLanes.tangentMass[j][i]), speed), signMask);
+
+                //Clamp the accumulated friction impulse
+                __m128 maxFriction = _mm_mul_ps(friction, _mm_loadu_ps(&aLanes.normalImpulse[j][i]));
+                __m128 newImpulse = _mm_max_ps(_mm_add_ps(tangentImpulse, lambda), _mm_xor_ps(maxFriction, signMask));
+                newImpulse = _mm_min_ps(newImpulse, maxFriction);
+                lambda = _mm_sub_ps(newImpulse, tangentImpulse);
+                _mm_storeu_ps(&aLanes.tangentImpulse[j][i], newImpulse);
+
+                __m128 impulseX = _mm_mul_ps(lambda, tangentX);
+                __m128 impulseY = _mm_mul_ps(lambda, tangentY);
+                vAX = _mm_sub_ps(vAX, _mm_mul_ps(inverseMassA, impulseX));
+                vAY = _mm_sub_ps(vAY, _mm_mul_ps(inverseMassA, impulseY));
+                wA = _mm_sub_ps(wA, _mm_mul_ps(inverseInertiaA, _mm_sub_ps(_mm_mul_ps(rAX, impulseY), _mm_mul_ps(rAY, impulseX))));
+                vBX = _mm_add_ps(vBX, _mm_mul_ps(inverseMassB, impulseX));
+                vBY = _mm_add_ps(vBY, _mm_mul_ps(inverseMassB, impulseY));
+                wB = _mm_add_ps(wB, _mm_mul_ps(inverseInertiaB, _mm_sub_ps(_mm_mul_ps(rBX, impulseY), _mm_mul_ps(rBY, impulseX))));
+            }
+
+            for (unsigned int j = 0; j < MANIFOLD_MAX_POINTS; j++)
+            {
+                __m128 rAX = _mm_loadu_ps(&aLanes.rAX[j][i]);
+                __m128 rAY = _mm_loadu_ps(&aLanes.rAY[j][i]);
+                __m128 rBX = _mm_loadu_ps(&aLanes.rBX[j][i]);
+                __m128 rBY = _mm_loadu_ps(&aLanes.rBY[j][i]);
+                __m128 normalImpulse = _mm_loadu_ps(&aLanes.normalImpulse[j][i]);
+
+                __m128 dvX = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(vBX, _mm_mul_ps(wB, rBY)), vAX), _mm_mul_ps(wA, rAY));
+                __m128 dvY = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(vBY, _mm_mul_ps(wB, rBX)), vAY), _mm_mul_ps(wA, rAX));
+                __m128 speed = _mm_add_ps(_mm_mul_ps(dvX, normalX), _mm_mul_ps(dvY, normalY));
+                __m128 lambda = _mm_xor_ps(_mm_mul_ps(_mm_loadu_ps(&aLanes.normalMass[j][i]), _mm_sub_ps(speed, _mm_loadu_ps(&aLanes.velocityBias[j][i]))), signMask);
+
+                //Clamp the accumulated impulse, contacts can only push
+                __m128 newImpulse = _mm_max_ps(_mm_add_ps(normalImpulse, lambda), zero);
+                lambda = _mm_sub_ps(newImpulse, normalImpulse);
+                _mm_storeu_ps(&aLanes.normalImpulse[j][i], newImpulse);
+
+                __m128 impulseX = _mm_mul_ps(lambda, normalX);
+                __m128 impulseY = _mm_mul_ps(lambda, normalY);
+                vAX = _mm_sub_ps(vAX, _mm_mul_ps(inverseMassA, impulseX));
+                vAY = _mm_sub_ps(vAY, _mm_mul_ps(inverseMassA, impulseY));
+                wA = _mm_sub_ps(wA, _mm_mul_ps(inverseInertiaA, _mm_sub_ps(_mm_mul_ps(rAX, impulseY), _mm_mul_ps(rAY, impulseX))));
+                vBX = _mm_add_ps(vBX, _mm_mul_ps(inverseMassB, impulseX));
+                vBY = _mm_add_ps(vBY, _mm_mul_ps(inverseMassB, impulseY));
+                wB = _mm_add_ps(wB, _mm_mul_ps(inverseInertiaB, _mm_sub_ps(_mm_mul_ps(rBX, impulseY), _mm_mul_ps(rBY, impulseX))));
+            }
+
+            //Scatter the velocities back to the bodies
+            _mm_store_ps(velocities[0], vAX);
+            _mm_store_ps(velocities[1], vAY);
+            _mm_store_ps(velocities[2], wA);
+            _mm_store_ps(velocities[3], vBX);
+            _mm_store_ps(velocities[4], vBY);
+            _mm_store_ps(velocities[5], wB);
+
+            for (unsigned int k = 0; k < 4; k++)
+            {
+                if (aLanes.inverseMassA[i + k] != 0.0f || aLanes.inverseInertiaA[i + k] != 0.0f)
+                {
+                    unsigned int a = aLanes.indexA[i + k];
+                    aStorage->linearVelocityX[a] = velocities[0][k];
+                    aStorage->linearVelocityY[a] = velocities[1][k];
+                    aStorage->angularVelocity[a] = velocities[2][k];
+                }
+
+                if (aLanes.inverseMassB[i + k] != 0.0f || aLanes.inverseInertiaB[i + k] != 0.0f)
+                {
+                    unsigned int b = aLanes.indexB[i + k];
+                    aStorage->linearVelocityX[b] = velocities[3][k];
+                    aStorage->linearVelocityY[b] = velocities[4][k];
+                    aStorage->angularVelocity[b] = velocities[5][k];
+                }
+            }
+        }
+#endif
+
+        //Solves the constraint in slot i
+        static inline void SolveVelocityLanes1(ContactConstraintLanes& aLanes, BodyStorage* aStorage, unsigned int i)
+        {
+            unsigned int a = aLanes.indexA[i];
+            unsigned int b = aLanes.indexB[i];
+            float vAX = aStorage->linearVelocityX[a];
+            float vAY = aStorage->linearVelocityY[a];
+            float wA = aStorage->angularVelocity[a];
+            float vBX = aStorage->linearVelocityX[b];
+            float vBY = aStorage->linearVelocityY[b];
+            float wB = aStorage->angularVelocity[b];
+
+            float inverseMassA = aLanes.inverseMassA[i];
+            float inverseMassB = aLanes.inverseMassB[i];
+            float inverseInertiaA = aLanes.inverseInertiaA[i];
+            float inverseInertiaB = aLanes.inverseInertiaB[i];
+            float normalX = aLanes.normalX[i];
+            float normalY = aLanes.normalY[i];
+            float tangentX = normalY;
+            float tangentY = -normalX;
+
+            //Solve the tangent constraints first, the normal constraints are more important. The clamps are
+            //written as comparisons, so they match the SIMD min and max when the values are equal
+            for (unsigned int j = 0; j < MANIFOLD_MAX_POINTS; j++)
+            {
+                float rAX = aLanes.rAX[j][i];
+                float rAY = aLanes.rAY[j][i];
+                float rBX = aLanes.rBX[j][i];
+                float rBY = aLanes.rBY[j][i];
+                float tangentImpulse = aLanes.tangentImpulse[j][i];
+
+                float dvX = vBX - wB * rBY - vAX + wA * rAY;
+                float dvY = vBY + wB * rBX - vAY - wA * rAX;
+                float lambda = -(aLanes.tangentMass[j][i] * (dvX * tangentX + dvY * tangentY));
+
+                //Clamp the accumulated friction impulse
+                float maxFriction = aLanes.friction[i] * aLanes.normalImpulse[j][i];
+                float newImpulse = tangentImpulse + lambda;
+                newImpulse = newImpulse > -maxFriction ? newImpulse : -maxFriction;
+                newImpulse = newImpulse < maxFriction ? newImpulse : maxFriction;
+                lambda = newImpulse - tangentImpulse;
+                aLanes.tangentImpulse[j][i] = newImpulse;
+
+                float impulseX = lambda * tangentX;
+                float impulseY = lambda * tangentY;
+                vAX = vAX - inverseMassA * impulseX;
+                vAY = vAY - inverseMassA * impulseY;
+                wA = wA - inverseInertiaA * (rAX * impulseY - rAY * impulseX);
+                vBX = vBX + inverseMassB * impulseX;
+                vBY = vBY + inverseMassB * impulseY;
+                wB = wB + inverseInertiaB * (rBX * impulseY - rBY * impulseX);
+            }
+
+            for (unsigned int j = 0; j < MANIFOLD_MAX_POINTS; j++)
+            {
+                float rAX = aLanes.rAX[j][i];
+                float rAY = aLanes.rAY[j][i];
+                float rBX = aLanes.rBX[j][i];
+                float rBY = aLanes.rBY[j][i];
+                float normalImpulse = aLanes.normalImpulse[j][i];
+
+                float dvX = vBX - wB * rBY - vAX + wA * rAY;
+                float dvY = vBY + wB * rBX - vAY - wA * rAX;
+                float lambda = -(aLanes.normalMass[j][i] * ((dvX * normalX + dvY * normalY) - aLanes.velocityBias[j][i]));
+
+                //Clamp the accumulated impulse, contacts can only push
+                float newImpulse = normalImpulse + lambda;
+                newImpulse = newImpulse > 0.0f ? newImpulse : 0.0f;
+                lambda = newImpulse - normalImpulse;
+                aLanes.normalImpulse[j][i] = newImpulse;
+
+                float impulseX = lambda * normalX;
+                float impulseY = lambda * normalY;
+                vAX = vAX - inverseMassA * impulseX;
+                vAY = vAY - inverseMassA * impulseY;
+                wA = wA - inverseInertiaA * (rAX * impulseY - rAY * impulseX);
+                vBX = vBX + inverseMassB * impulseX;
+                vBY = vBY + inverseMassB * impulseY;
+                wB = wB + inverseInertiaB * (rBX * impulseY - rBY * impulseX);
+            }
+
+            if (inverseMassA != 0.0f || inverseInertiaA != 0.0f)
+            {
+                aStorage->linearVelocityX[a] = vAX;
+                aStorage->linearVelocityY[a] = vAY;
+                aStorage->angularVelocity[a] = wA;
+            }
+
+            if (inverseMassB != 0.0f || inverseInertiaB != 0.0f)
+            {
+                aStorage->linearVelocityX[b] = vBX;
+                aStorage->linearVelocityY[b] = vBY;
+                aStorage->angularVelocity[b] = wB;
+            }
+        }
+
+#if defined(__clang__) && PHYSICS_DETERMINISTIC == 0
+    #pragma STDC FP_CONTRACT DEFAULT
+#elif defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC pop_options
+#endif
+
+        void ContactConstraintLanes::Resize(unsigned int aCount)
+        {
+            indexA.resize(aCount);
+            indexB.resize(aCount);
+            inverseMassA.resize(aCount);
+            inverseMassB.resize(aCount);
+            inverseInertiaA.resize(aCount);
+            inverseInertiaB.resize(aCount);
+            normalX.resize(aCount);
+            normalY.resize(aCount);
+            friction.resize(aCount);
+
+            for (unsigned int j = 0; j < MANIFOLD_MAX_POINTS; j++)
+            {
+                rAX[j].resize(aCount);
+                rAY[j].resize(aCount);
+                rBX[j].resize(aCount);
+                rBY[j].resize(aCount);
+                normalMass[j].resize(aCount);
+                tangentMass[j].resize(aCount);
+                velocityBias[j].resize(aCount);
+                normalImpulse[j].resize(aCount);
+                tangentImpulse[j].resize(aCount);
+            }
+        }
+
+        ContactSolver::ContactSolver() :
+            m_Storage(nullptr),
+            m_ThreadPool(nullptr),
+            m_VelocityIterations(CONTACT_SOLVER_DEFAULT_VELOCITY_ITERATIONS),
+            m_PositionIterations(CONTACT_SOLVER_DEFAULT_POSITION_ITERATIONS),
+            m_WarmStarting(true),
+            m_GraphColoring(false),
+            m_IslandSplitting(true)
+        {
+
+        }
+
+        ContactSolver::~ContactSolver()
+        {
+            m_Storage = nullptr;
+            m_ThreadPool = nullptr;
+        }
+
+        void ContactSolver::LoadCachedImpulses(vector<Manifold>& aContacts)
+        {
+            if (m_WarmStarting == false || m_Cache.empty() == true)
+            {
+                return;
+            }
+
+            for (unsigned int i = 0; i < aContacts.size(); i++)
+            {
+                Manifold& manifold = aContacts.at(i);
+
+                //Find the cached contact for the body pair
+                CachedContact search;
+                search.key = MakeKey(manifold.GetBodyA()->GetIndex(), manifold.GetBodyB()->GetIndex());
+                vector<CachedContact>::iterator cached = std::lower_bound(m_Cache.begin(), m_Cache.end(), search, CompareCachedContacts);
+                if (cached == m_Cache.end() || cached->key != search.key)
+                {
+                    continue;
+                }
+
+                //Match the points by their feature id
+                for (unsigned int j = 0; j < manifold.GetPointCount(); j++)
+                {
+                    ManifoldPoint* point = manifold.GetPoint(j);
+                    for (unsigned int k = 0; k < cached->pointCount; k++)
+                    {
+                        if (cached->ids[k] == point->id)
+                        {
+                            point->normalImpulse = cached->normalImpulses[k];
+                            point->tangentImpulse = cached->tangentImpulses[k];
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        void ContactSolver::Initialize(vector<Manifold>& aContacts, BodyStorage* aStorage)
+        {
+            m_Storage = aStorage;
+            m_Constraints.resize(aContacts.size());
+
+            //Split the constraints into the groups that are solved by each task
+            BuildGroups(aContacts);
+
+            if (m_GraphColoring == true)
+            {
+                m_Lanes.Resize(aContacts.size());
+                m_Colors.resize(aContacts.size());
+                m_SortedOrder.resize(aContacts.size());
+                m_BodyColors.resize(m_Storage->GetCount(), 0);
+            }
+
+            //Prepare each group's constraints, then colour them
+            RunGroups([this, &aContacts](unsigned int aGroupIndex)
+            {
+                ContactConstraintGroup& group = m_Groups.at(aGroupIndex);
+                InitializeGroup(aContacts, group);
+
+                if (m_GraphColoring == true)
+                {
+                    ColorGroup(group);
+                }
+            });
+        }
+
+        void ContactSolver::SolveVelocityConstraints()
+        {
+            //Each group runs every iteration on its own, the groups don't share any dynamic bodies
+            RunGroups([this](unsigned int aGroupIndex)
+            {
+                if (m_GraphColoring == true)
+                {
+                    SolveColoredVelocityGroup(m_Groups.at(aGroupIndex));
+                }
+                else
+                {
+                    SolveVelocityGroup(m_Groups.at(aGroupIndex));
+                }
+            });
+        }
+
+        bool ContactSolver::SolvePositionConstraints()
+        {
+            RunGroups([this](unsigned int aGroupIndex)
+            {
+                SolvePositionGroup(m_Groups.at(aGroupIndex));
+            });
+
+            float largestOverlap = 0.0f;
+            for (unsigned int i = 0; i < m_Groups.size(); i++)
+            {
+                largestOverlap = std::max(largestOverlap, m_Groups.at(i).largestOverlap);
+            }
+
+            //The overlap is resolved once it's within a few allowances
+            return largestOverlap < 3.0f * OVERLAP_ALLOWANCE;
+        }
+
+        void ContactSolver::StoreImpulses(vector<Manifold>& aContacts)
+        {
+            m_Cache.resize(aContacts.size());
+
+            for (unsigned int i = 0; i < aContacts.size(); i++)
+            {
+                Manifold& manifold = aContacts.at(i);
+                CachedContact& cached = m_Cache.at(i);
+                cached.key = MakeKey(manifold.GetBodyA()->GetIndex(), manifold.GetBodyB()->GetIndex());
+                cached.pointCount = manifold.GetPointCount();
+
+                for (unsigned int j = 0; j < manifold.GetPointCount(); j++)
+                {
+                    ManifoldPoint* point = manifold.GetPoint(j);
+
+                    //Copy the solved impulses back into the manifold
+                    if (i < m_Constraints.size())
+                    {
+                        point->normalImpulse = m_Constraints.at(i).points[j].normalImpulse;
+                        point->tangentImpulse = m_Constraints.at(i).points[j].tangentImpulse;
+                    }
+
+                    cached.ids[j] = point->id;
+                    cached.normalImpulses[j] = point->normalImpulse;
+                    cached.tangentImpulses[j] = point->tangentImpulse;
+                }
+            }
+
+            //The contacts are generated in body index order, so this is usually already sorted
+            if (std::is_sorted(m_Cache.begin(), m_Cache.end(), CompareCachedContacts) == false)
+            {
+                std::sort(m_Cache.begin(), m_Cache.end(), CompareCachedContacts);
+            }
+        }
+
+        void ContactSolver::ClearCache()
+        {
+            m_Cache.clear();
+        }
+
+        void ContactSolver::RemoveCachedContacts(unsigned int aIndex)
+        {
+            //Removing entries keeps the cache sorted
+            vector<CachedContact>::iterator end = std::remove_if(m_Cache.begin(), m_Cache.end(), [aIndex](const CachedContact& aCached)
+            {
+                return (unsigned int)(aCached.key >> 32) == aIndex || (unsigned int)(aCached.key & 0xffffffff) == aIndex;
+            });
+            m_Cache.erase(end, m_Cache.end());
+        }
+
+        const vector<CachedContact>& ContactSolver::GetCache()
+        {
+            return m_Cache;
+        }
+
+        void ContactSolver::SetCache(const vector<CachedContact>& aCache)
+        {
+            m_Cache.assign(aCache.begin(), aCache.end());
+        }
+
+        void ContactSolver::SetVelocityIterations(unsigned int aVelocityIterations)
+        {
+            m_VelocityIterations = aVelocityIterations;
+        }
+
+        unsigned int ContactSolver::GetVelocityIterations()
+        {
+            return m_VelocityIterations;
+        }
+
+        void ContactSolver::SetPositionIterations(unsigned int aPositionIterations)
+        {
+            m_PositionIterations = aPositionIterations;
+        }
+
+        unsigned int ContactSolver::GetPositionIterations()
+        {
+            return m_PositionIterations;
+        }
+
+        void ContactSolver::SetWarmStarting(bool aWarmStarting)
+        {
+            m_WarmStarting = aWarmStarting;
+        }
+
+        bool ContactSolver::IsWarmStarting()
+        {
+            return m_WarmStarting;
+        }
+
+        void ContactSolver::SetGraphColoring(bool aGraphColoring)
+        {
+            m_GraphColoring = aGraphColoring;
+        }
+
+        bool ContactSolver::IsGraphColoring()
+        {
+            return m_GraphColoring;
+        }
+
+        void ContactSolver::SetIslandSplitting(bool aIslandSplitting)
+        {
+            m_IslandSplitting = aIslandSplitting;
+        }
+
+        bool ContactSolver::IsIslandSplitting()
+        {
+            return m_IslandSplitting;
+        }
+
+        void ContactSolver::SetThreadPool(ThreadPool* aThreadPool)
+        {
+            m_ThreadPool = aThreadPool;
+        }
+
+        unsigned long long ContactSolver::MakeKey(unsigned int aIndexA, unsigned int aIndexB)
+        {
+            return ((unsigned long long)aIndexA << 32) | (unsigned long long)aIndexB;
+        }
+
+        bool ContactSolver::IsMovable(unsigned int aIndex)
+        {
+            return m_Storage->inverseMass[aIndex] != 0.0f || m_Storage->inverseInertia[aIndex] != 0.0f;
+        }
+
+        void ContactSolver::BuildGroups(vector<Manifold>& aContacts)
+        {
+            unsigned int count = aContacts.size();
+            m_Order.resize(count);
+            m_Groups.clear();
+
+            unsigned int taskCount = 1;
+            if (m_IslandSplitting == true && m_ThreadPool != nullptr)
+            {
+                taskCount = std::min(m_ThreadPool->GetThreadCount(), count / CONTACT_SOLVER_MIN_CONSTRAINTS_PER_TASK);
+                taskCount = std::max(taskCount, 1u);
+            }
+
+            ContactConstraintGroup group;
+            group.begin = 0;
+            group.end = count;
+            group.largestOverlap = 0.0f;
+
+            //A single group solves the constraints in the order of the contacts
+            if (taskCount == 1)
+            {
+                for (unsigned int i = 0; i < count; i++)
+                {
+                    m_Order.at(i) = i;
+                }
+                m_Groups.push_back(group);
+                return;
+            }
+
+            //Build the contact islands, bodies that touch are merged into the same island. Static bodies
+            //don't join islands, otherwise everything resting on the ground would be one island
+            unsigned int bodyCount = m_Storage->GetCount();
+            m_IslandParents.resize(bodyCount);
+            for (unsigned int i = 0; i < bodyCount; i++)
+            {
+                m_IslandParents.at(i) = i;
+            }
+
+            for (unsigned int i = 0; i < count; i++)
+            {
+                unsigned int indexA = aContacts.at(i).GetBodyA()->GetIndex();
+                unsigned int indexB = aContacts.at(i).GetBodyB()->GetIndex();
+
+                if (IsMovable(indexA) == true && IsMovable(indexB) == true)
+                {
+                    unsigned int rootA = FindIslandRoot(indexA);
+                    unsigned int rootB = FindIslandRoot(indexB);
+
+                    //Attach the higher root to the lower root, so the islands don't depend on the contact order
+                    if (rootA < rootB)
+                    {
+                        m_IslandParents.at(rootB) = rootA;
+                    }
+                    else if (rootB < rootA)
+                    {
+                        m_IslandParents.at(rootA) = rootB;
+                    }
+                }
+            }
+
+            //Sort the constraints by island with a counting sort on the island's root, which keeps the
+            //order of the contacts within each island, so each island is solved exactly as before
+            m_SortedOrder.resize(count);
+            m_IslandCounts.assign(bodyCount + 1, 0);
+            for (unsigned int i = 0; i < count; i++)
+            {
+                unsigned int indexA = aContacts.at(i).GetBodyA()->GetIndex();
+                unsigned int indexB = aContacts.at(i).GetBodyB()->GetIndex();
+                unsigned int root = FindIslandRoot(IsMovable(indexA) == true ? indexA : indexB);
+                m_SortedOrder.at(i) = root;
+                m_IslandCounts.at(root + 1)++;
+            }
+
+            for (unsigned int i = 0; i < bodyCount; i++)
+            {
+                m_IslandCounts.at(i + 1) += m_IslandCounts.at(i);
+            }
+
+            //Once the constraints are placed each island's count is the end of its range
+            for (unsigned int i = 0; i < count; i++)
+            {
+                m_Order.at(m_IslandCounts.at(m_SortedOrder.at(i))++) = i;
+            }
+
+            //Split the islands into groups of about the same size, an island is never split
+            for (unsigned int i = 0; i < bodyCount && group.begin < count; i++)
+            {
+                unsigned int islandEnd = m_IslandCounts.at(i);
+                unsigned int target = (unsigned int)((unsigned long long)count * (m_Groups.size() + 1) / taskCount);
+
+                if (islandEnd > group.begin && islandEnd >= target)
+                {
+                    group.end = islandEnd;
+                    m_Groups.push_back(group);
+                    group.begin = islandEnd;
+                }
+            }
+        }
+
+        unsigned int ContactSolver::FindIslandRoot(unsigned int aIndex)
+        {
+            //Walk up to the root, halving the path along the way
+            while (m_IslandParents.at(aIndex) != aIndex)
+            {
+                m_IslandParents.at(aIndex) = m_IslandParents.at(m_IslandParents.at(aIndex));
+                aIndex = m_IslandParents.at(aIndex);
+            }
+            return aIndex;
+        }
+
+        void ContactSolver::RunGroups(const function<void(unsigned int)>& aTask)
+        {
+            if (m_ThreadPool != nullptr && m_Groups.size() > 1)
+            {
+                m_ThreadPool->Run(m_Groups.size(), aTask);
+            }
+            else
+            {
+                for (unsigned int i = 0; i < m_Groups.size(); i++)
+                {
+                    aTask(i);
+                }
+            }
+        }
+
+        void ContactSolver::InitializeGroup(vector<Manifold>& aContacts, ContactConstraintGroup& aGroup)
+        {
+            for (unsigned int slot = aGroup.begin; slot < aGroup.end; slot++)
+            {
+                unsigned int i = m_Order.at(slot);
+                Manifold& manifold = aContacts.at(i);
+                ContactConstraint& constraint = m_Constraints.at(i);
+
+                unsigned int a = manifold.GetBodyA()->GetIndex();
+                unsigned int b = manifold.GetBodyB()->GetIndex();
+
+                constraint.indexA = a;
+                constraint.indexB = b;
+                constraint.inverseMassA = m_Storage->inverseMass[a];
+                constraint.inverseMassB = m_Storage->inverseMass[b];
+                constraint.inverseInertiaA = m_Storage->inverseInertia[a];
+                constraint.inverseInertiaB = m_Storage->inverseInertia[b];
+                constraint.normal = manifold.GetNormal();
+                constraint.friction = sqrtf(m_Storage->friction[a] * m_Storage->friction[b]);
+                constraint.restitution = std::max(m_Storage->restitution[a], m_Storage->restitution[b]);
+                constraint.positionA = vec2(m_Storage->positionX[a], m_Storage->positionY[a]);
+                constraint.positionB = vec2(m_Storage->positionX[b], m_Storage->positionY[b]);
+                constraint.angleA = m_Storage->angle[a];
+                constraint.angleB = m_Storage->angle[b];
+                constraint.pointCount = manifold.GetPointCount();
+
+                vec2 normal = constraint.normal;
+                vec2 tangent = vec2(normal.y, -normal.x);
+                vec2 vA = vec2(m_Storage->linearVelocityX[a], m_Storage->linearVelocityY[a]);
+                vec2 vB = vec2(m_Storage->linearVelocityX[b], m_Storage->linearVelocityY[b]);
+                float wA = m_Storage->angularVelocity[a];
+                float wB = m_Storage->angularVelocity[b];
+
+                for (unsigned int j = 0; j < constraint.pointCount; j++)
+                {
+                    ManifoldPoint* manifoldPoint = manifold.GetPoint(j);
+                    ContactConstraintPoint& point = constraint.points[j];
+
+                    point.rA = manifoldPoint->position - constraint.positionA;
+                    point.rB = manifoldPoint->position - constraint.positionB;
+                    point.overlap = manifoldPoint->overlap;
+                    point.normalImpulse = m_WarmStarting == true ? manifoldPoint->normalImpulse : 0.0f;
+                    point.tangentImpulse = m_WarmStarting == true ? manifoldPoint->tangentImpulse : 0.0f;
+
+                    //Calculate the effective mass along the normal and the tangent
+                    float rnA = Cross(point.rA, normal);
+                    float rnB = Cross(point.rB, normal);
+                    float normalMass = constraint.inverseMassA + constraint.inverseMassB + constraint.inverseInertiaA * rnA * rnA + constraint.inverseInertiaB * rnB * rnB;
+                    point.normalMass = normalMass > 0.0f ? 1.0f / normalMass : 0.0f;
+
+                    float rtA = Cross(point.rA, tangent);
+                    float rtB = Cross(point.rB, tangent);
+                    float tangentMass = constraint.inverseMassA + constraint.inverseMassB + constraint.inverseInertiaA * rtA * rtA + constraint.inverseInertiaB * rtB * rtB;
+                    point.tangentMass = tangentMass > 0.0f ? 1.0f / tangentMass : 0.0f;
+
+                    //Setup the velocity bias for restitution
+                    point.velocityBias = 0.0f;
+                    float relativeVelocity = dot(normal, vB + Cross(wB, point.rB) - vA - Cross(wA, point.rA));
+                    if (relativeVelocity < -CONTACT_SOLVER_RESTITUTION_THRESHOLD)
+                    {
+                        point.velocityBias = -constraint.restitution * relativeVelocity;
+                    }
+
+                    //Warm start, apply the impulses from the previous step
+                    vec2 impulse = point.normalImpulse * normal + point.tangentImpulse * tangent;
+                    wA -= constraint.inverseInertiaA * Cross(point.rA, impulse);
+                    vA -= constraint.inverseMassA * impulse;
+                    wB += constraint.inverseInertiaB * Cross(point.rB, impulse);
+                    vB += constraint.inverseMassB * impulse;
+                }
+
+                if (IsMovable(a) == true)
+                {
+                    m_Storage->linearVelocityX[a] = vA.x;
+                    m_Storage->linearVelocityY[a] = vA.y;
+                    m_Storage->angularVelocity[a] = wA;
+                }
+
+                if (IsMovable(b) == true)
+                {
+                    m_Storage->linearVelocityX[b] = vB.x;
+                    m_Storage->linearVelocityY[b] = vB.y;
+                    m_Storage->angularVelocity[b] = wB;
+                }
+            }
+        }
+
+        void ContactSolver::ColorGroup(ContactConstraintGroup& aGroup)
+        {
+            //Give each constraint the lowest colour that neither of its dynamic bodies has used yet, the
+            //static bodies are never written to, so they can be shared by every constraint of a colour
+            unsigned int colorCounts[CONTACT_SOLVER_MAX_COLORS + 1] = {};
+            for (unsigned int slot = aGroup.begin; slot < aGroup.end; slot++)
+            {
+                const ContactConstraint& constraint = m_Constraints.at(m_Order.at(slot));
+                bool isMovableA = IsMovable(constraint.indexA);
+                bool isMovableB = IsMovable(constraint.indexB);
+
+                unsigned int usedColors = 0;
+                usedColors |= isMovableA == true ? m_BodyColors.at(constraint.indexA) : 0;
+                usedColors |= isMovableB == true ? m_BodyColors.at(constraint.indexB) : 0;
+
+                unsigned int color = 0;
+                while (color < CONTACT_SOLVER_MAX_COLORS && (usedColors & (1u << color)) != 0)
+                {
+                    color++;
+                }
+
+                //The constraints that don't fit go in the last colour, which is solved one constraint at a time
+                if (color < CONTACT_SOLVER_MAX_COLORS)
+                {
+                    if (isMovableA == true)
+                    {
+                        m_BodyColors.at(constraint.indexA) |= 1u << color;
+                    }
+
+                    if (isMovableB == true)
+                    {
+                        m_BodyColors.at(constraint.indexB) |= 1u << color;
+                    }
+                }
+
+                m_Colors.at(slot) = color;
+                colorCounts[color]++;
+            }
+
+            //Clear the bodies' colours for the next step
+            for (unsigned int slot = aGroup.begin; slot < aGroup.end; slot++)
+            {
+                const ContactConstraint& constraint = m_Constraints.at(m_Order.at(slot));
+                if (IsMovable(constraint.indexA) == true)
+                {
+                    m_BodyColors.at(constraint.indexA) = 0;
+                }
+
+                if (IsMovable(constraint.indexB) == true)
+                {
+                    m_BodyColors.at(constraint.indexB) = 0;
+                }
+            }
+
+            //Sort the group's range by colour, keeping the order of the constraints within each colour
+            unsigned int colorOffsets[CONTACT_SOLVER_MAX_COLORS + 1];
+            unsigned int offset = aGroup.begin;
+            for (unsigned int i = 0; i <= CONTACT_SOLVER_MAX_COLORS; i++)
+            {
+                colorOffsets[i] = offset;
+                offset += colorCounts[i];
+                aGroup.colorEnds[i] = offset;
+            }
+
+            for (unsigned int slot = aGroup.begin; slot < aGroup.end; slot++)
+            {
+                m_SortedOrder.at(colorOffsets[m_Colors.at(slot)]++) = m_Order.at(slot);
+            }
+            std::copy(m_SortedOrder.begin() + aGroup.begin, m_SortedOrder.begin() + aGroup.end, m_Order.begin() + aGroup.begin);
+
+            //Copy the constraints into the lanes, in the solve order
+            for (unsigned int slot = aGroup.begin; slot < aGroup.end; slot++)
+            {
+                const ContactConstraint& constraint = m_Constraints.at(m_Order.at(slot));
+                m_Lanes.indexA[slot] = constraint.indexA;
+                m_Lanes.indexB[slot] = constraint.indexB;
+                m_Lanes.inverseMassA[slot] = constraint.inverseMassA;
+                m_Lanes.inverseMassB[slot] = constraint.inverseMassB;
+                m_Lanes.inverseInertiaA[slot] = constraint.inverseInertiaA;
+                m_Lanes.inverseInertiaB[slot] = constraint.inverseInertiaB;
+                m_Lanes.normalX[slot] = constraint.normal.x;
+                m_Lanes.normalY[slot] = constraint.normal.y;
+                m_Lanes.friction[slot] = constraint.friction;
+
+                for (unsigned int j = 0; j < MANIFOLD_MAX_POINTS; j++)
+                {
+                    bool hasPoint = j < constraint.pointCount;
+                    const ContactConstraintPoint& point = constraint.points[j];
+                    m_Lanes.rAX[j][slot] = hasPoint == true ? point.rA.x : 0.0f;
+                    m_Lanes.rAY[j][slot] = hasPoint == true ? point.rA.y : 0.0f;
+                    m_Lanes.rBX[j][slot] = hasPoint == true ? point.rB.x : 0.0f;
+                    m_Lanes.rBY[j][slot] = hasPoint == true ? point.rB.y : 0.0f;
+                    m_Lanes.normalMass[j][slot] = hasPoint == true ? point.normalMass : 0.0f;
+                    m_Lanes.tangentMass[j][slot] = hasPoint == true ? point.tangentMass : 0.0f;
+                    m_Lanes.velocityBias[j][slot] = hasPoint == true ? point.velocityBias : 0.0f;
+                    m_Lanes.normalImpulse[j][slot] = hasPoint == true ? point.normalImpulse : 0.0f;
+                    m_Lanes.tangentImpulse[j][slot] = hasPoint == true ? point.tangentImpulse : 0.0f;
+                }
+            }
+        }
+
+        void ContactSolver::SolveVelocityGroup(ContactConstraintGroup& aGroup)
+        {
+            for (unsigned int iteration = 0; iteration < m_VelocityIterations; iteration++)
+            {
+                for (unsigned int slot = aGroup.begin; slot < aGroup.end; slot++)
+                {
+                    ContactConstraint& constraint = m_Constraints.at(m_Order.at(slot));
+
+                    unsigned int a = constraint.indexA;
+                    unsigned int b = constraint.indexB;
+                    vec2 vA = vec2(m_Storage->linearVelocityX[a], m_Storage->linearVelocityY[a]);
+                    vec2 vB = vec2(m_Storage->linearVelocityX[b], m_Storage->linearVelocityY[b]);
+                    float wA = m_Storage->angularVelocity[a];
+                    float wB = m_Storage->angularVelocity[b];
+
+                    vec2 normal = constraint.normal;
+                    vec2 tangent = vec2(normal.y, -normal.x);
+
+                    //Solve the tangent constraints first, the normal constraints are more important
+                    for (unsigned int j = 0; j < constraint.pointCount; j++)
+                    {
+                        ContactConstraintPoint& point = constraint.points[j];
+
+                        vec2 dv = vB + Cross(wB, point.rB) - vA - Cross(wA, point.rA);
+                        float lambda = -point.tangentMass * dot(dv, tangent);
+
+                        //Clamp the accumulated friction impulse
+                        float maxFriction = constraint.friction * point.normalImpulse;
+                        float newImpulse = glm::clamp(point.tangentImpulse + lambda, -maxFriction, maxFriction);
+                        lambda = newImpulse - point.tangentImpulse;
+                        point.tangentImpulse = newImpulse;
+
+                        vec2 impulse = lambda * tangent;
+                        vA -= constraint.inverseMassA * impulse;
+                        wA -= constraint.inverseInertiaA * Cross(point.rA, impulse);
+                        vB += constraint.inverseMassB * impulse;
+                        wB += constraint.inverseInertiaB * Cross(point.rB, impulse);
+                    }
+
+                    for (unsigned int j = 0; j < constraint.pointCount; j++)
+                    {
+                        ContactConstraintPoint& point = constraint.points[j];
+
+                        vec2 dv = vB + Cross(wB, point.rB) - vA - Cross(wA, point.rA);
+                        float lambda = -point.normalMass * (dot(dv, normal) - point.velocityBias);
+
+                        //Clamp the accumulated impulse, contacts can only push
+                        float newImpulse = std::max(point.normalImpulse + lambda, 0.0f);
+                        lambda = newImpulse - point.normalImpulse;
+                        point.normalImpulse = newImpulse;
+
+                        vec2 impulse = lambda * normal;
+                        vA -= constraint.inverseMassA * impulse;
+                        wA -= constraint.inverseInertiaA * Cross(point.rA, impulse);
+                        vB += constraint.inverseMassB * impulse;
+                        wB += constraint.inverseInertiaB * Cross(point.rB, impulse);
+                    }
+
+                    if (IsMovable(a) == true)
+                    {
+                        m_Storage->linearVelocityX[a] = vA.x;
+                        m_Storage->linearVelocityY[a] = vA.y;
+                        m_Storage->angularVelocity[a] = wA;
+                    }
+
+                    if (IsMovable(b) == true)
+                    {
+                        m_Storage->linearVelocityX[b] = vB.x;
+                        m_Storage->linearVelocityY[b] = vB.y;
+                        m_Storage->angularVelocity[b] = wB;
+                    }
+                }
+            }
+        }
+
+        void ContactSolver::SolveColoredVelocityGroup(ContactConstraintGroup& aGroup)
+        {
+            for (unsigned int iteration = 0; iteration < m_VelocityIterations; iteration++)
+            {
+                unsigned int colorBegin = aGroup.begin;
+                for (unsigned int color = 0; color <= CONTACT_SOLVER_MAX_COLORS; color++)
+                {
+                    unsigned int colorEnd = aGroup.colorEnds[color];
+                    unsigned int i = colorBegin;
+
+                    //The last colour's constraints can share bodies, so they're solved one at a time
+                    if (color < CONTACT_SOLVER_MAX_COLORS)
+                    {
+#if PHYSICS_SIMD_AVX
+                        //Solve 8 constraints at a time
+                        for (; i + 8 <= colorEnd; i += 8)
+                        {
+                            SolveVelocityLanes8(m_Lanes, m_Storage, i);
+                        }
+#endif
+
+#if PHYSICS_SIMD_SSE
+                        //Solve 4 constraints at a time
+                        for (; i + 4 <= colorEnd; i += 4)
+                        {
+                            SolveVelocityLanes4(m_Lanes, m_Storage, i);
+                        }
+#endif
+                    }
+
+                    //Solve the remaining constraints
+                    for (; i < colorEnd; i++)
+                    {
+                        SolveVelocityLanes1(m_Lanes, m_Storage, i);
+                    }
+
+                    colorBegin = colorEnd;
+                }
+            }
+
+            //Copy the accumulated impulses back into the constraints, they're cached by StoreImpulses()
+            for (unsigned int slot = aGroup.begin; slot < aGroup.end; slot++)
+            {
+                ContactConstraint& constraint = m_Constraints.at(m_Order.at(slot));
+                for (unsigned int j = 0; j < constraint.pointCount; j++)
+                {
+                    constraint.points[j].normalImpulse = m_Lanes.normalImpulse[j][slot];
+                    constraint.points[j].tangentImpulse = m_Lanes.tangentImpulse[j][slot];
+                }
+            }
+        }
+
+        void ContactSolver::SolvePositionGroup(ContactConstraintGroup& aGroup)
+        {
+            float largestOverlap = 0.0f;
+
+            for (unsigned int slot = aGroup.begin; slot < aGroup.end; slot++)
+            {
+                ContactConstraint& constraint = m_Constraints.at(m_Order.at(slot));
+
+                unsigned int a = constraint.indexA;
+                unsigned int b = constraint.indexB;
+                vec2 normal = constraint.normal;
+
+                for (unsigned int j = 0; j < constraint.pointCount; j++)
+                {
+                    ContactConstraintPoint& point = constraint.points[j];
+
+                    //How far have the contact points moved along the normal since the overlap was calculated
+                    vec2 pA = vec2(m_Storage->positionX[a], m_Storage->positionY[a]);
+                    vec2 pB = vec2(m_Storage->positionX[b], m_Storage->positionY[b]);
+                    vec2 dA = (pA - constraint.positionA) + Cross(m_Storage->angle[a] - constraint.angleA, point.rA);
+                    vec2 dB = (pB - constraint.positionB) + Cross(m_Storage->angle[b] - constraint.angleB, point.rB);
+                    float overlap = point.overlap - dot(dB - dA, normal);
+                    largestOverlap = std::max(largestOverlap, overlap);
+
+                    //Correct a percentage of the overlap, leaving a small allowance to prevent jitter
+                    float correction = glm::clamp(OVERLAP_PCT_TO_CORRECT * (overlap - OVERLAP_ALLOWANCE), 0.0f, CONTACT_SOLVER_MAX_CORRECTION);
+                    if (correction <= 0.0f || point.normalMass == 0.0f)
+                    {
+                        continue;
+                    }
+
+                    vec2 impulse = (correction * point.normalMass) * normal;
+                    if (IsMovable(a) == true)
+                    {
+                        m_Storage->positionX[a] -= constraint.inverseMassA * impulse.x;
+                        m_Storage->positionY[a] -= constraint.inverseMassA * impulse.y;
+                        m_Storage->angle[a] -= constraint.inverseInertiaA * Cross(point.rA, impulse);
+                    }
+
+                    if (IsMovable(b) == true)
+                    {
+                        m_Storage->positionX[b] += constraint.inverseMassB * impulse.x;
+                        m_Storage->positionY[b] += constraint.inverseMassB * impulse.y;
+                        m_Storage->angle[b] += constraint.inverseInertiaB * Cross(point.rB, impulse);
+                    }
+                }
+            }
+
+            aGroup.largestOverlap = largestOverlap;
+        }
+    }
+}
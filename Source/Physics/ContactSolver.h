@@ -0,0 +1,225 @@
+#ifndef __CONTACT_SOLVER_H__
+#define __CONTACT_SOLVER_H__
+
+#include "Manifold.h"
+
+
+using namespace std;
+using namespace glm;
+
+namespace GameDev2D
+{
+    //Forward declaration
+    class ThreadPool;
+
+    namespace Physics
+    {
+        //Local constants
+        const unsigned int CONTACT_SOLVER_DEFAULT_VELOCITY_ITERATIONS = 8;
+        const unsigned int CONTACT_SOLVER_DEFAULT_POSITION_ITERATIONS = 3;
+        const float CONTACT_SOLVER_RESTITUTION_THRESHOLD = 1.0f;  //In m/s, slower impacts don't bounce
+        const float CONTACT_SOLVER_MAX_CORRECTION = 0.2f;         //In meters, per position iteration
+        const unsigned int CONTACT_SOLVER_MAX_COLORS = 32;        //One bit per colour in a body's colour mask, the constraints that don't fit are solved one at a time
+        const unsigned int CONTACT_SOLVER_MIN_CONSTRAINTS_PER_TASK = 64;  //Groups smaller than this cost more to hand to a thread than to solve
+
+        //Forward declaration
+        struct BodyStorage;
+
+        //The solver's working data for a single contact point
+        struct ContactConstraintPoint
+        {
+            vec2 rA;                //From body A's center to the contact point
+            vec2 rB;                //From body B's center to the contact point
+            float overlap;
+            float normalImpulse;
+            float tangentImpulse;
+            float normalMass;
+            float tangentMass;
+            float velocityBias;     //Restitution
+        };
+
+        //The solver's working data for a manifold
+        struct ContactConstraint
+        {
+            unsigned int indexA;
+            unsigned int indexB;
+            float inverseMassA;
+            float inverseMassB;
+            float inverseInertiaA;
+            float inverseInertiaB;
+            vec2 normal;
+            float friction;
+            float restitution;
+            vec2 positionA;         //The positions and angles when the constraint was initialized, used
+            vec2 positionB;         //by the position solver to track how far the bodies have since moved
+            float angleA;
+            float angleB;
+            ContactConstraintPoint points[MANIFOLD_MAX_POINTS];
+            unsigned int pointCount;
+        };
+
+        //The velocity constraints as a structure of arrays, indexed by the constraint's slot in the solve
+        //order, used when graph colouring is enabled. The constraints of a colour share no dynamic body,
+        //so they're loaded and solved 8 (AVX) or 4 (SSE) at a time. The manifolds with a single point
+        //have the second point's masses set to 0, which makes its impulses 0
+        struct ContactConstraintLanes
+        {
+            //Resizes every array, the arrays keep their memory
+            void Resize(unsigned int count);
+
+            //Member variables
+            vector<unsigned int> indexA;
+            vector<unsigned int> indexB;
+            vector<float> inverseMassA;
+            vector<float> inverseMassB;
+            vector<float> inverseInertiaA;
+            vector<float> inverseInertiaB;
+            vector<float> normalX;
+            vector<float> normalY;
+            vector<float> friction;
+            vector<float> rAX[MANIFOLD_MAX_POINTS];
+            vector<float> rAY[MANIFOLD_MAX_POINTS];
+            vector<float> rBX[MANIFOLD_MAX_POINTS];
+            vector<float> rBY[MANIFOLD_MAX_POINTS];
+            vector<float> normalMass[MANIFOLD_MAX_POINTS];
+            vector<float> tangentMass[MANIFOLD_MAX_POINTS];
+            vector<float> velocityBias[MANIFOLD_MAX_POINTS];
+            vector<float> normalImpulse[MANIFOLD_MAX_POINTS];
+            vector<float> tangentImpulse[MANIFOLD_MAX_POINTS];
+        };
+
+        //A contiguous range of the solve order that is solved by a single task. The constraints of different
+        //groups share no dynamic body, so the groups can be solved on different threads. When graph colouring
+        //is enabled the group's range is sorted by colour, the last colour holds the constraints that didn't fit
+        struct ContactConstraintGroup
+        {
+            unsigned int begin;
+            unsigned int end;
+            unsigned int colorEnds[CONTACT_SOLVER_MAX_COLORS + 1];
+            float largestOverlap;   //Set by each position iteration
+        };
+
+        //The impulses of a manifold, kept between steps to warm start the solver
+        struct CachedContact
+        {
+            unsigned long long key;
+            unsigned int pointCount;
+            unsigned int ids[MANIFOLD_MAX_POINTS];
+            float normalImpulses[MANIFOLD_MAX_POINTS];
+            float tangentImpulses[MANIFOLD_MAX_POINTS];
+        };
+
+        //Sequential impulse contact solver. The velocity iterations apply impulses to stop
+        //the bodies from moving into each other (with friction and restitution), then the
+        //position iterations push the bodies apart to remove the remaining overlap. The
+        //impulses of each body pair are cached between steps and applied up front (warm
+        //starting) so resting contacts converge in a few iterations.
+        //
+        //Two optional strategies speed up large scenes, each can be switched on its own to measure it:
+        // - Graph colouring assigns each constraint a colour that no other constraint on its bodies has,
+        //   the velocity constraints are then solved colour by colour in SIMD lanes. This changes the
+        //   order the constraints are solved in, so the results differ (but are still deterministic)
+        // - Island splitting groups the constraints by the contact island they belong to and hands the
+        //   groups to the thread pool. The islands share no dynamic body, so the results don't change
+        class ContactSolver
+        {
+        public:
+            ContactSolver();
+            ~ContactSolver();
+
+            //Copies the cached impulses of matching contacts from the previous step into the manifolds
+            void LoadCachedImpulses(vector<Manifold>& contacts);
+
+            //Prepares the constraints and applies the warm starting impulses, must be
+            //called after the velocities have been integrated
+            void Initialize(vector<Manifold>& contacts, BodyStorage* storage);
+
+            //Solves the velocity constraints, runs every velocity iteration
+            void SolveVelocityConstraints();
+
+            //Solves the position constraints, called once per position iteration after the
+            //positions have been integrated, returns true if the overlap has been resolved
+            bool SolvePositionConstraints();
+
+            //Copies the accumulated impulses back into the manifolds and into the cache
+            void StoreImpulses(vector<Manifold>& contacts);
+
+            //Clears the cached impulses
+            void ClearCache();
+
+            //Removes the cached impulses of the contacts involving the body, called when it's destroyed
+            void RemoveCachedContacts(unsigned int index);
+
+            //The cached impulses, sorted by key, used to save and restore the cache with the World's snapshots
+            const vector<CachedContact>& GetCache();
+            void SetCache(const vector<CachedContact>& cache);
+
+            //The number of iterations the World runs each step
+            void SetVelocityIterations(unsigned int velocityIterations);
+            unsigned int GetVelocityIterations();
+
+            void SetPositionIterations(unsigned int positionIterations);
+            unsigned int GetPositionIterations();
+
+            //Sets wether the cached impulses are used to warm start the solver
+            void SetWarmStarting(bool warmStarting);
+            bool IsWarmStarting();
+
+            //Sets wether the velocity constraints are graph coloured and solved in SIMD lanes
+            void SetGraphColoring(bool graphColoring);
+            bool IsGraphColoring();
+
+            //Sets wether the contact islands are split across the thread pool's threads
+            void SetIslandSplitting(bool islandSplitting);
+            bool IsIslandSplitting();
+
+            //The thread pool the island groups are solved on, null solves everything on the calling thread
+            void SetThreadPool(ThreadPool* threadPool);
+
+        private:
+            //Conveniance method to build the cache key for a pair of bodies
+            static unsigned long long MakeKey(unsigned int indexA, unsigned int indexB);
+
+            //Returns true if the contacts can change the body's velocity, static and kinematic bodies are
+            //shared between the groups and the colours, so the solver never writes to them
+            bool IsMovable(unsigned int index);
+
+            //Splits the constraints into groups, by island if island splitting is enabled
+            void BuildGroups(vector<Manifold>& contacts);
+
+            //Returns the root body of the island the body belongs to
+            unsigned int FindIslandRoot(unsigned int index);
+
+            //Runs the task once per group, on the thread pool if there is more than one group
+            void RunGroups(const function<void(unsigned int groupIndex)>& task);
+
+            //The group tasks
+            void InitializeGroup(vector<Manifold>& contacts, ContactConstraintGroup& group);
+            void ColorGroup(ContactConstraintGroup& group);
+            void SolveVelocityGroup(ContactConstraintGroup& group);
+            void SolveColoredVelocityGroup(ContactConstraintGroup& group);
+            void SolvePositionGroup(ContactConstraintGroup& group);
+
+            //Member variables
+            BodyStorage* m_Storage;
+            vector<ContactConstraint> m_Constraints;
+            vector<CachedContact> m_Cache;
+            vector<unsigned int> m_Order;           //The constraint indices, in the order they're solved in
+            vector<unsigned int> m_SortedOrder;     //Scratch space for sorting the order
+            vector<ContactConstraintGroup> m_Groups;
+            ContactConstraintLanes m_Lanes;         //Indexed by slot in the solve order
+            vector<unsigned int> m_Colors;          //Indexed by slot in the solve order
+            vector<unsigned int> m_BodyColors;      //Indexed by body, a bit for each colour used by the body's constraints
+            vector<unsigned int> m_IslandParents;   //Indexed by body
+            vector<unsigned int> m_IslandCounts;    //Indexed by island root
+            ThreadPool* m_ThreadPool;
+            unsigned int m_VelocityIterations;
+            unsigned int m_PositionIterations;
+            bool m_WarmStarting;
+            bool m_GraphColoring;
+            bool m_IslandSplitting;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,528 @@
+#include "DynamicTree.h"
+#include "PhysicsMath.h"
+
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        DynamicTree::DynamicTree(float aAABBMargin) :
+            m_Root(DYNAMIC_TREE_NULL_NODE),
+            m_FreeList(DYNAMIC_TREE_NULL_NODE),
+            m_ProxyCount(0),
+            m_AABBMargin(aAABBMargin)
+        {
+
+        }
+
+        DynamicTree::~DynamicTree()
+        {
+            m_Nodes.clear();
+        }
+
+        int DynamicTree::CreateProxy(const AABB& aAABB, unsigned int aUserData)
+        {
+            int proxyId = AllocateNode();
+
+            //Fatten the AABB so small movements don't require the proxy to be re-inserted
+            m_Nodes.at(proxyId).aabb = aAABB.Expand(m_AABBMargin);
+            m_Nodes.at(proxyId).userData = aUserData;
+            m_Nodes.at(proxyId).height = 0;
+
+            InsertLeaf(proxyId);
+            m_ProxyCount++;
+
+            return proxyId;
+        }
+
+        void DynamicTree::DestroyProxy(int aProxyId)
+        {
+            assert(0 <= aProxyId && aProxyId < (int)m_Nodes.size());
+            assert(m_Nodes.at(aProxyId).IsLeaf() == true);
+
+            RemoveLeaf(aProxyId);
+            FreeNode(aProxyId);
+            m_ProxyCount--;
+        }
+
+        void DynamicTree::Clear()
+        {
+            m_Nodes.clear();
+            m_Root = DYNAMIC_TREE_NULL_NODE;
+            m_FreeList = DYNAMIC_TREE_NULL_NODE;
+            m_ProxyCount = 0;
+        }
+
+        bool DynamicTree::MoveProxy(int aProxyId, const AABB& aAABB)
+        {
+            assert(0 <= aProxyId && aProxyId < (int)m_Nodes.size());
+            assert(m_Nodes.at(aProxyId).IsLeaf() == true);
+
+            //If the tight AABB is still inside the fat AABB, there is nothing to do
+            if (m_Nodes.at(aProxyId).aabb.Contains(aAABB) == true)
+            {
+                return false;
+            }
+
+            RemoveLeaf(aProxyId);
+            m_Nodes.at(aProxyId).aabb = aAABB.Expand(m_AABBMargin);
+            InsertLeaf(aProxyId);
+
+            return true;
+        }
+
+        unsigned int DynamicTree::GetUserData(int aProxyId)
+        {
+            assert(0 <= aProxyId && aProxyId < (int)m_Nodes.size());
+            return m_Nodes.at(aProxyId).userData;
+        }
+
+        const AABB& DynamicTree::GetFatAABB(int aProxyId)
+        {
+            assert(0 <= aProxyId && aProxyId < (int)m_Nodes.size());
+            return m_Nodes.at(aProxyId).aabb;
+        }
+
+        void DynamicTree::Query(const AABB& aAABB, vector<int>& aProxies)
+        {
+            aProxies.clear();
+
+            if (m_Root == DYNAMIC_TREE_NULL_NODE)
+            {
+                return;
+            }
+
+            m_Stack.clear();
+            m_Stack.push_back(m_Root);
+
+            while (m_Stack.empty() == false)
+            {
+                int nodeId = m_Stack.back();
+                m_Stack.pop_back();
+
+                const DynamicTreeNode& node = m_Nodes[nodeId];
+                if (node.aabb.Overlaps(aAABB) == true)
+                {
+                    if (node.IsLeaf() == true)
+                    {
+                        aProxies.push_back(nodeId);
+                    }
+                    else
+                    {
+                        m_Stack.push_back(node.child1);
+                        m_Stack.push_back(node.child2);
+                    }
+                }
+            }
+        }
+
+        void DynamicTree::RayCast(DynamicTreeRayCastCallback* aCallback, vec2 aPoint1, vec2 aPoint2, float aMaxFraction)
+        {
+            if (m_Root == DYNAMIC_TREE_NULL_NODE)
+            {
+                return;
+            }
+
+            vec2 direction = aPoint2 - aPoint1;
+            if (dot(direction, direction) <= 0.0f)
+            {
+                return;
+            }
+            direction = normalize(direction);
+
+            //The separating axis for the segment, perpendicular to the ray
+            vec2 axis = vec2(-direction.y, direction.x);
+            vec2 absAxis = abs(axis);
+
+            //Build a bounding box for the segment
+            float maxFraction = aMaxFraction;
+            vec2 end = aPoint1 + maxFraction * (aPoint2 - aPoint1);
+            AABB segmentAABB(glm::min(aPoint1, end), glm::max(aPoint1, end));
+
+            m_Stack.clear();
+            m_Stack.push_back(m_Root);
+
+            while (m_Stack.empty() == false)
+            {
+                int nodeId = m_Stack.back();
+                m_Stack.pop_back();
+
+                const DynamicTreeNode& node = m_Nodes[nodeId];
+                if (node.aabb.Overlaps(segmentAABB) == false)
+                {
+                    continue;
+                }
+
+                //Separating axis test, |dot(axis, point1 - center)| > dot(|axis|, extents)
+                vec2 center = node.aabb.GetCenter();
+                vec2 extents = node.aabb.GetExtents();
+                float separation = fabsf(dot(axis, aPoint1 - center)) - dot(absAxis, extents);
+                if (separation > 0.0f)
+                {
+                    continue;
+                }
+
+                if (node.IsLeaf() == true)
+                {
+                    float value = aCallback->RayCastCallback(aPoint1, aPoint2, maxFraction, nodeId);
+
+                    //The callback terminated the ray cast
+                    if (value == 0.0f)
+                    {
+                        return;
+                    }
+
+                    //Clip the segment to the new max fraction
+                    if (value > 0.0f)
+                    {
+                        maxFraction = value;
+                        end = aPoint1 + maxFraction * (aPoint2 - aPoint1);
+                        segmentAABB = AABB(glm::min(aPoint1, end), glm::max(aPoint1, end));
+                    }
+                }
+                else
+                {
+                    m_Stack.push_back(node.child1);
+                    m_Stack.push_back(node.child2);
+                }
+            }
+        }
+
+        void DynamicTree::SetAABBMargin(float aAABBMargin)
+        {
+            m_AABBMargin = aAABBMargin;
+        }
+
+        float DynamicTree::GetAABBMargin()
+        {
+            return m_AABBMargin;
+        }
+
+        int DynamicTree::GetHeight()
+        {
+            if (m_Root == DYNAMIC_TREE_NULL_NODE)
+            {
+                return 0;
+            }
+            return m_Nodes.at(m_Root).height;
+        }
+
+        unsigned int DynamicTree::GetProxyCount()
+        {
+            return m_ProxyCount;
+        }
+
+        int DynamicTree::AllocateNode()
+        {
+            //Grow the node pool if the free list is empty
+            if (m_FreeList == DYNAMIC_TREE_NULL_NODE)
+            {
+                DynamicTreeNode node;
+                node.parent = DYNAMIC_TREE_NULL_NODE;
+                node.child1 = DYNAMIC_TREE_NULL_NODE;
+                node.child2 = DYNAMIC_TREE_NULL_NODE;
+                node.height = -1;
+                node.userData = 0;
+
+                m_FreeList = (int)m_Nodes.size();
+                m_Nodes.push_back(node);
+            }
+
+            //Take a node off the free list
+            int nodeId = m_FreeList;
+            m_FreeList = m_Nodes.at(nodeId).parent;
+            m_Nodes.at(nodeId).parent = DYNAMIC_TREE_NULL_NODE;
+            m_Nodes.at(nodeId).child1 = DYNAMIC_TREE_NULL_NODE;
+            m_Nodes.at(nodeId).child2 = DYNAMIC_TREE_NULL_NODE;
+            m_Nodes.at(nodeId).height = 0;
+            m_Nodes.at(nodeId).userData = 0;
+            return nodeId;
+        }
+
+        void DynamicTree::FreeNode(int aNodeId)
+        {
+            assert(0 <= aNodeId && aNodeId < (int)m_Nodes.size());
+            m_Nodes.at(aNodeId).parent = m_FreeList;
+            m_Nodes.at(aNodeId).height = -1;
+            m_FreeList = aNodeId;
+        }
+
+        void DynamicTree::InsertLeaf(int aLeaf)
+        {
+            if (m_Root == DYNAMIC_TREE_NULL_NODE)
+            {
+                m_Root = aLeaf;
+                m_Nodes.at(m_Root).parent = DYNAMIC_TREE_NULL_NODE;
+                return;
+            }
+
+            //Find the best sibling for the leaf, using the perimeter as the cost
+            AABB leafAABB = m_Nodes.at(aLeaf).aabb;
+            int index = m_Root;
+            while (m_Nodes.at(index).IsLeaf() == false)
+            {
+                int child1 = m_Nodes.at(index).child1;
+                int child2 = m_Nodes.at(index).child2;
+
+                float area = m_Nodes.at(index).aabb.GetPerimeter();
+                float combinedArea = AABB::Combine(m_Nodes.at(index).aabb, leafAABB).GetPerimeter();
+
+                //Cost of creating a new parent for this node and the new leaf
+                float cost = 2.0f * combinedArea;
+
+                //Minimum cost of pushing the leaf further down the tree
+                float inheritanceCost = 2.0f * (combinedArea - area);
+
+                //Cost of descending into child1
+                float cost1 = AABB::Combine(leafAABB, m_Nodes.at(child1).aabb).GetPerimeter() + inheritanceCost;
+                if (m_Nodes.at(child1).IsLeaf() == false)
+                {
+                    cost1 -= m_Nodes.at(child1).aabb.GetPerimeter();
+                }
+
+                //Cost of descending into child2
+                float cost2 = AABB::Combine(leafAABB, m_Nodes.at(child2).aabb).GetPerimeter() + inheritanceCost;
+                if (m_Nodes.at(child2).IsLeaf() == false)
+                {
+                    cost2 -= m_Nodes.at(child2).aabb.GetPerimeter();
+                }
+
+                //Descend according to the minimum cost
+                if (cost < cost1 && cost < cost2)
+                {
+                    break;
+                }
+
+                index = cost1 < cost2 ? child1 : child2;
+            }
+
+            int sibling = index;
+
+            //Create a new parent for the sibling and the leaf
+            int oldParent = m_Nodes.at(sibling).parent;
+            int newParent = AllocateNode();
+            m_Nodes.at(newParent).parent = oldParent;
+            m_Nodes.at(newParent).aabb = AABB::Combine(leafAABB, m_Nodes.at(sibling).aabb);
+            m_Nodes.at(newParent).height = m_Nodes.at(sibling).height + 1;
+            m_Nodes.at(newParent).child1 = sibling;
+            m_Nodes.at(newParent).child2 = aLeaf;
+            m_Nodes.at(sibling).parent = newParent;
+            m_Nodes.at(aLeaf).parent = newParent;
+
+            if (oldParent != DYNAMIC_TREE_NULL_NODE)
+            {
+                //The sibling was not the root
+                if (m_Nodes.at(oldParent).child1 == sibling)
+                {
+                    m_Nodes.at(oldParent).child1 = newParent;
+                }
+                else
+                {
+                    m_Nodes.at(oldParent).child2 = newParent;
+                }
+            }
+            else
+            {
+                //The sibling was the root
+                m_Root = newParent;
+            }
+
+            //Walk back up the tree fixing the heights and AABBs
+            index = m_Nodes.at(aLeaf).parent;
+            while (index != DYNAMIC_TREE_NULL_NODE)
+            {
+                index = Balance(index);
+
+                int child1 = m_Nodes.at(index).child1;
+                int child2 = m_Nodes.at(index).child2;
+
+                m_Nodes.at(index).height = 1 + std::max(m_Nodes.at(child1).height, m_Nodes.at(child2).height);
+                m_Nodes.at(index).aabb = AABB::Combine(m_Nodes.at(child1).aabb, m_Nodes.at(child2).aabb);
+
+                index = m_Nodes.at(index).parent;
+            }
+        }
+
+        void DynamicTree::RemoveLeaf(int aLeaf)
+        {
+            if (aLeaf == m_Root)
+            {
+                m_Root = DYNAMIC_TREE_NULL_NODE;
+                return;
+            }
+
+            int parent = m_Nodes.at(aLeaf).parent;
+            int grandParent = m_Nodes.at(parent).parent;
+            int sibling = m_Nodes.at(parent).child1 == aLeaf ? m_Nodes.at(parent).child2 : m_Nodes.at(parent).child1;
+
+            if (grandParent != DYNAMIC_TREE_NULL_NODE)
+            {
+                //Destroy the parent and connect the sibling to the grand parent
+                if (m_Nodes.at(grandParent).child1 == parent)
+                {
+                    m_Nodes.at(grandParent).child1 = sibling;
+                }
+                else
+                {
+                    m_Nodes.at(grandParent).child2 = sibling;
+                }
+                m_Nodes.at(sibling).parent = grandParent;
+                FreeNode(parent);
+
+                //Walk back up the tree fixing the heights and AABBs
+                int index = grandParent;
+                while (index != DYNAMIC_TREE_NULL_NODE)
+                {
+                    index = Balance(index);
+
+                    int child1 = m_Nodes.at(index).child1;
+                    int child2 = m_Nodes.at(index).child2;
+
+                    m_Nodes.at(index).aabb = AABB::Combine(m_Nodes.at(child1).aabb, m_Nodes.at(child2).aabb);
+                    m_Nodes.at(index).height = 1 + std::max(m_Nodes.at(child1).height, m_Nodes.at(child2).height);
+
+                    index = m_Nodes.at(index).parent;
+                }
+            }
+            else
+            {
+                m_Root = sibling;
+                m_Nodes.at(sibling).parent = DYNAMIC_TREE_NULL_NODE;
+                FreeNode(parent);
+            }
+        }
+
+        int DynamicTree::Balance(int aIndexA)
+        {
+            //Performs a left or right rotation if node A is imbalanced, returns the new root index
+            DynamicTreeNode* A = &m_Nodes[aIndexA];
+            if (A->IsLeaf() == true || A->height < 2)
+            {
+                return aIndexA;
+            }
+
+            int indexB = A->child1;
+            int indexC = A->child2;
+            DynamicTreeNode* B = &m_Nodes[indexB];
+            DynamicTreeNode* C = &m_Nodes[indexC];
+
+            int balance = C->height - B->height;
+
+            //Rotate C up
+            if (balance > 1)
+            {
+                int indexF = C->child1;
+                int indexG = C->child2;
+                DynamicTreeNode* F = &m_Nodes[indexF];
+                DynamicTreeNode* G = &m_Nodes[indexG];
+
+                //Swap A and C
+                C->child1 = aIndexA;
+                C->parent = A->parent;
+                A->parent = indexC;
+
+                //A's old parent should point to C
+                if (C->parent != DYNAMIC_TREE_NULL_NODE)
+                {
+                    if (m_Nodes[C->parent].child1 == aIndexA)
+                    {
+                        m_Nodes[C->parent].child1 = indexC;
+                    }
+                    else
+                    {
+                        m_Nodes[C->parent].child2 = indexC;
+                    }
+                }
+                else
+                {
+                    m_Root = indexC;
+                }
+
+                //Rotate
+                if (F->height > G->height)
+                {
+                    C->child2 = indexF;
+                    A->child2 = indexG;
+                    G->parent = aIndexA;
+                    A->aabb = AABB::Combine(B->aabb, G->aabb);
+                    C->aabb = AABB::Combine(A->aabb, F->aabb);
+
+                    A->height = 1 + std::max(B->height, G->height);
+                    C->height = 1 + std::max(A->height, F->height);
+                }
+                else
+                {
+                    C->child2 = indexG;
+                    A->child2 = indexF;
+                    F->parent = aIndexA;
+                    A->aabb = AABB::Combine(B->aabb, F->aabb);
+                    C->aabb = AABB::Combine(A->aabb, G->aabb);
+
+                    A->height = 1 + std::max(B->height, F->height);
+                    C->height = 1 + std::max(A->height, G->height);
+                }
+
+                return indexC;
+            }
+
+            //Rotate B up
+            if (balance < -1)
+            {
+                int indexD = B->child1;
+                int indexE = B->child2;
+                DynamicTreeNode* D = &m_Nodes[indexD];
+                DynamicTreeNode* E = &m_Nodes[indexE];
+
+                //Swap A and B
+                B->child1 = aIndexA;
+                B->parent = A->parent;
+                A->parent = indexB;
+
+                //A's old parent should point to B
+                if (B->parent != DYNAMIC_TREE_NULL_NODE)
+                {
+                    if (m_Nodes[B->parent].child1 == aIndexA)
+                    {
+                        m_Nodes[B->parent].child1 = indexB;
+                    }
+                    else
+                    {
+                        m_Nodes[B->parent].child2 = indexB;
+                    }
+                }
+                else
+                {
+                    m_Root = indexB;
+                }
+
+                //Rotate
+                if (D->height > E->height)
+                {
+                    B->child2 = indexD;
+                    A->child1 = indexE;
+                    E->parent = aIndexA;
+                    A->aabb = AABB::Combine(C->aabb, E->aabb);
+                    B->aabb = AABB::Combine(A->aabb, D->aabb);
+
+                    A->height = 1 + std::max(C->height, E->height);
+                    B->height = 1 + std::max(A->height, D->height);
+                }
+                else
+                {
+                    B->child2 = indexE;
+                    A->child1 = indexD;
+                    D->parent = aIndexA;
+                    A->aabb = AABB::Combine(C->aabb, D->aabb);
+                    B->aabb = AABB::Combine(A->aabb, E->aabb);
+
+                    A->height = 1 + std::max(C->height, D->height);
+                    B->height = 1 + std::max(A->height, E->height);
+                }
+
+                return indexB;
+            }
+
+            return aIndexA;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef __DYNAMIC_TREE_H__
+#define __DYNAMIC_TREE_H__
+
+#include "AABB.h"
+
+
+using namespace std;
+using namespace glm;
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //Local constants
+        const int DYNAMIC_TREE_NULL_NODE = -1;
+        const float DYNAMIC_TREE_DEFAULT_AABB_MARGIN = 0.1f; //In meters
+
+        //Interface used to receive the proxies hit by DynamicTree::RayCast(), the callback
+        //returns the fraction to clip the ray to: 0 terminates the ray cast, returning the
+        //maxFraction that was passed in continues the ray cast unclipped
+        class DynamicTreeRayCastCallback
+        {
+        public:
+            virtual ~DynamicTreeRayCastCallback() {}
+            virtual float RayCastCallback(vec2 point1, vec2 point2, float maxFraction, int proxyId) = 0;
+        };
+
+        //A node in the dynamic tree, leaves hold a proxy and internal nodes hold
+        //the combined AABB of their two children
+        struct DynamicTreeNode
+        {
+            bool IsLeaf() const
+            {
+                return child1 == DYNAMIC_TREE_NULL_NODE;
+            }
+
+            //Member variables
+            AABB aabb;
+            unsigned int userData;
+            int parent;     //Doubles as the next node in the free list
+            int child1;
+            int child2;
+            int height;     //Leaves are 0, free nodes are -1
+        };
+
+        //A dynamic bounding volume tree, based on Box2D's b2DynamicTree. Each proxy is
+        //stored with a 'fat' AABB, grown by a margin, so the proxy only needs to be
+        //re-inserted once its body moves outside of the fat AABB. The tree is kept
+        //balanced using rotations as leaves are inserted and removed
+        class DynamicTree
+        {
+        public:
+            DynamicTree(float aabbMargin = DYNAMIC_TREE_DEFAULT_AABB_MARGIN);
+            ~DynamicTree();
+
+            //Creates a proxy for the tight AABB, the user data is returned by GetUserData()
+            int CreateProxy(const AABB& aabb, unsigned int userData);
+
+            //Removes a proxy from the tree
+            void DestroyProxy(int proxyId);
+
+            //Removes every proxy from the tree, the nodes keep their memory
+            void Clear();
+
+            //Updates the proxy with its new tight AABB, returns true if the proxy
+            //left its fat AABB and had to be re-inserted into the tree
+            bool MoveProxy(int proxyId, const AABB& aabb);
+
+            //Returns the user data and fat AABB of a proxy
+            unsigned int GetUserData(int proxyId);
+            const AABB& GetFatAABB(int proxyId);
+
+            //Fills the proxies vector with every proxy whose fat AABB overlaps the AABB
+            void Query(const AABB& aabb, vector<int>& proxies);
+
+            //Casts a ray from point1 to point2, the callback is called for every proxy whose
+            //fat AABB the ray passes through, in no particular order
+            void RayCast(DynamicTreeRayCastCallback* callback, vec2 point1, vec2 point2, float maxFraction = 1.0f);
+
+            //The margin (in meters) that proxy AABBs are grown by
+            void SetAABBMargin(float aabbMargin);
+            float GetAABBMargin();
+
+            //Returns the height of the tree, 0 if the tree is empty
+            int GetHeight();
+
+            //Returns the number of proxies in the tree
+            unsigned int GetProxyCount();
+
+        private:
+            //Node management methods
+            int AllocateNode();
+            void FreeNode(int nodeId);
+
+            //Tree management methods
+            void InsertLeaf(int leaf);
+            void RemoveLeaf(int leaf);
+            int Balance(int nodeId);
+
+            //Member variables
+            vector<DynamicTreeNode> m_Nodes;
+            vector<int> m_Stack;
+            int m_Root;
+            int m_FreeList;
+            unsigned int m_ProxyCount;
+            float m_AABBMargin;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,148 @@
+#include "DynamicTreeBroadPhase.h"
+#include "Body.h"
+
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        DynamicTreeBroadPhase::DynamicTreeBroadPhase(float aAABBMargin) : BroadPhase("Physics::DynamicTreeBroadPhase"),
+            m_Tree(aAABBMargin),
+            m_MovedProxyCount(0)
+        {
+
+        }
+
+        DynamicTreeBroadPhase::~DynamicTreeBroadPhase()
+        {
+
+        }
+
+        void DynamicTreeBroadPhase::Update(const vector<Body*>& aBodies, const vector<AABB>& aAABBs)
+        {
+            m_AABBs.resize(aBodies.size());
+            m_MovedProxyCount = 0;
+
+            //Drop the proxies of the slots that no longer exist, after a World snapshot with fewer bodies was restored
+            while (m_ProxyIds.size() > aBodies.size())
+            {
+                if (m_ProxyIds.back() != DYNAMIC_TREE_NULL_NODE)
+                {
+                    m_Tree.DestroyProxy(m_ProxyIds.back());
+                }
+                m_ProxyIds.pop_back();
+            }
+
+            //Make room for the bodies that were added since the last step
+            while (m_ProxyIds.size() < aBodies.size())
+            {
+                m_ProxyIds.push_back(DYNAMIC_TREE_NULL_NODE);
+            }
+
+            //Refit the proxies of the bodies that left their fat AABB
+            for (unsigned int i = 0; i < aBodies.size(); i++)
+            {
+                //Destroy the proxies of the bodies that were destroyed, and create
+                //proxies for the bodies that were created, in new or reused slots
+                if (aBodies.at(i) == nullptr)
+                {
+                    if (m_ProxyIds.at(i) != DYNAMIC_TREE_NULL_NODE)
+                    {
+                        m_Tree.DestroyProxy(m_ProxyIds.at(i));
+                        m_ProxyIds.at(i) = DYNAMIC_TREE_NULL_NODE;
+                    }
+                    continue;
+                }
+
+                m_AABBs.at(i) = aAABBs.at(i);
+
+                if (m_ProxyIds.at(i) == DYNAMIC_TREE_NULL_NODE)
+                {
+                    m_ProxyIds.at(i) = m_Tree.CreateProxy(m_AABBs.at(i), i);
+                    continue;
+                }
+
+                if (m_Tree.MoveProxy(m_ProxyIds.at(i), m_AABBs.at(i)) == true)
+                {
+                    m_MovedProxyCount++;
+                }
+            }
+        }
+
+        void DynamicTreeBroadPhase::FindPairs(const vector<Body*>& aBodies, const vector<AABB>& aAABBs, vector<BroadPhasePair>& aPairs)
+        {
+            aPairs.clear();
+
+            //Refit the tree
+            Update(aBodies, aAABBs);
+
+            //Query the tree with each body's tight AABB, the fat AABBs in the tree can report
+            //bodies that aren't actually touching so test the tight AABBs before adding the pair
+            for (unsigned int i = 0; i < aBodies.size(); i++)
+            {
+                if (aBodies.at(i) == nullptr)
+                {
+                    continue;
+                }
+
+                m_Tree.Query(m_AABBs.at(i), m_QueryResults);
+
+                for (unsigned int j = 0; j < m_QueryResults.size(); j++)
+                {
+                    unsigned int other = m_Tree.GetUserData(m_QueryResults.at(j));
+
+                    //Only add each pair once
+                    if (other <= i)
+                    {
+                        continue;
+                    }
+
+                    //Skip the pairs whose collision filters don't let them collide
+                    if (m_AABBs.at(i).Overlaps(m_AABBs.at(other)) == true && aBodies.at(i)->ShouldCollide(aBodies.at(other)) == true)
+                    {
+                        aPairs.push_back(BroadPhasePair(i, other));
+                    }
+                }
+            }
+
+            //Sort the pairs so the narrowphase order doesn't depend on the tree's layout
+            SortPairs(aPairs);
+        }
+
+        void DynamicTreeBroadPhase::Query(const AABB& aAABB, vector<unsigned int>& aBodies)
+        {
+            aBodies.clear();
+            m_Tree.Query(aAABB, m_QueryResults);
+
+            //Test the tight AABBs, the tree holds the fat AABBs
+            for (unsigned int i = 0; i < m_QueryResults.size(); i++)
+            {
+                unsigned int index = m_Tree.GetUserData(m_QueryResults.at(i));
+
+                if (m_AABBs.at(index).Overlaps(aAABB) == true)
+                {
+                    aBodies.push_back(index);
+                }
+            }
+
+            std::sort(aBodies.begin(), aBodies.end());
+        }
+
+        void DynamicTreeBroadPhase::Clear()
+        {
+            m_Tree.Clear();
+            m_ProxyIds.clear();
+            m_MovedProxyCount = 0;
+        }
+
+        DynamicTree* DynamicTreeBroadPhase::GetTree()
+        {
+            return &m_Tree;
+        }
+
+        unsigned int DynamicTreeBroadPhase::GetMovedProxyCount()
+        {
+            return m_MovedProxyCount;
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef __DYNAMIC_TREE_BROAD_PHASE_H__
+#define __DYNAMIC_TREE_BROAD_PHASE_H__
+
+#include "BroadPhase.h"
+#include "DynamicTree.h"
+
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //Broadphase that keeps a proxy for every body in a DynamicTree. Bodies are only
+        //re-inserted into the tree when they leave their fat AABB, so resting bodies cost
+        //a containment test per step. Handles a large spread of body sizes far better
+        //than the SpatialHash, since there is no cell size to tune
+        class DynamicTreeBroadPhase : public BroadPhase
+        {
+        public:
+            DynamicTreeBroadPhase(float aabbMargin = DYNAMIC_TREE_DEFAULT_AABB_MARGIN);
+            ~DynamicTreeBroadPhase();
+
+            void Update(const vector<Body*>& bodies, const vector<AABB>& aabbs);
+            void FindPairs(const vector<Body*>& bodies, const vector<AABB>& aabbs, vector<BroadPhasePair>& pairs);
+            void Query(const AABB& aabb, vector<unsigned int>& bodies);
+
+            //Removes every proxy, the next Update() creates them again from the bodies' AABBs, in
+            //index order. The World clears the tree when it restores a snapshot, since the fat AABBs
+            //aren't saved, so a rewound World's tree only depends on the restored bodies
+            void Clear();
+
+            //Returns the tree, which can be used for region and ray queries. The
+            //user data of each proxy is the body's index in the World
+            DynamicTree* GetTree();
+
+            //Returns the number of proxies that were re-inserted during the last Update()
+            unsigned int GetMovedProxyCount();
+
+        private:
+            //Member variables
+            DynamicTree m_Tree;
+            vector<int> m_ProxyIds;
+            vector<AABB> m_AABBs;
+            vector<int> m_QueryResults;
+            unsigned int m_MovedProxyCount;
+        };
+    }
+}
+
+#endif
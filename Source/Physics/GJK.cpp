@@ -0,0 +1,458 @@
+#include "GJK.h"
+#include "PhysicsMath.h"
+
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //Conveniance methods for the 2D dot and cross products
+        static inline float Cross(vec2 aA, vec2 aB)
+        {
+            return aA.x * aB.y - aA.y * aB.x;
+        }
+
+        static inline float Dot(vec2 aA, vec2 aB)
+        {
+            return aA.x * aB.x + aA.y * aB.y;
+        }
+
+        //A vertex of the Minkowski difference B - A, and the shape vertices it came from
+        struct SimplexVertex
+        {
+            vec2 wA;                //Support point on shape A
+            vec2 wB;                //Support point on shape B
+            vec2 w;                 //wB - wA
+            float a;                //Barycentric coordinate of the closest point
+            unsigned int indexA;
+            unsigned int indexB;
+        };
+
+        //The GJK simplex, a point, segment or triangle of the Minkowski difference
+        struct Simplex
+        {
+            //Loads the cached vertices, an empty or invalid cache starts from the first vertex of each shape
+            void ReadCache(const SimplexCache& aCache, const ConvexShape& aShapeA, const ConvexShape& aShapeB)
+            {
+                count = aCache.count;
+                for (unsigned int i = 0; i < count; i++)
+                {
+                    //The shapes may have changed since the cache was written
+                    if (aCache.indexA[i] >= aShapeA.count || aCache.indexB[i] >= aShapeB.count)
+                    {
+                        count = 0;
+                        break;
+                    }
+
+                    SimplexVertex* v = vertices + i;
+                    v->indexA = aCache.indexA[i];
+                    v->indexB = aCache.indexB[i];
+                    v->wA = aShapeA.vertices[v->indexA];
+                    v->wB = aShapeB.vertices[v->indexB];
+                    v->w = v->wB - v->wA;
+                    v->a = 0.0f;
+                }
+
+                //A cached segment or triangle that has collapsed can't be solved
+                if (count == 2 && Dot(vertices[1].w - vertices[0].w, vertices[1].w - vertices[0].w) < FLT_EPSILON)
+                {
+                    count = 0;
+                }
+                else if (count == 3 && fabsf(Cross(vertices[1].w - vertices[0].w, vertices[2].w - vertices[0].w)) < FLT_EPSILON)
+                {
+                    count = 0;
+                }
+
+                if (count == 0)
+                {
+                    SimplexVertex* v = vertices + 0;
+                    v->indexA = 0;
+                    v->indexB = 0;
+                    v->wA = aShapeA.vertices[0];
+                    v->wB = aShapeB.vertices[0];
+                    v->w = v->wB - v->wA;
+                    v->a = 1.0f;
+                    count = 1;
+                }
+            }
+
+            void WriteCache(SimplexCache* aCache) const
+            {
+                aCache->count = count;
+                for (unsigned int i = 0; i < count; i++)
+                {
+                    aCache->indexA[i] = (unsigned char)vertices[i].indexA;
+                    aCache->indexB[i] = (unsigned char)vertices[i].indexB;
+                }
+            }
+
+            //Returns the direction from the simplex towards the origin
+            vec2 GetSearchDirection() const
+            {
+                if (count == 1)
+                {
+                    return -vertices[0].w;
+                }
+
+                vec2 edge = vertices[1].w - vertices[0].w;
+                if (Cross(edge, -vertices[0].w) > 0.0f)
+                {
+                    //The origin is to the left of the edge
+                    return vec2(-edge.y, edge.x);
+                }
+                return vec2(edge.y, -edge.x);
+            }
+
+            //Returns the closest points on each shape, from the barycentric coordinates
+            void GetWitnessPoints(vec2* aPointA, vec2* aPointB) const
+            {
+                if (count == 1)
+                {
+                    *aPointA = vertices[0].wA;
+                    *aPointB = vertices[0].wB;
+                }
+                else if (count == 2)
+                {
+                    *aPointA = vertices[0].wA * vertices[0].a + vertices[1].wA * vertices[1].a;
+                    *aPointB = vertices[0].wB * vertices[0].a + vertices[1].wB * vertices[1].a;
+                }
+                else
+                {
+                    *aPointA = vertices[0].wA * vertices[0].a + vertices[1].wA * vertices[1].a + vertices[2].wA * vertices[2].a;
+                    *aPointB = *aPointA;
+                }
+            }
+
+            //Reduces the segment to the feature closest to the origin
+            void Solve2()
+            {
+                vec2 w1 = vertices[0].w;
+                vec2 w2 = vertices[1].w;
+                vec2 e12 = w2 - w1;
+
+                //The origin is beyond w1
+                float d12_2 = -Dot(w1, e12);
+                if (d12_2 <= 0.0f)
+                {
+                    vertices[0].a = 1.0f;
+                    count = 1;
+                    return;
+                }
+
+                //The origin is beyond w2
+                float d12_1 = Dot(w2, e12);
+                if (d12_1 <= 0.0f)
+                {
+                    vertices[1].a = 1.0f;
+                    vertices[0] = vertices[1];
+                    count = 1;
+                    return;
+                }
+
+                //The origin is alongside the segment
+                float inverse = 1.0f / (d12_1 + d12_2);
+                vertices[0].a = d12_1 * inverse;
+                vertices[1].a = d12_2 * inverse;
+                count = 2;
+            }
+
+            //Reduces the triangle to the feature closest to the origin, leaves it whole if it contains the origin
+            void Solve3()
+            {
+                vec2 w1 = vertices[0].w;
+                vec2 w2 = vertices[1].w;
+                vec2 w3 = vertices[2].w;
+
+                vec2 e12 = w2 - w1;
+                float d12_1 = Dot(w2, e12);
+                float d12_2 = -Dot(w1, e12);
+
+                vec2 e13 = w3 - w1;
+                float d13_1 = Dot(w3, e13);
+                float d13_2 = -Dot(w1, e13);
+
+                vec2 e23 = w3 - w2;
+                float d23_1 = Dot(w3, e23);
+                float d23_2 = -Dot(w2, e23);
+
+                float n123 = Cross(e12, e13);
+                float d123_1 = n123 * Cross(w2, w3);
+                float d123_2 = n123 * Cross(w3, w1);
+                float d123_3 = n123 * Cross(w1, w2);
+
+                //Vertex w1
+                if (d12_2 <= 0.0f && d13_2 <= 0.0f)
+                {
+                    vertices[0].a = 1.0f;
+                    count = 1;
+                    return;
+                }
+
+                //Edge w1-w2
+                if (d12_1 > 0.0f && d12_2 > 0.0f && d123_3 <= 0.0f)
+                {
+                    float inverse = 1.0f / (d12_1 + d12_2);
+                    vertices[0].a = d12_1 * inverse;
+                    vertices[1].a = d12_2 * inverse;
+                    count = 2;
+                    return;
+                }
+
+                //Edge w1-w3
+                if (d13_1 > 0.0f && d13_2 > 0.0f && d123_2 <= 0.0f)
+                {
+                    float inverse = 1.0f / (d13_1 + d13_2);
+                    vertices[0].a = d13_1 * inverse;
+                    vertices[2].a = d13_2 * inverse;
+                    vertices[1] = vertices[2];
+                    count = 2;
+                    return;
+                }
+
+                //Vertex w2
+                if (d12_1 <= 0.0f && d23_2 <= 0.0f)
+                {
+                    vertices[1].a = 1.0f;
+                    vertices[0] = vertices[1];
+                    count = 1;
+                    return;
+                }
+
+                //Vertex w3
+                if (d13_1 <= 0.0f && d23_1 <= 0.0f)
+                {
+                    vertices[2].a = 1.0f;
+                    vertices[0] = vertices[2];
+                    count = 1;
+                    return;
+                }
+
+                //Edge w2-w3
+                if (d23_1 > 0.0f && d23_2 > 0.0f && d123_1 <= 0.0f)
+                {
+                    float inverse = 1.0f / (d23_1 + d23_2);
+                    vertices[1].a = d23_1 * inverse;
+                    vertices[2].a = d23_2 * inverse;
+                    vertices[0] = vertices[2];
+                    count = 2;
+                    return;
+                }
+
+                //The origin is inside the triangle
+                float inverse = 1.0f / (d123_1 + d123_2 + d123_3);
+                vertices[0].a = d123_1 * inverse;
+                vertices[1].a = d123_2 * inverse;
+                vertices[2].a = d123_3 * inverse;
+                count = 3;
+            }
+
+            //Member variables
+            SimplexVertex vertices[3];
+            unsigned int count;
+        };
+
+        //Runs GJK, leaves the simplex closest to the origin, which is a triangle if the shapes overlap
+        static unsigned int RunGJK(const ConvexShape& aShapeA, const ConvexShape& aShapeB, SimplexCache* aCache, Simplex* aSimplex)
+        {
+            aSimplex->ReadCache(*aCache, aShapeA, aShapeB);
+
+            unsigned int iterations = 0;
+            while (iterations < GJK_MAX_ITERATIONS)
+            {
+                //Remember the vertices, to stop if a support point repeats
+                unsigned int saveCount = aSimplex->count;
+                unsigned int saveA[3];
+                unsigned int saveB[3];
+                for (unsigned int i = 0; i < saveCount; i++)
+                {
+                    saveA[i] = aSimplex->vertices[i].indexA;
+                    saveB[i] = aSimplex->vertices[i].indexB;
+                }
+
+                if (aSimplex->count == 2)
+                {
+                    aSimplex->Solve2();
+                }
+                else if (aSimplex->count == 3)
+                {
+                    aSimplex->Solve3();
+                }
+
+                //The origin is inside the triangle, the shapes overlap
+                if (aSimplex->count == 3)
+                {
+                    break;
+                }
+
+                //The origin is on the simplex, the shapes are touching
+                vec2 direction = aSimplex->GetSearchDirection();
+                if (Dot(direction, direction) < FLT_EPSILON * FLT_EPSILON)
+                {
+                    break;
+                }
+
+                //Add the support point in the search direction
+                SimplexVertex* vertex = aSimplex->vertices + aSimplex->count;
+                vertex->indexA = aShapeA.GetSupport(-direction);
+                vertex->indexB = aShapeB.GetSupport(direction);
+                vertex->wA = aShapeA.vertices[vertex->indexA];
+                vertex->wB = aShapeB.vertices[vertex->indexB];
+                vertex->w = vertex->wB - vertex->wA;
+                iterations++;
+
+                //A repeated support point means no progress can be made, the simplex is the closest feature
+                bool duplicate = false;
+                for (unsigned int i = 0; i < saveCount; i++)
+                {
+                    if (vertex->indexA == saveA[i] && vertex->indexB == saveB[i])
+                    {
+                        duplicate = true;
+                        break;
+                    }
+                }
+
+                if (duplicate == true)
+                {
+                    break;
+                }
+
+                aSimplex->count++;
+            }
+
+            aSimplex->WriteCache(aCache);
+            return iterations;
+        }
+
+        void ComputeDistance(const ConvexShape& aShapeA, const ConvexShape& aShapeB, SimplexCache* aCache, DistanceOutput* aOutput)
+        {
+            Simplex simplex;
+            aOutput->iterations = RunGJK(aShapeA, aShapeB, aCache, &simplex);
+            simplex.GetWitnessPoints(&aOutput->pointA, &aOutput->pointB);
+
+            vec2 offset = aOutput->pointB - aOutput->pointA;
+            aOutput->distance = simplex.count == 3 ? 0.0f : sqrtf(Dot(offset, offset));
+        }
+
+        bool ComputePenetration(const ConvexShape& aShapeA, const ConvexShape& aShapeB, SimplexCache* aCache, PenetrationOutput* aOutput)
+        {
+            Simplex simplex;
+            aOutput->iterations = RunGJK(aShapeA, aShapeB, aCache, &simplex);
+
+            //Separated shapes have a closest point that isn't the origin
+            if (simplex.count < 3)
+            {
+                vec2 pointA;
+                vec2 pointB;
+                simplex.GetWitnessPoints(&pointA, &pointB);
+                vec2 offset = pointB - pointA;
+                if (Dot(offset, offset) > EPA_TOLERANCE * EPA_TOLERANCE)
+                {
+                    return false;
+                }
+            }
+
+            //Build the starting polytope from the simplex, the shapes are touching if GJK stopped on a point or
+            //a segment, so grow it into a triangle with the support points along the segment's normals
+            vec2 polytope[EPA_MAX_VERTICES];
+            unsigned int count = 0;
+            for (unsigned int i = 0; i < simplex.count; i++)
+            {
+                polytope[count++] = simplex.vertices[i].w;
+            }
+
+            vec2 directions[3] = { vec2(1.0f, 0.0f), vec2(-1.0f, 0.0f), vec2(0.0f, 1.0f) };
+            for (unsigned int i = 0; count < 3 && i < 4; i++)
+            {
+                vec2 direction = directions[i % 3];
+                if (count == 2)
+                {
+                    vec2 edge = polytope[1] - polytope[0];
+                    direction = i % 2 == 0 ? vec2(-edge.y, edge.x) : vec2(edge.y, -edge.x);
+                }
+
+                vec2 w = aShapeB.vertices[aShapeB.GetSupport(direction)] - aShapeA.vertices[aShapeA.GetSupport(-direction)];
+
+                //Only keep support points that add area to the polytope
+                bool degenerate = false;
+                for (unsigned int j = 0; j < count; j++)
+                {
+                    vec2 offset = w - polytope[j];
+                    if (Dot(offset, offset) < EPA_TOLERANCE * EPA_TOLERANCE)
+                    {
+                        degenerate = true;
+                    }
+                }
+                if (count == 2 && fabsf(Cross(polytope[1] - polytope[0], w - polytope[0])) < EPA_TOLERANCE * EPA_TOLERANCE)
+                {
+                    degenerate = true;
+                }
+
+                if (degenerate == false)
+                {
+                    polytope[count++] = w;
+                }
+            }
+
+            //The Minkowski difference has no area (two segments for example), there is no penetration to find
+            if (count < 3)
+            {
+                return false;
+            }
+
+            //Wind the polytope counter-clockwise, so the edge normals point outwards
+            if (Cross(polytope[1] - polytope[0], polytope[2] - polytope[0]) < 0.0f)
+            {
+                std::swap(polytope[1], polytope[2]);
+            }
+
+            //Expand the edge closest to the origin until it's on the Minkowski difference's boundary
+            vec2 normal = vec2(0.0f, 0.0f);
+            float depth = 0.0f;
+            for (unsigned int iteration = 0; iteration < EPA_MAX_ITERATIONS; iteration++)
+            {
+                unsigned int closestEdge = 0;
+                float closestDistance = FLT_MAX;
+                for (unsigned int i = 0; i < count; i++)
+                {
+                    vec2 edge = polytope[i + 1 < count ? i + 1 : 0] - polytope[i];
+                    float length = sqrtf(Dot(edge, edge));
+                    if (length < FLT_EPSILON)
+                    {
+                        continue;
+                    }
+
+                    vec2 edgeNormal = vec2(edge.y, -edge.x) / length;
+                    float distance = Dot(edgeNormal, polytope[i]);
+                    if (distance < closestDistance)
+                    {
+                        closestDistance = distance;
+                        closestEdge = i;
+                        normal = edgeNormal;
+                    }
+                }
+
+                depth = closestDistance;
+                aOutput->iterations++;
+
+                vec2 support = aShapeB.vertices[aShapeB.GetSupport(normal)] - aShapeA.vertices[aShapeA.GetSupport(-normal)];
+                if (Dot(support, normal) - closestDistance < EPA_TOLERANCE || count == EPA_MAX_VERTICES)
+                {
+                    break;
+                }
+
+                //Insert the support point between the edge's vertices
+                for (unsigned int i = count; i > closestEdge + 1; i--)
+                {
+                    polytope[i] = polytope[i - 1];
+                }
+                polytope[closestEdge + 1] = support;
+                count++;
+            }
+
+            //The polytope's normal points out of B - A, B separates from A by moving the other way
+            aOutput->normal = -normal;
+            aOutput->depth = std::max(depth, 0.0f);
+            return true;
+        }
+    }
+}
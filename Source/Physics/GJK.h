@@ -0,0 +1,108 @@
+#ifndef __GJK_H__
+#define __GJK_H__
+
+
+using namespace glm;
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //Local constants
+        const unsigned int CONVEX_SHAPE_MAX_VERTICES = 8;
+        const unsigned int GJK_MAX_ITERATIONS = 20;
+        const unsigned int EPA_MAX_ITERATIONS = 20;
+        const unsigned int EPA_MAX_VERTICES = 32;
+        const float EPA_TOLERANCE = 0.0001f;    //In meters, the polytope has converged once a new support point is this close to its closest edge
+
+        //A convex shape in world space, used by the GJK and EPA queries. A single vertex is a point,
+        //so a circle is queried as its center and the radius is taken off the distance afterwards.
+        //The shape points at its vertices, which are owned by the caller, usually the World's shape cache
+        struct ConvexShape
+        {
+            ConvexShape()
+            {
+                this->vertices = nullptr;
+                this->count = 0;
+            }
+
+            ConvexShape(const vec2* vertices, unsigned int count)
+            {
+                this->vertices = vertices;
+                this->count = count;
+            }
+
+            //Returns the index of the vertex furthest along the direction
+            unsigned int GetSupport(vec2 direction) const
+            {
+                unsigned int bestIndex = 0;
+                float bestValue = vertices[0].x * direction.x + vertices[0].y * direction.y;
+                for (unsigned int i = 1; i < count; i++)
+                {
+                    float value = vertices[i].x * direction.x + vertices[i].y * direction.y;
+                    if (value > bestValue)
+                    {
+                        bestIndex = i;
+                        bestValue = value;
+                    }
+                }
+                return bestIndex;
+            }
+
+            //Member variables
+            const vec2* vertices;
+            unsigned int count;     //At most CONVEX_SHAPE_MAX_VERTICES
+        };
+
+        //The vertices of the simplex GJK finished with, kept between steps so GJK can start from the last
+        //step's answer. Shapes that have barely moved then converge in one or two iterations
+        struct SimplexCache
+        {
+            SimplexCache()
+            {
+                this->count = 0;
+                this->indexA[0] = this->indexA[1] = this->indexA[2] = 0;
+                this->indexB[0] = this->indexB[1] = this->indexB[2] = 0;
+            }
+
+            //Member variables
+            unsigned int count;         //0 when there is nothing cached
+            unsigned char indexA[3];    //Vertices of shape A
+            unsigned char indexB[3];    //Vertices of shape B
+        };
+
+        //The simplex cache of a body pair, the key is the World's pair key
+        struct CachedSimplex
+        {
+            unsigned long long key;
+            SimplexCache simplex;
+        };
+
+        //The result of a distance query
+        struct DistanceOutput
+        {
+            vec2 pointA;                //Closest point on shape A
+            vec2 pointB;                //Closest point on shape B
+            float distance;             //0 if the shapes overlap
+            unsigned int iterations;    //Number of GJK iterations it took
+        };
+
+        //The result of a penetration query
+        struct PenetrationOutput
+        {
+            vec2 normal;                //From shape A to shape B, moving B along it by the depth separates the shapes
+            float depth;
+            unsigned int iterations;    //Number of GJK and EPA iterations it took
+        };
+
+        //Computes the distance between two convex shapes, and their closest points, using GJK. The cache
+        //is used to start the search and is updated with the final simplex, it can be empty
+        void ComputeDistance(const ConvexShape& shapeA, const ConvexShape& shapeB, SimplexCache* cache, DistanceOutput* output);
+
+        //Returns true if the two convex shapes overlap, and computes how deep, and along which normal, using
+        //GJK and then EPA, which expands GJK's final simplex out to the edge of the Minkowski difference
+        bool ComputePenetration(const ConvexShape& shapeA, const ConvexShape& shapeB, SimplexCache* cache, PenetrationOutput* output);
+    }
+}
+
+#endif
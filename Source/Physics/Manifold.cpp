@@ -11,17 +11,34 @@ namespace GameDev2D
         Manifold::Manifold(Body* aBodyA, Body* aBodyB) :
             m_BodyA(aBodyA),
             m_BodyB(aBodyB),
-            m_Overlap(0.0f),
-            m_Normal(0.0f, 0.0f)
+            m_Normal(0.0f, 0.0f),
+            m_PointCount(0)
         {
 
         }
 
-        void Manifold::CorrectOverlap()
+        void Manifold::SetContact(float aOverlap, vec2 aNormal, vec2 aPoint)
         {
-            vec2 correction = (std::max(m_Overlap - OVERLAP_ALLOWANCE, 0.0f) / (m_BodyA->GetInverseMass() + m_BodyB->GetInverseMass())) * m_Normal * OVERLAP_PCT_TO_CORRECT;
-            m_BodyA->SetPosition(m_BodyA->GetPosition() - correction * m_BodyA->GetInverseMass());
-            m_BodyB->SetPosition(m_BodyB->GetPosition() + correction * m_BodyB->GetInverseMass());
+            m_PointCount = 0;
+            SetNormal(aNormal);
+            AddPoint(aPoint, aOverlap, 0);
+        }
+
+        void Manifold::SetNormal(vec2 aNormal)
+        {
+            m_Normal = aNormal;
+        }
+
+        void Manifold::AddPoint(vec2 aPosition, float aOverlap, unsigned int aId)
+        {
+            if (m_PointCount < MANIFOLD_MAX_POINTS)
+            {
+                m_Points[m_PointCount] = ManifoldPoint();
+                m_Points[m_PointCount].position = aPosition;
+                m_Points[m_PointCount].overlap = aOverlap;
+                m_Points[m_PointCount].id = aId;
+                m_PointCount++;
+            }
         }
 
         void Manifold::FlipNormal()
@@ -29,10 +46,38 @@ namespace GameDev2D
             m_Normal = -m_Normal;
         }
 
-        void Manifold::SetContact(float aOverlap, vec2 aNormal)
+        Body* Manifold::GetBodyA()
         {
-            m_Overlap = aOverlap;
-            m_Normal = aNormal;
+            return m_BodyA;
+        }
+
+        Body* Manifold::GetBodyB()
+        {
+            return m_BodyB;
+        }
+
+        vec2 Manifold::GetNormal()
+        {
+            return m_Normal;
+        }
+
+        unsigned int Manifold::GetPointCount()
+        {
+            return m_PointCount;
+        }
+
+        ManifoldPoint* Manifold::GetPoint(unsigned int aIndex)
+        {
+            if (aIndex < m_PointCount)
+            {
+                return &m_Points[aIndex];
+            }
+            return nullptr;
+        }
+
+        SimplexCache* Manifold::GetSimplexCache()
+        {
+            return &m_SimplexCache;
         }
     }
-}
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef __MANIFOLD_H__
 #define __MANIFOLD_H__
 
+#include "GJK.h"
+
 
 using namespace glm;
 
@@ -11,29 +13,67 @@ namespace GameDev2D
         //Local constants
         const float OVERLAP_ALLOWANCE = 0.05f;
         const float OVERLAP_PCT_TO_CORRECT = 0.6f; //Percentage to correct
+        const unsigned int MANIFOLD_MAX_POINTS = 2;
 
         //Forward declaration
         class Body;
 
+        //A single point of contact between two bodies
+        struct ManifoldPoint
+        {
+            ManifoldPoint()
+            {
+                this->position = vec2(0.0f, 0.0f);
+                this->overlap = 0.0f;
+                this->id = 0;
+                this->normalImpulse = 0.0f;
+                this->tangentImpulse = 0.0f;
+            }
+
+            //Member variables
+            vec2 position;          //In meters, world space
+            float overlap;          //Amount of overlap at this point
+            unsigned int id;        //Identifies the contact feature, used to match points between steps
+            float normalImpulse;    //Accumulated by the contact solver, used to warm start the next step
+            float tangentImpulse;
+        };
+
         class Manifold
         {
         public:
             Manifold(Body* bodyA, Body* bodyB);
 
-            void SetContact(float overlap, vec2 normal);
+            //Sets the collision normal, and adds a single contact point
+            void SetContact(float overlap, vec2 normal, vec2 point);
+
+            //Sets the collision normal (from A to B) and adds a contact point to the manifold
+            void SetNormal(vec2 normal);
+            void AddPoint(vec2 position, float overlap, unsigned int id);
 
             void FlipNormal();
 
-            void CorrectOverlap();
+            Body* GetBodyA();
+            Body* GetBodyB();
+
+            vec2 GetNormal();
+
+            unsigned int GetPointCount();
+            ManifoldPoint* GetPoint(unsigned int index);
+
+            //The GJK simplex of the collision check, loaded from the previous step by the World before the
+            //check and saved for the next step afterwards. Checks that don't use GJK leave it empty
+            SimplexCache* GetSimplexCache();
 
         private:
             //Member variables
             Body* m_BodyA;
             Body* m_BodyB;
-            float m_Overlap;      // Amount of overlap from collision
             vec2 m_Normal;        // From A to B
+            ManifoldPoint m_Points[MANIFOLD_MAX_POINTS];
+            unsigned int m_PointCount;
+            SimplexCache m_SimplexCache;
         };
     }
 }
 
-#endif
\ No newline at end of file
+#endif
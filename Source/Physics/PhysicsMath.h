@@ -0,0 +1,72 @@
+#ifndef __PHYSICS_MATH_H__
+#define __PHYSICS_MATH_H__
+
+#include "FrameworkConfig.h"
+
+//Strict float policy for deterministic builds, stop the compiler from fusing multiplies and
+//adds into FMA instructions, which round differently depending on the target CPU
+#if PHYSICS_DETERMINISTIC
+    #if defined(_MSC_VER)
+        #pragma float_control(precise, on)
+        #pragma fp_contract(off)
+    #elif defined(__clang__)
+        #pragma STDC FP_CONTRACT OFF
+    #elif defined(__GNUC__)
+        #pragma GCC optimize("fp-contract=off")
+    #endif
+#endif
+
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //Local constants, pi / 2 split into three parts so the range reduction below is exact
+        const float PHYSICS_MATH_TWO_OVER_PI = 0.636619772367581f;
+        const float PHYSICS_MATH_HALF_PI_1 = 1.5703125f;
+        const float PHYSICS_MATH_HALF_PI_2 = 4.837512969970703125e-4f;
+        const float PHYSICS_MATH_HALF_PI_3 = 7.54978995489188216e-8f;
+
+        //Sine and cosine used by the physics world. The C library's sinf() and cosf() give different
+        //results on different platforms, so deterministic builds use these polynomial approximations
+        //instead, which only use IEEE add and multiply. Accurate to a few ulps for angles below 8192 radians
+        inline void PhysicsSinCos(float aAngle, float* aSin, float* aCos)
+        {
+#if PHYSICS_DETERMINISTIC
+            //Reduce the angle to [-pi/4, pi/4], and find which quadrant it was in
+            float quadrant = floorf(aAngle * PHYSICS_MATH_TWO_OVER_PI + 0.5f);
+            float x = ((aAngle - quadrant * PHYSICS_MATH_HALF_PI_1) - quadrant * PHYSICS_MATH_HALF_PI_2) - quadrant * PHYSICS_MATH_HALF_PI_3;
+            float x2 = x * x;
+
+            //Minimax polynomials (from Cephes)
+            float s = x + x * x2 * (-1.6666654611e-1f + x2 * (8.3321608736e-3f + x2 * -1.9515295891e-4f));
+            float c = 1.0f - 0.5f * x2 + x2 * x2 * (4.166664568298827e-2f + x2 * (-1.388731625493765e-3f + x2 * 2.443315711809948e-5f));
+
+            switch ((int)quadrant & 3)
+            {
+            case 0:
+                *aSin = s;
+                *aCos = c;
+                break;
+            case 1:
+                *aSin = c;
+                *aCos = -s;
+                break;
+            case 2:
+                *aSin = -s;
+                *aCos = -c;
+                break;
+            default:
+                *aSin = -c;
+                *aCos = s;
+                break;
+            }
+#else
+            *aSin = sinf(aAngle);
+            *aCos = cosf(aAngle);
+#endif
+        }
+    }
+}
+
+#endif
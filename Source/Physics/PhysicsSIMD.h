@@ -0,0 +1,23 @@
+#ifndef __PHYSICS_SIMD_H__
+#define __PHYSICS_SIMD_H__
+
+#include "FrameworkConfig.h"
+
+//Determine which SIMD instruction sets the physics world's batched passes can use, SSE2 is
+//part of every x64 target. If PHYSICS_USE_SIMD is disabled or neither is available, the
+//batched passes fall back to their scalar loops
+#if PHYSICS_USE_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define PHYSICS_SIMD_SSE 1
+    #include <emmintrin.h>
+#else
+    #define PHYSICS_SIMD_SSE 0
+#endif
+
+#if PHYSICS_SIMD_SSE && defined(__AVX__)
+    #define PHYSICS_SIMD_AVX 1
+    #include <immintrin.h>
+#else
+    #define PHYSICS_SIMD_AVX 0
+#endif
+
+#endif
@@ -0,0 +1,142 @@
+#include "PolygonCollider.h"
+#include "PhysicsMath.h"
+#include "../Utils/Math/Math.h"
+
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        PolygonCollider::PolygonCollider(const vec2* aVertices, unsigned int aCount) : Collider(),
+            m_VertexCount(0),
+            m_Area(0.0f),
+            m_SecondMomentOfArea(0.0f)
+        {
+            assert(aCount >= 3 && aCount <= POLYGON_COLLIDER_MAX_VERTICES);
+            aCount = std::min(aCount, POLYGON_COLLIDER_MAX_VERTICES);
+
+            //Find the convex hull with a gift wrap, starting from the right most (then lowest) vertex
+            unsigned int start = 0;
+            for (unsigned int i = 1; i < aCount; i++)
+            {
+                if (aVertices[i].x > aVertices[start].x || (aVertices[i].x == aVertices[start].x && aVertices[i].y < aVertices[start].y))
+                {
+                    start = i;
+                }
+            }
+
+            unsigned int current = start;
+            do
+            {
+                m_Vertices[m_VertexCount++] = aVertices[current];
+
+                //Pick the next vertex so every other vertex is to its left, the furthest one if they're in line
+                unsigned int next = current == 0 ? 1 : 0;
+                for (unsigned int i = 0; i < aCount; i++)
+                {
+                    if (i == current)
+                    {
+                        continue;
+                    }
+
+                    vec2 edge = aVertices[next] - aVertices[current];
+                    vec2 offset = aVertices[i] - aVertices[current];
+                    float cross = edge.x * offset.y - edge.y * offset.x;
+                    if (cross < 0.0f || (cross == 0.0f && Math::Dot(offset, offset) > Math::Dot(edge, edge)))
+                    {
+                        next = i;
+                    }
+                }
+
+                current = next;
+            } while (current != start && m_VertexCount < aCount);
+
+            //Calculate the edge normals, and the area and second moment of area from the triangles fanned out
+            //from the body's position
+            for (unsigned int i = 0; i < m_VertexCount; i++)
+            {
+                vec2 vertex1 = m_Vertices[i];
+                vec2 vertex2 = m_Vertices[i + 1 < m_VertexCount ? i + 1 : 0];
+                vec2 edge = vertex2 - vertex1;
+                m_Normals[i] = Math::Normalize(vec2(edge.y, -edge.x));
+
+                float cross = vertex1.x * vertex2.y - vertex1.y * vertex2.x;
+                m_Area += cross * 0.5f;
+                m_SecondMomentOfArea += cross * (Math::Dot(vertex1, vertex1) + Math::Dot(vertex1, vertex2) + Math::Dot(vertex2, vertex2)) / 12.0f;
+            }
+        }
+
+        ColliderType PolygonCollider::GetType()
+        {
+            return ColliderType_Polygon;
+        }
+
+        float PolygonCollider::ComputeMass(float aDensity)
+        {
+            return aDensity * m_Area;
+        }
+
+        float PolygonCollider::ComputeInertia(float aMass)
+        {
+            //Scale the second moment of area by the density the mass was computed with
+            return m_Area > 0.0f ? aMass * m_SecondMomentOfArea / m_Area : 0.0f;
+        }
+
+        AABB PolygonCollider::ComputeAABB(vec2 aPosition, float aAngleInRadians)
+        {
+            float s = 0.0f;
+            float c = 0.0f;
+            PhysicsSinCos(aAngleInRadians, &s, &c);
+            mat2 orientation = mat2(c, s, -s, c);
+
+            vec2 lower = orientation * m_Vertices[0];
+            vec2 upper = lower;
+            for (unsigned int i = 1; i < m_VertexCount; i++)
+            {
+                vec2 vertex = orientation * m_Vertices[i];
+                lower = glm::min(lower, vertex);
+                upper = glm::max(upper, vertex);
+            }
+
+            return AABB(aPosition + lower, aPosition + upper);
+        }
+
+        unsigned int PolygonCollider::GetVertexCount()
+        {
+            return m_VertexCount;
+        }
+
+        vec2 PolygonCollider::GetVerticesAtIndex(unsigned int aIndex)
+        {
+            if (aIndex < m_VertexCount)
+            {
+                return m_Vertices[aIndex];
+            }
+            return vec2(0.0f, 0.0f);
+        }
+
+        vec2 PolygonCollider::GetNormalsAtIndex(unsigned int aIndex)
+        {
+            if (aIndex < m_VertexCount)
+            {
+                return m_Normals[aIndex];
+            }
+            return vec2(0.0f, 0.0f);
+        }
+
+        float PolygonCollider::GetArea()
+        {
+            return m_Area;
+        }
+
+        float PolygonCollider::GetInnerRadius()
+        {
+            float radius = FLT_MAX;
+            for (unsigned int i = 0; i < m_VertexCount; i++)
+            {
+                radius = std::min(radius, Math::Dot(m_Normals[i], m_Vertices[i]));
+            }
+            return std::max(radius, 0.0f);
+        }
+    }
+}
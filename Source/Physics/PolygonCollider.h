@@ -0,0 +1,55 @@
+#ifndef __POLYGON_COLLIDER_H__
+#define __POLYGON_COLLIDER_H__
+
+#include "Collider.h"
+#include "GJK.h"
+
+
+using namespace glm;
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //Local constant
+        const unsigned int POLYGON_COLLIDER_MAX_VERTICES = CONVEX_SHAPE_MAX_VERTICES;
+
+        //A convex polygon, of up to POLYGON_COLLIDER_MAX_VERTICES vertices (in meters), relative to the body's
+        //position. The convex hull of the vertices is used, wound counter-clockwise, so they can be passed in any
+        //order. The body rotates around its position, so the vertices should be centered on it
+        class PolygonCollider : public Collider
+        {
+        public:
+            PolygonCollider(const vec2* vertices, unsigned int count);
+
+            ColliderType GetType();
+
+            float ComputeMass(float density);
+            float ComputeInertia(float mass);
+
+            AABB ComputeAABB(vec2 position, float angleInRadians);
+
+            unsigned int GetVertexCount();
+            vec2 GetVerticesAtIndex(unsigned int index);
+            vec2 GetNormalsAtIndex(unsigned int index);
+
+            //Returns the polygon's area (in square meters)
+            float GetArea();
+
+            //Returns the distance from the body's position to the closest edge, the radius of the largest
+            //circle around the body's position that fits inside the polygon
+            float GetInnerRadius();
+
+        private:
+            //Member variables
+            vec2 m_Vertices[POLYGON_COLLIDER_MAX_VERTICES];
+            vec2 m_Normals[POLYGON_COLLIDER_MAX_VERTICES];
+            unsigned int m_VertexCount;
+            float m_Area;
+            float m_SecondMomentOfArea;     //About the body's position, per unit of density
+        };
+    }
+}
+
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef __RADIAL_IMPULSE_H__
+#define __RADIAL_IMPULSE_H__
+
+
+using namespace glm;
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //Forward declaration
+        class Body;
+
+        //How a radial impulse weakens with the distance from its center to a body's collider
+        enum RadialFalloff
+        {
+            RadialFalloff_None = 0,     //Full strength out to the radius
+            RadialFalloff_Linear,       //Full strength at the center, none at the radius
+            RadialFalloff_Quadratic     //Weakens faster than linear, (1 - distance / radius) squared
+        };
+
+        //A radial impulse (an explosion) queued by World::ApplyRadialImpulse()
+        struct RadialImpulse
+        {
+            RadialImpulse()
+            {
+                this->center = vec2(0.0f, 0.0f);
+                this->radius = 0.0f;
+                this->strength = 0.0f;
+                this->falloff = RadialFalloff_None;
+            }
+
+            //Member variables
+            vec2 center;            //In meters
+            float radius;           //In meters
+            float strength;         //In kg m/s, the impulse at full strength
+            RadialFalloff falloff;
+        };
+
+        //A body inside a radial impulse's radius, collected by the World when the queued impulses are applied
+        struct RadialImpulseHit
+        {
+            RadialImpulseHit()
+            {
+                this->body = nullptr;
+                this->impulseIndex = 0;
+                this->impulse = vec2(0.0f, 0.0f);
+                this->distance = 0.0f;
+            }
+
+            //Member variables
+            Body* body;
+            unsigned int impulseIndex;  //The order the impulse was queued in, since the last step
+            vec2 impulse;               //In kg m/s, the impulse applied to the body's center, 0 for static bodies
+            float distance;             //In meters, from the impulse's center to the body's collider
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef __RAY_CAST_H__
+#define __RAY_CAST_H__
+
+
+using namespace glm;
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //Forward declaration
+        class Body;
+
+        //A ray, from point1 to point2 (in meters)
+        struct RayCastInput
+        {
+            RayCastInput()
+            {
+                this->point1 = vec2(0.0f, 0.0f);
+                this->point2 = vec2(0.0f, 0.0f);
+            }
+
+            RayCastInput(vec2 point1, vec2 point2)
+            {
+                this->point1 = point1;
+                this->point2 = point2;
+            }
+
+            //Member variables
+            vec2 point1;
+            vec2 point2;
+        };
+
+        //The closest body a ray hit, body is null if the ray didn't hit anything
+        struct RayCastResult
+        {
+            RayCastResult()
+            {
+                this->body = nullptr;
+                this->point = vec2(0.0f, 0.0f);
+                this->normal = vec2(0.0f, 0.0f);
+                this->fraction = 1.0f;
+            }
+
+            //Member variables
+            Body* body;
+            vec2 point;         //In meters, where the ray hit the body
+            vec2 normal;        //The body's surface normal at the hit point
+            float fraction;     //How far along the ray (0 to 1) the hit point is
+        };
+    }
+}
+
+#endif
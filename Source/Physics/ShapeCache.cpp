@@ -0,0 +1,100 @@
+#include "ShapeCache.h"
+#include "BodyStorage.h"
+#include "CircleCollider.h"
+#include "BoxCollider.h"
+#include "PolygonCollider.h"
+#include "PhysicsMath.h"
+
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        ShapeCache::ShapeCache()
+        {
+
+        }
+
+        void ShapeCache::Update(BodyStorage& aStorage)
+        {
+            unsigned int count = aStorage.GetCount();
+            sine.resize(count);
+            cosine.resize(count);
+            aabb.resize(count);
+            type.resize(count);
+            radius.resize(count);
+            vertexStart.resize(count);
+            vertexCount.resize(count);
+            vertices.clear();
+            normals.clear();
+
+            for (unsigned int i = 0; i < count; i++)
+            {
+                vertexStart[i] = vertices.size();
+                vertexCount[i] = 0;
+
+                //Skip the free slots of destroyed bodies
+                if ((aStorage.flags[i] & BodyFlag_Free) != 0)
+                {
+                    sine[i] = 0.0f;
+                    cosine[i] = 1.0f;
+                    aabb[i] = AABB();
+                    type[i] = ColliderType_Count;
+                    radius[i] = 0.0f;
+                    continue;
+                }
+
+                float s = 0.0f;
+                float c = 0.0f;
+                PhysicsSinCos(aStorage.angle[i], &s, &c);
+                sine[i] = s;
+                cosine[i] = c;
+
+                vec2 position = vec2(aStorage.positionX[i], aStorage.positionY[i]);
+                mat2 orientation = mat2(c, s, -s, c);
+                Collider* collider = aStorage.collider[i];
+                type[i] = collider->GetType();
+                radius[i] = 0.0f;
+
+                if (type[i] == ColliderType_Circle)
+                {
+                    radius[i] = ((CircleCollider*)collider)->GetRadius();
+                    vec2 extents = vec2(radius[i], radius[i]);
+                    aabb[i] = AABB(position - extents, position + extents);
+                    continue;
+                }
+
+                if (type[i] == ColliderType_Box)
+                {
+                    BoxCollider* boxCollider = (BoxCollider*)collider;
+                    for (unsigned int j = 0; j < BOX_COLLIDER_VERTEX_COUNT; j++)
+                    {
+                        vertices.push_back(position + orientation * boxCollider->GetVerticesAtIndex(j));
+                        normals.push_back(orientation * boxCollider->GetNormalsAtIndex(j));
+                    }
+                    vertexCount[i] = BOX_COLLIDER_VERTEX_COUNT;
+                }
+                else if (type[i] == ColliderType_Polygon)
+                {
+                    PolygonCollider* polygonCollider = (PolygonCollider*)collider;
+                    for (unsigned int j = 0; j < polygonCollider->GetVertexCount(); j++)
+                    {
+                        vertices.push_back(position + orientation * polygonCollider->GetVerticesAtIndex(j));
+                        normals.push_back(orientation * polygonCollider->GetNormalsAtIndex(j));
+                    }
+                    vertexCount[i] = polygonCollider->GetVertexCount();
+                }
+
+                //The AABB of a box or polygon bounds its world space vertices
+                vec2 lower = vertices[vertexStart[i]];
+                vec2 upper = lower;
+                for (unsigned int j = 1; j < vertexCount[i]; j++)
+                {
+                    lower = glm::min(lower, vertices[vertexStart[i] + j]);
+                    upper = glm::max(upper, vertices[vertexStart[i] + j]);
+                }
+                aabb[i] = AABB(lower, upper);
+            }
+        }
+    }
+}
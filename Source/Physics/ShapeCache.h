@@ -0,0 +1,50 @@
+#ifndef __SHAPE_CACHE_H__
+#define __SHAPE_CACHE_H__
+
+#include "AABB.h"
+#include "Collider.h"
+
+
+using namespace std;
+using namespace glm;
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //Forward declaration
+        struct BodyStorage;
+
+        //Structure of arrays holding each body's collider in world space, indexed the same as the
+        //BodyStorage. The World fills it once per step, before the broadphase, so the trig and the
+        //vertex transforms are done once per body, instead of once for every pair the body is in
+        struct ShapeCache
+        {
+            ShapeCache();
+
+            //Computes the rotation, AABB and the box or polygon vertices and normals of every body,
+            //at the body's current position and angle. Free slots get an empty AABB and no vertices.
+            //The collider's type and radius are copied too, so the narrowphase doesn't need the collider
+            void Update(BodyStorage& storage);
+
+            //Returns the body's rotation matrix
+            mat2 GetOrientation(unsigned int index) const
+            {
+                return mat2(cosine[index], sine[index], -sine[index], cosine[index]);
+            }
+
+            //Member variables
+            vector<float> sine;                 //Of the body's angle
+            vector<float> cosine;
+            vector<AABB> aabb;                  //In meters
+            vector<ColliderType> type;
+            vector<float> radius;               //In meters, the circle's radius, 0 for boxes and polygons
+            vector<unsigned int> vertexStart;   //Index of the body's first vertex and normal
+            vector<unsigned int> vertexCount;   //0 for circles
+            vector<vec2> vertices;              //In meters, counter clockwise, for every box and polygon, back to back
+            vector<vec2> normals;               //Of the face starting at the same vertex
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,202 @@
+#include "SpatialHash.h"
+#include "Body.h"
+
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        SpatialHash::SpatialHash(float aCellSize) : BroadPhase("Physics::SpatialHash"),
+            m_CellSize(0.0f),
+            m_InverseCellSize(0.0f),
+            m_BucketMask(0)
+        {
+            SetCellSize(aCellSize);
+        }
+
+        SpatialHash::~SpatialHash()
+        {
+
+        }
+
+        void SpatialHash::Update(const vector<Body*>& aBodies, const vector<AABB>& aAABBs)
+        {
+            m_AABBs.resize(aBodies.size());
+            m_CellRanges.resize(aBodies.size());
+            m_Entries.clear();
+
+            //Insert each body's AABB into every cell it overlaps
+            for (unsigned int i = 0; i < aBodies.size(); i++)
+            {
+                //Skip the free slots of destroyed bodies
+                if (aBodies.at(i) == nullptr)
+                {
+                    continue;
+                }
+
+                AABB aabb = aAABBs.at(i);
+                m_AABBs.at(i) = aabb;
+
+                CellRange range;
+                range.minX = (int)floorf(aabb.lowerBound.x * m_InverseCellSize);
+                range.minY = (int)floorf(aabb.lowerBound.y * m_InverseCellSize);
+                range.maxX = (int)floorf(aabb.upperBound.x * m_InverseCellSize);
+                range.maxY = (int)floorf(aabb.upperBound.y * m_InverseCellSize);
+                m_CellRanges.at(i) = range;
+
+                for (int y = range.minY; y <= range.maxY; y++)
+                {
+                    for (int x = range.minX; x <= range.maxX; x++)
+                    {
+                        CellEntry entry;
+                        entry.cellX = x;
+                        entry.cellY = y;
+                        entry.index = i;
+                        m_Entries.push_back(entry);
+                    }
+                }
+            }
+
+            //Size the bucket table to the next power of two, at least twice the entry count
+            unsigned int bucketCount = 16;
+            while (bucketCount < m_Entries.size() * 2)
+            {
+                bucketCount <<= 1;
+            }
+            m_BucketMask = bucketCount - 1;
+
+            //Counting sort the entries into their buckets, this is stable so the
+            //entries in each bucket stay in ascending body index order
+            m_BucketStart.assign(bucketCount + 1, 0);
+            for (unsigned int i = 0; i < m_Entries.size(); i++)
+            {
+                m_BucketStart.at(HashCell(m_Entries.at(i).cellX, m_Entries.at(i).cellY) + 1)++;
+            }
+
+            for (unsigned int i = 0; i < bucketCount; i++)
+            {
+                m_BucketStart.at(i + 1) += m_BucketStart.at(i);
+            }
+
+            m_SortedEntries.resize(m_Entries.size());
+            for (unsigned int i = 0; i < m_Entries.size(); i++)
+            {
+                unsigned int bucket = HashCell(m_Entries.at(i).cellX, m_Entries.at(i).cellY);
+                m_SortedEntries.at(m_BucketStart.at(bucket)++) = m_Entries.at(i);
+            }
+
+            //Shift the bucket starts back, the scatter above advanced them to the bucket ends
+            for (unsigned int i = bucketCount; i > 0; i--)
+            {
+                m_BucketStart.at(i) = m_BucketStart.at(i - 1);
+            }
+            m_BucketStart.at(0) = 0;
+        }
+
+        void SpatialHash::FindPairs(const vector<Body*>& aBodies, const vector<AABB>& aAABBs, vector<BroadPhasePair>& aPairs)
+        {
+            aPairs.clear();
+
+            //Rebuild the bucket table
+            Update(aBodies, aAABBs);
+            unsigned int bucketCount = m_BucketMask + 1;
+
+            //Test the bodies that share a bucket against each other
+            for (unsigned int bucket = 0; bucket < bucketCount; bucket++)
+            {
+                unsigned int start = m_BucketStart.at(bucket);
+                unsigned int end = m_BucketStart.at(bucket + 1);
+
+                for (unsigned int i = start; i < end; i++)
+                {
+                    const CellEntry& a = m_SortedEntries.at(i);
+
+                    for (unsigned int j = i + 1; j < end; j++)
+                    {
+                        const CellEntry& b = m_SortedEntries.at(j);
+
+                        //Different cells can hash into the same bucket
+                        if (a.cellX != b.cellX || a.cellY != b.cellY || a.index == b.index)
+                        {
+                            continue;
+                        }
+
+                        //Bodies that span several cells share more than one cell, only report
+                        //the pair from the lowest cell they share so each pair is reported once
+                        const CellRange& rangeA = m_CellRanges.at(a.index);
+                        const CellRange& rangeB = m_CellRanges.at(b.index);
+                        if (a.cellX != std::max(rangeA.minX, rangeB.minX) || a.cellY != std::max(rangeA.minY, rangeB.minY))
+                        {
+                            continue;
+                        }
+
+                        //Skip the pairs whose collision filters don't let them collide
+                        if (m_AABBs.at(a.index).Overlaps(m_AABBs.at(b.index)) == true && aBodies.at(a.index)->ShouldCollide(aBodies.at(b.index)) == true)
+                        {
+                            aPairs.push_back(BroadPhasePair(std::min(a.index, b.index), std::max(a.index, b.index)));
+                        }
+                    }
+                }
+            }
+
+            //Sort the pairs so the narrowphase order doesn't depend on the hash layout
+            SortPairs(aPairs);
+        }
+
+        void SpatialHash::Query(const AABB& aAABB, vector<unsigned int>& aBodies)
+        {
+            aBodies.clear();
+
+            //Safety check, FindPairs() hasn't been called yet
+            if (m_BucketStart.empty() == true)
+            {
+                return;
+            }
+
+            int minX = (int)floorf(aAABB.lowerBound.x * m_InverseCellSize);
+            int minY = (int)floorf(aAABB.lowerBound.y * m_InverseCellSize);
+            int maxX = (int)floorf(aAABB.upperBound.x * m_InverseCellSize);
+            int maxY = (int)floorf(aAABB.upperBound.y * m_InverseCellSize);
+
+            for (int y = minY; y <= maxY; y++)
+            {
+                for (int x = minX; x <= maxX; x++)
+                {
+                    unsigned int bucket = HashCell(x, y);
+
+                    for (unsigned int i = m_BucketStart.at(bucket); i < m_BucketStart.at(bucket + 1); i++)
+                    {
+                        const CellEntry& entry = m_SortedEntries.at(i);
+
+                        if (entry.cellX == x && entry.cellY == y && m_AABBs.at(entry.index).Overlaps(aAABB) == true)
+                        {
+                            aBodies.push_back(entry.index);
+                        }
+                    }
+                }
+            }
+
+            //Bodies that span several cells are found more than once
+            std::sort(aBodies.begin(), aBodies.end());
+            aBodies.erase(std::unique(aBodies.begin(), aBodies.end()), aBodies.end());
+        }
+
+        void SpatialHash::SetCellSize(float aCellSize)
+        {
+            assert(aCellSize > 0.0f);
+            m_CellSize = aCellSize;
+            m_InverseCellSize = 1.0f / m_CellSize;
+        }
+
+        float SpatialHash::GetCellSize()
+        {
+            return m_CellSize;
+        }
+
+        unsigned int SpatialHash::HashCell(int aCellX, int aCellY)
+        {
+            unsigned int hash = ((unsigned int)aCellX * 73856093u) ^ ((unsigned int)aCellY * 19349663u);
+            return hash & m_BucketMask;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef __SPATIAL_HASH_H__
+#define __SPATIAL_HASH_H__
+
+#include "BroadPhase.h"
+#include "AABB.h"
+
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //Local constants
+        const float SPATIAL_HASH_DEFAULT_CELL_SIZE = 2.0f; //In meters
+
+        //Uniform grid broadphase, each body's AABB is inserted into every cell it
+        //touches, the cells are hashed into a bucket table that is rebuilt each step.
+        //Only bodies that share a cell are tested against each other, so the cost
+        //scales with the number of bodies rather than the number of body pairs
+        class SpatialHash : public BroadPhase
+        {
+        public:
+            SpatialHash(float cellSize = SPATIAL_HASH_DEFAULT_CELL_SIZE);
+            ~SpatialHash();
+
+            void Update(const vector<Body*>& bodies, const vector<AABB>& aabbs);
+            void FindPairs(const vector<Body*>& bodies, const vector<AABB>& aabbs, vector<BroadPhasePair>& pairs);
+            void Query(const AABB& aabb, vector<unsigned int>& bodies);
+
+            //The cell size should be roughly the size of the most common body
+            void SetCellSize(float cellSize);
+            float GetCellSize();
+
+        private:
+            //A body's AABB overlaps a cell
+            struct CellEntry
+            {
+                int cellX;
+                int cellY;
+                unsigned int index;
+            };
+
+            //The range of cells a body's AABB overlaps
+            struct CellRange
+            {
+                int minX;
+                int minY;
+                int maxX;
+                int maxY;
+            };
+
+            //Conveniance method to hash cell coordinates into the bucket table
+            unsigned int HashCell(int cellX, int cellY);
+
+            //Member variables
+            float m_CellSize;
+            float m_InverseCellSize;
+            unsigned int m_BucketMask;
+            vector<AABB> m_AABBs;
+            vector<CellRange> m_CellRanges;
+            vector<CellEntry> m_Entries;
+            vector<CellEntry> m_SortedEntries;
+            vector<unsigned int> m_BucketStart;
+        };
+    }
+}
+
+#endif
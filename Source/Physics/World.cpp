@@ -2,330 +2,2488 @@
 #include "Body.h"
 #include "CircleCollider.h"
 #include "BoxCollider.h"
+#include "PolygonCollider.h"
+#include "SpatialHash.h"
+#include "DynamicTreeBroadPhase.h"
+#include "PhysicsMath.h"
 #include "../Utils/Math/Math.h"
+#include "../Utils/ThreadPool/ThreadPool.h"
+#include "../Services/Random/Random.h"
 #include "../../Game/GameObject.h"
-#include "../../Game/Polygon.h"
+#include "../Graphics/Core/DebugLineRenderer.h"
 
 
 namespace GameDev2D
 {
     namespace Physics
     {
-        World* World::s_Instance = nullptr;
+        //Spreads the low 16 bits of the value out to the even bits, used to build Morton keys
+        static unsigned int SpreadBits(unsigned int aValue)
+        {
+            aValue = (aValue | (aValue << 8)) & 0x00ff00ff;
+            aValue = (aValue | (aValue << 4)) & 0x0f0f0f0f;
+            aValue = (aValue | (aValue << 2)) & 0x33333333;
+            aValue = (aValue | (aValue << 1)) & 0x55555555;
+            return aValue;
+        }
 
-        World* World::GetInstance()
+        //A box's or polygon's vertices and normals in world space, pointing into the World's shape cache
+        struct WorldPolygon
         {
-            if (s_Instance == nullptr)
-            {
-                s_Instance = new World();
-            }
-            return s_Instance;
+            const vec2* vertices;
+            const vec2* normals;
+            unsigned int count;
+        };
+
+        //Gets the body's box or polygon from the shape cache
+        static void GetWorldPolygon(const ShapeCache& aShapeCache, unsigned int aIndex, WorldPolygon* aWorldPolygon)
+        {
+            aWorldPolygon->vertices = &aShapeCache.vertices[aShapeCache.vertexStart[aIndex]];
+            aWorldPolygon->normals = &aShapeCache.normals[aShapeCache.vertexStart[aIndex]];
+            aWorldPolygon->count = aShapeCache.vertexCount[aIndex];
         }
 
         World::World() : BaseObject("Physics::World"),
             m_Gravity(0.0f, 0.0f),
-            m_Listener(nullptr)
+            m_FixedTimeStep(WORLD_DEFAULT_FIXED_TIME_STEP),
+            m_Accumulator(0.0),
+            m_MaxSubSteps(WORLD_DEFAULT_MAX_SUB_STEPS),
+            m_BroadPhaseType(BroadPhaseType_SpatialHash),
+            m_BroadPhase(nullptr),
+            m_SpatialHash(nullptr),
+            m_DynamicTree(nullptr),
+            m_ThreadPool(nullptr),
+            m_IsBroadPhaseDirty(true),
+            m_SleepingEnabled(true),
+            m_ChecksumEnabled(false),
+            m_Checksum(0),
+            m_StepCount(0),
+            m_Listener(nullptr),
+            m_Random(nullptr),
+            m_DebugLineRenderer(nullptr)
         {
+            m_SpatialHash = new SpatialHash();
+            m_DynamicTree = new DynamicTreeBroadPhase();
+            m_BroadPhase = m_SpatialHash;
+
+            //Build the collision dispatch table
+            for (unsigned int i = 0; i < ColliderType_Count; i++)
+            {
+                for (unsigned int j = 0; j < ColliderType_Count; j++)
+                {
+                    m_CollisionHandlers[i][j].check = nullptr;
+                    m_CollisionHandlers[i][j].flip = false;
+                }
+            }
 
+            RegisterCollisionCheck(ColliderType_Circle, ColliderType_Circle, &World::CheckCircleToCircle);
+            RegisterCollisionCheck(ColliderType_Circle, ColliderType_Box, &World::CheckCircleToBox);
+            RegisterCollisionCheck(ColliderType_Box, ColliderType_Box, &World::CheckBoxToBox);
+            RegisterCollisionCheck(ColliderType_Circle, ColliderType_Polygon, &World::CheckCircleToPolygon);
+            RegisterCollisionCheck(ColliderType_Box, ColliderType_Polygon, &World::CheckPolygonToPolygon);
+            RegisterCollisionCheck(ColliderType_Polygon, ColliderType_Polygon, &World::CheckPolygonToPolygon);
         }
 
         World::~World()
         {
             for (unsigned int i = 0; i < m_Bodies.size(); i++)
             {
-                delete m_Bodies.at(i);
+                m_BodyPool.Destroy(m_Bodies.at(i));
             }
             m_Bodies.clear();
+
+            m_BroadPhase = nullptr;
+            SafeDelete(m_SpatialHash);
+            m_ContactSolver.SetThreadPool(nullptr);
+            SafeDelete(m_ThreadPool);
+            SafeDelete(m_DynamicTree);
+
+#if DEBUG && DRAW_DEBUG_PHYSICS_WORLD
+            SafeDelete(m_DebugLineRenderer);
+#endif
         }
 
         void World::Step(double aTimeStep)
         {
+            m_BeginContactEvents.clear();
+            m_PersistContactEvents.clear();
+            m_EndContactEvents.clear();
+            m_RadialImpulseHits.clear();
+
+            Simulate(aTimeStep);
+            SyncGameObjects(1.0f);
+        }
+
+        void World::Update(double aDelta)
+        {
+            m_BeginContactEvents.clear();
+            m_PersistContactEvents.clear();
+            m_EndContactEvents.clear();
+            m_RadialImpulseHits.clear();
+
+            m_Accumulator += aDelta;
+
+            //Save the forces so that every sub-step applies them, the integration clears them
+            if (m_Accumulator >= m_FixedTimeStep * 2.0)
+            {
+                m_SubStepForceX = m_BodyStorage.forceX;
+                m_SubStepForceY = m_BodyStorage.forceY;
+                m_SubStepTorque = m_BodyStorage.torque;
+            }
+
+            unsigned int subSteps = 0;
+            while (m_Accumulator >= m_FixedTimeStep && subSteps < m_MaxSubSteps)
+            {
+                if (subSteps > 0)
+                {
+                    std::copy(m_SubStepForceX.begin(), m_SubStepForceX.end(), m_BodyStorage.forceX.begin());
+                    std::copy(m_SubStepForceY.begin(), m_SubStepForceY.end(), m_BodyStorage.forceY.begin());
+                    std::copy(m_SubStepTorque.begin(), m_SubStepTorque.end(), m_BodyStorage.torque.begin());
+                }
+
+                Simulate(m_FixedTimeStep);
+                m_Accumulator -= m_FixedTimeStep;
+                subSteps++;
+            }
+
+            //Drop the whole steps that didn't fit, to avoid a spiral of death
+            if (m_Accumulator >= m_FixedTimeStep)
+            {
+                m_Accumulator = fmod(m_Accumulator, m_FixedTimeStep);
+            }
+
+            //Forces only act on the steps of the frame they were applied in, on a frame without a step
+            //they are dropped, otherwise they would pile up and act twice as hard on the next step
+            if (subSteps == 0)
+            {
+                std::fill(m_BodyStorage.forceX.begin(), m_BodyStorage.forceX.end(), 0.0f);
+                std::fill(m_BodyStorage.forceY.begin(), m_BodyStorage.forceY.end(), 0.0f);
+                std::fill(m_BodyStorage.torque.begin(), m_BodyStorage.torque.end(), 0.0f);
+            }
+
+            SyncGameObjects(GetInterpolationAlpha());
+        }
+
+        void World::SetFixedTimeStep(double aFixedTimeStep)
+        {
+            assert(aFixedTimeStep > 0.0);
+            m_FixedTimeStep = aFixedTimeStep;
+        }
+
+        double World::GetFixedTimeStep()
+        {
+            return m_FixedTimeStep;
+        }
+
+        void World::SetMaxSubSteps(unsigned int aMaxSubSteps)
+        {
+            m_MaxSubSteps = aMaxSubSteps;
+        }
+
+        unsigned int World::GetMaxSubSteps()
+        {
+            return m_MaxSubSteps;
+        }
+
+        float World::GetInterpolationAlpha()
+        {
+            return (float)(m_Accumulator / m_FixedTimeStep);
+        }
+
+        void World::Simulate(double aTimeStep)
+        {
+            //The step always runs in the same order, and every pass walks the bodies in index order
+            //and the pairs and contacts in sorted pair order, whichever broadphase and thread count
+            //are used, so the same input produces the same result:
+            // broadphase -> narrowphase -> listener callbacks -> velocity solver -> position solver
+            // -> bullet time of impact -> sleeping -> checksum
             //Clear the contacts
             m_Contacts.clear();
 
-            //Check Collision
-            for (unsigned int i = 0; i < m_Bodies.size(); i++)
+            //Save the transforms, to interpolate from
+            m_BodyStorage.StoreTransforms();
+
+            //Record the bullets' positions at the start of the step
+            m_BulletSweeps.clear();
+            for (unsigned int i = 0; i < m_BodyStorage.GetCount(); i++)
+            {
+                if ((m_BodyStorage.flags[i] & (BodyFlag_Bullet | BodyFlag_Sensor)) == BodyFlag_Bullet)
+                {
+                    BulletSweep sweep;
+                    sweep.index = i;
+                    sweep.start = vec2(m_BodyStorage.positionX[i], m_BodyStorage.positionY[i]);
+                    m_BulletSweeps.push_back(sweep);
+                }
+            }
+
+            //Transform the colliders into world space, once per body, the broadphase and narrowphase read them from the cache
+            m_ShapeCache.Update(m_BodyStorage);
+
+            //Use the broadphase to find the body pairs whose AABBs overlap, then add the pairs of the sensors
+            UpdateSensorLayer();
+            m_BroadPhase->FindPairs(m_SensorIndices.empty() == true ? m_Bodies : m_BroadPhaseBodies, m_ShapeCache.aabb, m_Pairs);
+            FindSensorPairs();
+
+            //Apply the radial impulses queued since the last step, the broadphase was just updated. The bodies
+            //they wake up are woken before the narrowphase, so their contacts are solved this step
+            if (m_RadialImpulses.empty() == false)
+            {
+                ApplyRadialImpulses();
+            }
+
+            //Run the narrowphase, the pairs are split into contiguous ranges, one per task, and each
+            //task writes the manifolds it finds into its own buffer
+            unsigned int taskCount = 1;
+            if (m_ThreadPool != nullptr)
+            {
+                taskCount = std::min(m_ThreadPool->GetThreadCount(), (unsigned int)(m_Pairs.size() / WORLD_MIN_PAIRS_PER_TASK));
+                taskCount = std::max(taskCount, 1u);
+            }
+
+            if (m_TaskContacts.size() < taskCount)
+            {
+                m_TaskContacts.resize(taskCount);
+                m_TaskSimplices.resize(taskCount);
+                m_TaskCircleBatches.resize(taskCount);
+            }
+
+            function<void(unsigned int)> narrowphaseTask = [this, taskCount](unsigned int aTaskIndex)
+            {
+                unsigned int begin = (unsigned int)((unsigned long long)m_Pairs.size() * aTaskIndex / taskCount);
+                unsigned int end = (unsigned int)((unsigned long long)m_Pairs.size() * (aTaskIndex + 1) / taskCount);
+                CollidePairs(begin, end, m_TaskContacts.at(aTaskIndex), m_TaskSimplices.at(aTaskIndex), m_TaskCircleBatches.at(aTaskIndex));
+            };
+
+            if (m_ThreadPool != nullptr)
+            {
+                m_ThreadPool->Run(taskCount, narrowphaseTask);
+            }
+            else
+            {
+                narrowphaseTask(0);
+            }
+
+            //Merge the buffers in task order, so the contacts (and the listener callbacks) are in
+            //pair order no matter how many threads were used
+            std::swap(m_PreviousTouchingPairs, m_TouchingPairs);
+            m_TouchingPairs.clear();
+
+            //The tasks' simplices are in pair order too, so the merged cache stays sorted
+            m_SimplexCache.clear();
+            for (unsigned int i = 0; i < taskCount; i++)
             {
-                for (unsigned int j = i + 1; j < m_Bodies.size(); j++)
+                m_SimplexCache.insert(m_SimplexCache.end(), m_TaskSimplices.at(i).begin(), m_TaskSimplices.at(i).end());
+            }
+
+            for (unsigned int i = 0; i < taskCount; i++)
+            {
+                vector<Manifold>& taskContacts = m_TaskContacts.at(i);
+
+                for (unsigned int j = 0; j < taskContacts.size(); j++)
                 {
-                    Body* a = m_Bodies.at(i);
-                    Body* b = m_Bodies.at(j);
+                    Manifold& manifold = taskContacts.at(j);
+                    Body* a = manifold.GetBodyA();
+                    Body* b = manifold.GetBodyB();
 
-                    if (a->GetInverseMass() == 0.0f || b->GetInverseMass() == 0.0f)
+                    //Record the contact's begin or persist event, whether or not it gets a collision response
+                    AddContactEvent(&manifold);
+
+                    //Sensors only report the overlap, they don't wake the bodies they touch or get solved
+                    if (((m_BodyStorage.flags[a->GetIndex()] | m_BodyStorage.flags[b->GetIndex()]) & BodyFlag_Sensor) != 0)
                     {
                         continue;
                     }
 
-                    //Initilaize a Manifold object
-                    Manifold manifold(a, b);
-
-                    //Check the collision
-                    if (CheckCollision(a, b, &manifold) == true)
+                    //There was a collision notify the listener
+                    bool handleCollision = true;
+                    if (m_Listener != nullptr)
                     {
-                        //There was a collision notify the listener
-                        if (m_Listener != nullptr)
-                        {
-                            //If the collisionCallback method returns true, then
-                            //add the manifold to the contacts vector
-                            if (m_Listener->CollisionCallback(a, b) == true)
-                            {
-                                m_Contacts.push_back(manifold);
-                            }
-                        }
-                        else
-                        {
-                            //If there is no listener set then we assume we add all
-                            //contacts
-                            m_Contacts.push_back(manifold);
-                        }
+                        //If the collisionCallback method returns true, then
+                        //add the manifold to the contacts vector
+                        handleCollision = m_Listener->CollisionCallback(a, b);
+                    }
 
+                    //If there is no listener set then we assume we add all
+                    //contacts
+                    if (handleCollision == true)
+                    {
+                        //An awake body touching a sleeping body wakes it up
+                        m_BodyStorage.Wake(a->GetIndex());
+                        m_BodyStorage.Wake(b->GetIndex());
+                        m_Contacts.push_back(manifold);
                     }
                 }
             }
 
-            //
-            for (unsigned int i = 0; i < m_Bodies.size(); i++)
+            //The pairs that were touching but aren't anymore have ended
+            CollectEndContactEvents();
+
+            if (m_Contacts.empty() == true)
             {
-                m_Bodies.at(i)->SyncForces(aTimeStep, m_Gravity);
+                //Nothing to solve, integrate the forces and velocities of every body in a single pass, this also clears the forces
+                m_BodyStorage.Integrate((float)aTimeStep, m_Gravity);
             }
-
-            //Correct overlap before the sync velocities
-            for (unsigned int i = 0; i < m_Contacts.size(); i++)
+            else
             {
-                m_Contacts.at(i).CorrectOverlap();
+                //Warm start the contacts that persisted from the previous step
+                m_ContactSolver.LoadCachedImpulses(m_Contacts);
+
+                //Integrate the forces into the velocities, this also clears the forces
+                m_BodyStorage.IntegrateVelocities((float)aTimeStep, m_Gravity);
+
+                //Solve the velocity constraints
+                m_ContactSolver.Initialize(m_Contacts, &m_BodyStorage);
+                m_ContactSolver.SolveVelocityConstraints();
+
+                //Integrate the velocities into the positions
+                m_BodyStorage.IntegratePositions((float)aTimeStep);
+
+                //Correct the remaining overlap
+                for (unsigned int i = 0; i < m_ContactSolver.GetPositionIterations(); i++)
+                {
+                    if (m_ContactSolver.SolvePositionConstraints() == true)
+                    {
+                        break;
+                    }
+                }
             }
 
-            //
-            for (unsigned int i = 0; i < m_Bodies.size(); i++)
+            //Cache the impulses to warm start the next step
+            m_ContactSolver.StoreImpulses(m_Contacts);
+
+            //Stop the bullets from tunnelling through the other bodies
+            SolveTimeOfImpact();
+
+            //Put the islands that have come to rest to sleep
+            UpdateSleeping((float)aTimeStep);
+
+            //The bodies have moved since the broadphase was updated
+            m_IsBroadPhaseDirty = true;
+
+            m_StepCount++;
+            if (m_ChecksumEnabled == true)
             {
-                m_Bodies.at(i)->SyncVelocities(aTimeStep);
+                m_Checksum = ComputeChecksum();
             }
+        }
 
-            //
-            for (unsigned int i = 0; i < m_Bodies.size(); i++)
+        void World::SyncGameObjects(float aAlpha)
+        {
+            //Sync the GameObjects attached to the physics bodies, sleeping bodies were synced when they fell asleep
+            for (unsigned int i = 0; i < m_BodyStorage.GetCount(); i++)
             {
-                m_Bodies.at(i)->ClearForces();
+                if (m_BodyStorage.IsSleeping(i) == false)
+                {
+                    SyncGameObject(i, aAlpha);
+                }
             }
+        }
 
-            //
-            for (unsigned int i = 0; i < m_Bodies.size(); i++)
+        void World::SyncGameObject(unsigned int aIndex, float aAlpha)
+        {
+            //Get the GameObject attached to the physics body
+            GameObject* gameObject = m_BodyStorage.gameObject[aIndex];
+
+            //Safety check
+            if (gameObject != nullptr)
             {
-                //Get the GameObject attached to the physics body
-                GameObject* gameObject = m_Bodies.at(i)->GetGameObject();
+                vec2 previousPosition = vec2(m_BodyStorage.previousPositionX[aIndex], m_BodyStorage.previousPositionY[aIndex]);
+                vec2 position = vec2(m_BodyStorage.positionX[aIndex], m_BodyStorage.positionY[aIndex]);
+                float angle = m_BodyStorage.previousAngle[aIndex] * (1.0f - aAlpha) + m_BodyStorage.angle[aIndex] * aAlpha;
 
-                //Safety check
-                if (gameObject != nullptr)
-                {
-                    gameObject->SetPosition(Math::MetersToPixels(m_Bodies.at(i)->GetPosition()));
-                    gameObject->SetAngle(Math::RadiansToDegrees(m_Bodies.at(i)->GetAngle()));
-                }
+                gameObject->SetPosition(Math::MetersToPixels(previousPosition * (1.0f - aAlpha) + position * aAlpha));
+                gameObject->SetAngle(Math::RadiansToDegrees(angle));
             }
         }
 
         void World::DebugDraw()
         {
 #if DEBUG && DRAW_DEBUG_PHYSICS_WORLD
-            Polygon p;
+            if (m_DebugLineRenderer == nullptr)
+            {
+                m_DebugLineRenderer = new DebugLineRenderer();
+            }
+
+            //The bodies' AABBs, drawn first so the colliders are drawn over them
+            for (unsigned int i = 0; i < m_Bodies.size(); i++)
+            {
+                Body* body = m_Bodies.at(i);
+                if (body != nullptr)
+                {
+                    AABB aabb = body->ComputeAABB();
+                    m_DebugLineRenderer->AddRect(Math::MetersToPixels(aabb.lowerBound), Math::MetersToPixels(aabb.upperBound), Color::DarkGrayColor());
+                }
+            }
 
+            //The colliders, sleeping bodies are drawn in gray
             for (unsigned int i = 0; i < m_Bodies.size(); i++)
             {
                 Body* body = m_Bodies.at(i);
+                if (body == nullptr)
+                {
+                    continue;
+                }
+
                 Collider* collider = body->GetCollider();
+                Color color = body->IsAwake() == true ? Color::YellowColor() : Color::GrayColor();
+                vec2 position = Math::MetersToPixels(body->GetPosition());
+                float angle = body->GetAngle();
 
                 if (collider->GetType() == ColliderType_Circle)
                 {
                     CircleCollider* circle = (CircleCollider*)collider;
-                    float radius = Math::MetersToPixels(circle->GetRadius());
-                    vec2 position = Math::MetersToPixels(body->GetPosition());
-                    float angle = Math::RadiansToDegrees(body->GetAngle());
-
-                    Polygon::InitializeCircle(&p, radius, 36, false, Color::YellowColor());
-                    p.SetPosition(position);
-                    p.SetAngle(angle);
-                    p.SetAnchorPoint(0.5f, 0.5f);
-                    p.Draw();
+                    m_DebugLineRenderer->AddCircle(position, Math::MetersToPixels(circle->GetRadius()), angle, color);
                 }
                 else if (collider->GetType() == ColliderType_Box)
                 {
                     BoxCollider* box = (BoxCollider*)collider;
-                    float width = Math::MetersToPixels(box->GetWidth());
-                    float height = Math::MetersToPixels(box->GetHeight());
-                    vec2 position = Math::MetersToPixels(body->GetPosition());
-                    float angle = Math::RadiansToDegrees(body->GetAngle());
+                    m_DebugLineRenderer->AddBox(position, Math::MetersToPixels(box->GetWidth()), Math::MetersToPixels(box->GetHeight()), angle, color);
+                }
+                else if (collider->GetType() == ColliderType_Polygon)
+                {
+                    //The vertices are relative to the body's position
+                    PolygonCollider* polygon = (PolygonCollider*)collider;
+                    float s = 0.0f;
+                    float c = 0.0f;
+                    PhysicsSinCos(angle, &s, &c);
+                    mat2 orientation = mat2(c, s, -s, c);
+
+                    vec2 vertices[POLYGON_COLLIDER_MAX_VERTICES];
+                    for (unsigned int j = 0; j < polygon->GetVertexCount(); j++)
+                    {
+                        vertices[j] = Math::MetersToPixels(body->GetPosition() + orientation * polygon->GetVerticesAtIndex(j));
+                    }
+                    m_DebugLineRenderer->AddLineLoop(vertices, polygon->GetVertexCount(), color);
+                }
+            }
 
-                    Polygon::InitializeRect(&p, width, height, false, Color::YellowColor());
-                    p.SetPosition(position);
-                    p.SetAngle(angle);
-                    p.SetAnchorPoint(0.5f, 0.5f);
-                    p.Draw();
+            //The last step's contact points and normals
+            for (unsigned int i = 0; i < m_Contacts.size(); i++)
+            {
+                Manifold& manifold = m_Contacts.at(i);
+                vec2 normal = manifold.GetNormal() * WORLD_DEBUG_DRAW_NORMAL_LENGTH;
+                for (unsigned int j = 0; j < manifold.GetPointCount(); j++)
+                {
+                    vec2 point = manifold.GetPoint(j)->position;
+                    m_DebugLineRenderer->AddLine(Math::MetersToPixels(point), Math::MetersToPixels(point + normal), Color::RedColor());
                 }
             }
+
+            //Everything is drawn with a single draw call
+            m_DebugLineRenderer->Draw();
 #endif
         }
 
         Body* World::CreateBody(Collider* aCollider, float aDensity)
         {
-            Body* body = new Body(aCollider, aDensity);
-            m_Bodies.push_back(body);
+            //Reuse the most recently freed slot, or append a new one
+            unsigned int index = 0;
+            if (m_FreeBodyIndices.empty() == false)
+            {
+                index = m_FreeBodyIndices.back();
+                m_FreeBodyIndices.pop_back();
+                m_BodyStorage.Reset(index, aCollider);
+            }
+            else
+            {
+                index = m_BodyStorage.Add(aCollider);
+                m_Bodies.push_back(nullptr);
+            }
+
+            Body* body = m_BodyPool.Create(&m_BodyStorage, index, aCollider, aDensity);
+            m_Bodies.at(index) = body;
 
             return body;
         }
 
-        void World::SetGravity(vec2 aGravity)
+        void World::DestroyBody(Body* aBody)
         {
-            m_Gravity = aGravity;
+            //Safety check, the body has already been destroyed
+            if (aBody == nullptr || aBody->GetIndex() >= m_Bodies.size() || m_Bodies.at(aBody->GetIndex()) != aBody)
+            {
+                return;
+            }
+
+            unsigned int index = aBody->GetIndex();
+
+            //Forget the body's contacts, so a new body in the same slot doesn't inherit them
+            m_ContactSolver.RemoveCachedContacts(index);
+
+            vector<unsigned long long>::iterator end = std::remove_if(m_TouchingPairs.begin(), m_TouchingPairs.end(), [index](unsigned long long aKey)
+            {
+                return (unsigned int)(aKey >> 32) == index || (unsigned int)(aKey & 0xffffffff) == index;
+            });
+            m_TouchingPairs.erase(end, m_TouchingPairs.end());
+
+            vector<CachedSimplex>::iterator simplexEnd = std::remove_if(m_SimplexCache.begin(), m_SimplexCache.end(), [index](const CachedSimplex& aCached)
+            {
+                return (unsigned int)(aCached.key >> 32) == index || (unsigned int)(aCached.key & 0xffffffff) == index;
+            });
+            m_SimplexCache.erase(simplexEnd, m_SimplexCache.end());
+
+            //Drop the contact events that refer to the body
+            function<bool(const ContactEvent&)> refersToBody = [aBody](const ContactEvent& aEvent)
+            {
+                return aEvent.bodyA == aBody || aEvent.bodyB == aBody;
+            };
+            m_BeginContactEvents.erase(std::remove_if(m_BeginContactEvents.begin(), m_BeginContactEvents.end(), refersToBody), m_BeginContactEvents.end());
+            m_PersistContactEvents.erase(std::remove_if(m_PersistContactEvents.begin(), m_PersistContactEvents.end(), refersToBody), m_PersistContactEvents.end());
+            m_EndContactEvents.erase(std::remove_if(m_EndContactEvents.begin(), m_EndContactEvents.end(), refersToBody), m_EndContactEvents.end());
+            m_RadialImpulseHits.erase(std::remove_if(m_RadialImpulseHits.begin(), m_RadialImpulseHits.end(), [aBody](const RadialImpulseHit& aHit)
+            {
+                return aHit.body == aBody;
+            }), m_RadialImpulseHits.end());
+
+            //Free the slot, the broadphase drops the body the next time it's updated
+            m_BodyStorage.Remove(index);
+            m_Bodies.at(index) = nullptr;
+            m_BodyPool.Destroy(aBody);
+            m_FreeBodyIndices.push_back(index);
+            m_IsBroadPhaseDirty = true;
         }
 
-        vec2 World::GetGravity()
+        Body* World::GetBody(BodyHandle aHandle)
         {
-            return m_Gravity;
+            if (aHandle.index >= m_Bodies.size() || m_BodyStorage.generation[aHandle.index] != aHandle.generation)
+            {
+                return nullptr;
+            }
+
+            return m_Bodies.at(aHandle.index);
         }
 
-        void World::SetListener(WorldListener* aListener)
+        unsigned int World::GetBodyCount()
         {
-            m_Listener = aListener;
+            return m_BodyPool.GetCount();
         }
 
-        bool World::CheckCollision(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+        CircleCollider* World::CreateCircleCollider(float aRadius)
+        {
+            return m_CircleColliderPool.Create(aRadius);
+        }
+
+        BoxCollider* World::CreateBoxCollider(float aWidth, float aHeight)
+        {
+            return m_BoxColliderPool.Create(aWidth, aHeight);
+        }
+
+        PolygonCollider* World::CreatePolygonCollider(const vec2* aVertices, unsigned int aCount)
         {
-            bool result = false;
+            return m_PolygonColliderPool.Create(aVertices, aCount);
+        }
 
-            //Determine the type of collision check to perform
-            if (aBodyA->GetCollider()->GetType() == ColliderType_Circle &&
-                aBodyB->GetCollider()->GetType() == ColliderType_Circle)
+        void World::DestroyCollider(Collider* aCollider)
+        {
+            if (aCollider == nullptr)
             {
-                result = CheckCircleToCircle(aBodyA, aBodyB, aManifold);
+                return;
             }
 
-            else if (aBodyA->GetCollider()->GetType() == ColliderType_Circle &&
-                aBodyB->GetCollider()->GetType() == ColliderType_Box)
+            if (aCollider->GetType() == ColliderType_Circle)
             {
-                result = CheckCircleToBox(aBodyA, aBodyB, aManifold);
+                m_CircleColliderPool.Destroy((CircleCollider*)aCollider);
             }
-
-            else if (aBodyA->GetCollider()->GetType() == ColliderType_Box &&
-                aBodyB->GetCollider()->GetType() == ColliderType_Circle)
+            else if (aCollider->GetType() == ColliderType_Box)
             {
-                result = CheckCircleToBox(aBodyB, aBodyA, aManifold);
-
-                //because we flipped the bodies, we need to flip the normal (A to B)
-                aManifold->FlipNormal();
+                m_BoxColliderPool.Destroy((BoxCollider*)aCollider);
+            }
+            else if (aCollider->GetType() == ColliderType_Polygon)
+            {
+                m_PolygonColliderPool.Destroy((PolygonCollider*)aCollider);
             }
+        }
 
-            return result;
+        void World::SetGravity(vec2 aGravity)
+        {
+            m_Gravity = aGravity;
         }
 
-        bool World::CheckCircleToCircle(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+        vec2 World::GetGravity()
         {
-            if (aBodyA->GetGameObject() != nullptr && aBodyA->GetGameObject()->IsEnabled() == false)
-            {
-                return false;
-            }
+            return m_Gravity;
+        }
 
-            if (aBodyB->GetGameObject() != nullptr && aBodyB->GetGameObject()->IsEnabled() == false)
-            {
-                return false;
-            }
+        void World::SetListener(WorldListener* aListener)
+        {
+            m_Listener = aListener;
+        }
 
-            //Get the Circle Colliders
-            CircleCollider* circleColliderA = (CircleCollider*)aBodyA->GetCollider();
-            CircleCollider* circleColliderB = (CircleCollider*)aBodyB->GetCollider();
+        const vector<ContactEvent>& World::GetBeginContactEvents()
+        {
+            return m_BeginContactEvents;
+        }
 
-            //Check the distance against the radii for collision
-            float distanceSquared = Math::CalculateDistanceSquared(aBodyA->GetPosition(), aBodyB->GetPosition());
-            float combinedRadii = circleColliderA->GetRadius() + circleColliderB->GetRadius();
-            float radiiSquared = combinedRadii * combinedRadii;
+        const vector<ContactEvent>& World::GetPersistContactEvents()
+        {
+            return m_PersistContactEvents;
+        }
 
-            if (distanceSquared > radiiSquared)
+        const vector<ContactEvent>& World::GetEndContactEvents()
+        {
+            return m_EndContactEvents;
+        }
+
+        bool World::RayCast(vec2 aPoint1, vec2 aPoint2, RayCastResult* aResult)
+        {
+            *aResult = RayCastResult();
+
+            //Query the broadphase with the ray's AABB
+            AABB aabb(glm::min(aPoint1, aPoint2), glm::max(aPoint1, aPoint2));
+            QueryBroadPhase(aabb, m_QueryResults);
+
+            //Keep the closest hit, the results are in body order so ties go to the lowest index
+            for (unsigned int i = 0; i < m_QueryResults.size(); i++)
             {
-                return false;
+                Body* body = m_Bodies.at(m_QueryResults.at(i));
+                if (IsQueryable(body) == true)
+                {
+                    RayCastBody(body, aPoint1, aPoint2, aResult->fraction, aResult);
+                }
             }
 
-            //Calculate the overlap and the collision normal
-            float distance = sqrtf(distanceSquared);
-            float overlap = combinedRadii - distance;
-            vec2 normal = vec2(aBodyB->GetPosition() - aBodyA->GetPosition()) / distance;
-            aManifold->SetContact(overlap, normal);
-
-            return true;
+            return aResult->body != nullptr;
         }
 
-        bool World::CheckCircleToBox(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+        void World::RayCast(const vector<RayCastInput>& aRays, vector<RayCastResult>& aResults)
         {
-            if (aBodyA->GetGameObject() != nullptr && aBodyA->GetGameObject()->IsEnabled() == false)
+            aResults.assign(aRays.size(), RayCastResult());
+            if (aRays.empty() == true)
             {
-                return false;
+                return;
             }
-            if (aBodyB->GetGameObject() != nullptr && aBodyB->GetGameObject()->IsEnabled() == false)
+
+            //Sort the rays by the Morton order of the cell their origin is in, so rays that start near each other
+            //end up in the same packet. The ray's index is in the low 32 bits, which keeps the sort deterministic
+            m_RayKeys.resize(aRays.size());
+            for (unsigned int i = 0; i < aRays.size(); i++)
             {
-                return false;
+                unsigned int cellX = (unsigned int)((int)floorf(aRays.at(i).point1.x / WORLD_RAY_PACKET_CELL_SIZE) + 32768) & 0xffff;
+                unsigned int cellY = (unsigned int)((int)floorf(aRays.at(i).point1.y / WORLD_RAY_PACKET_CELL_SIZE) + 32768) & 0xffff;
+                unsigned long long morton = (unsigned long long)(SpreadBits(cellX) | (SpreadBits(cellY) << 1));
+                m_RayKeys.at(i) = (morton << 32) | i;
             }
+            std::sort(m_RayKeys.begin(), m_RayKeys.end());
 
-            CircleCollider* circleCollider = (CircleCollider*)aBodyA->GetCollider();
-            BoxCollider* boxCollider = (BoxCollider*)aBodyB->GetCollider();
-
-            float radius = circleCollider->GetRadius();
-            float radiusSquared = radius * radius;
-            float angle = boxCollider->GetAngle();
-            float c = cosf(angle);
-            float s = sinf(angle);
-            mat2 orientation = mat2(c, -s, s, c);
-
-            vec2 circleCenter = glm::transpose(orientation) * (aBodyA->GetPosition() - aBodyB->GetPosition());
-
-            float maxSeperation = -FLT_MAX;
-            unsigned int faceNormal = 0;
+            //Query the broadphase once per packet, with the AABB of all the packet's rays, and flatten the
+            //candidate bodies into a single vector. The broadphase isn't thread safe, so this part is serial
+            unsigned int packetCount = (aRays.size() + WORLD_RAY_PACKET_SIZE - 1) / WORLD_RAY_PACKET_SIZE;
+            m_PacketCandidates.clear();
+            m_PacketOffsets.resize(packetCount + 1);
+            m_PacketOffsets.at(0) = 0;
 
-            for (unsigned int i = 0; i < BOX_COLLIDER_VERTEX_COUNT; i++)
+            for (unsigned int i = 0; i < packetCount; i++)
             {
-                vec2 vertex1 = boxCollider->GetNormalsAtIndex(i);
-                vec2 vertex2 = circleCenter - boxCollider->GetVerticesAtIndex(i);
-                float seperation = Math::Dot(vertex1, vertex2);
+                unsigned int begin = i * WORLD_RAY_PACKET_SIZE;
+                unsigned int end = std::min(begin + WORLD_RAY_PACKET_SIZE, (unsigned int)aRays.size());
 
-                if (seperation > radius)
+                AABB aabb;
+                for (unsigned int j = begin; j < end; j++)
                 {
-                    return false;
+                    const RayCastInput& ray = aRays.at((unsigned int)m_RayKeys.at(j));
+                    AABB rayAABB(glm::min(ray.point1, ray.point2), glm::max(ray.point1, ray.point2));
+                    aabb = j == begin ? rayAABB : AABB::Combine(aabb, rayAABB);
                 }
 
-                if (seperation > maxSeperation)
+                QueryBroadPhase(aabb, m_QueryResults);
+                for (unsigned int j = 0; j < m_QueryResults.size(); j++)
                 {
-                    maxSeperation = seperation;
-                    faceNormal = i;
+                    if (IsQueryable(m_Bodies.at(m_QueryResults.at(j))) == true)
+                    {
+                        m_PacketCandidates.push_back(m_QueryResults.at(j));
+                    }
+                }
+                m_PacketOffsets.at(i + 1) = m_PacketCandidates.size();
+            }
+
+            //Test each ray against its packet's candidates, the packets are split into contiguous ranges,
+            //one per task, and each ray's result is written to the ray's own slot
+            unsigned int taskCount = 1;
+            if (m_ThreadPool != nullptr)
+            {
+                taskCount = std::min(m_ThreadPool->GetThreadCount(), packetCount / WORLD_MIN_RAY_PACKETS_PER_TASK);
+                taskCount = std::max(taskCount, 1u);
+            }
+
+            function<void(unsigned int)> rayCastTask = [this, &aRays, &aResults, packetCount, taskCount](unsigned int aTaskIndex)
+            {
+                unsigned int beginPacket = packetCount * aTaskIndex / taskCount;
+                unsigned int endPacket = packetCount * (aTaskIndex + 1) / taskCount;
+
+                for (unsigned int i = beginPacket; i < endPacket; i++)
+                {
+                    unsigned int begin = i * WORLD_RAY_PACKET_SIZE;
+                    unsigned int end = std::min(begin + WORLD_RAY_PACKET_SIZE, (unsigned int)aRays.size());
+
+                    for (unsigned int j = begin; j < end; j++)
+                    {
+                        unsigned int rayIndex = (unsigned int)m_RayKeys.at(j);
+                        const RayCastInput& ray = aRays.at(rayIndex);
+                        RayCastResult* result = &aResults.at(rayIndex);
+
+                        for (unsigned int k = m_PacketOffsets.at(i); k < m_PacketOffsets.at(i + 1); k++)
+                        {
+                            RayCastBody(m_Bodies.at(m_PacketCandidates.at(k)), ray.point1, ray.point2, result->fraction, result);
+                        }
+                    }
+                }
+            };
+
+            if (m_ThreadPool != nullptr && taskCount > 1)
+            {
+                m_ThreadPool->Run(taskCount, rayCastTask);
+            }
+            else
+            {
+                rayCastTask(0);
+            }
+        }
+
+        void World::OverlapCircle(vec2 aCenter, float aRadius, vector<Body*>& aBodies)
+        {
+            aBodies.clear();
+
+            vec2 extents = vec2(aRadius, aRadius);
+            QueryBroadPhase(AABB(aCenter - extents, aCenter + extents), m_QueryResults);
+
+            for (unsigned int i = 0; i < m_QueryResults.size(); i++)
+            {
+                Body* body = m_Bodies.at(m_QueryResults.at(i));
+                if (IsQueryable(body) == true && ComputeDistance(body, aCenter) <= aRadius)
+                {
+                    aBodies.push_back(body);
+                }
+            }
+        }
+
+        void World::OverlapAABB(const AABB& aAABB, vector<Body*>& aBodies)
+        {
+            aBodies.clear();
+            QueryBroadPhase(aAABB, m_QueryResults);
+
+            vec2 center = aAABB.GetCenter();
+            vec2 extents = aAABB.GetExtents();
+
+            for (unsigned int i = 0; i < m_QueryResults.size(); i++)
+            {
+                Body* body = m_Bodies.at(m_QueryResults.at(i));
+                if (IsQueryable(body) == false)
+                {
+                    continue;
+                }
+
+                //The broadphase has already checked the body's AABB, which is exact on the world axes
+                Collider* collider = body->GetCollider();
+                if (collider->GetType() == ColliderType_Circle)
+                {
+                    //Find the closest point in the AABB to the circle's center
+                    vec2 position = body->GetPosition();
+                    vec2 closest = glm::clamp(position, aAABB.lowerBound, aAABB.upperBound);
+                    float radius = ((CircleCollider*)collider)->GetRadius();
+                    if (Math::CalculateDistanceSquared(closest, position) > radius * radius)
+                    {
+                        continue;
+                    }
+                }
+                else if (collider->GetType() == ColliderType_Box)
+                {
+                    //Check for a separating axis along the box's own axes
+                    BoxCollider* boxCollider = (BoxCollider*)collider;
+                    float s = m_ShapeCache.sine[body->GetIndex()];
+                    float c = m_ShapeCache.cosine[body->GetIndex()];
+                    vec2 axes[2] = { vec2(c, s), vec2(-s, c) };
+                    vec2 halfSize = vec2(boxCollider->GetWidth() * 0.5f, boxCollider->GetHeight() * 0.5f);
+                    vec2 offset = center - body->GetPosition();
+
+                    bool separated = false;
+                    for (int axis = 0; axis < 2; axis++)
+                    {
+                        float projectedExtents = extents.x * fabsf(axes[axis].x) + extents.y * fabsf(axes[axis].y);
+                        if (fabsf(Math::Dot(offset, axes[axis])) > halfSize[axis] + projectedExtents)
+                        {
+                            separated = true;
+                            break;
+                        }
+                    }
+
+                    if (separated == true)
+                    {
+                        continue;
+                    }
+                }
+                else if (collider->GetType() == ColliderType_Polygon)
+                {
+                    //Check for a separating axis along the polygon's face normals
+                    WorldPolygon polygon;
+                    GetWorldPolygon(m_ShapeCache, body->GetIndex(), &polygon);
+
+                    bool separated = false;
+                    for (unsigned int j = 0; j < polygon.count; j++)
+                    {
+                        float projectedExtents = extents.x * fabsf(polygon.normals[j].x) + extents.y * fabsf(polygon.normals[j].y);
+                        if (Math::Dot(polygon.normals[j], center - polygon.vertices[j]) - projectedExtents > 0.0f)
+                        {
+                            separated = true;
+                            break;
+                        }
+                    }
+
+                    if (separated == true)
+                    {
+                        continue;
+                    }
+                }
+
+                aBodies.push_back(body);
+            }
+        }
+
+        Body* World::FindNearestBody(vec2 aPoint, float aMaxDistance, Body* aIgnore)
+        {
+            vec2 extents = vec2(aMaxDistance, aMaxDistance);
+            QueryBroadPhase(AABB(aPoint - extents, aPoint + extents), m_QueryResults);
+
+            Body* nearest = nullptr;
+            float nearestDistance = aMaxDistance;
+
+            for (unsigned int i = 0; i < m_QueryResults.size(); i++)
+            {
+                Body* body = m_Bodies.at(m_QueryResults.at(i));
+                if (body == aIgnore || IsQueryable(body) == false)
+                {
+                    continue;
+                }
+
+                float distance = ComputeDistance(body, aPoint);
+                if (distance < nearestDistance || (nearest == nullptr && distance <= nearestDistance))
+                {
+                    nearest = body;
+                    nearestDistance = distance;
+                }
+            }
+
+            return nearest;
+        }
+
+        void World::ApplyRadialImpulse(vec2 aCenter, float aRadius, float aStrength, RadialFalloff aFalloff)
+        {
+            RadialImpulse radialImpulse;
+            radialImpulse.center = aCenter;
+            radialImpulse.radius = aRadius;
+            radialImpulse.strength = aStrength;
+            radialImpulse.falloff = aFalloff;
+            m_RadialImpulses.push_back(radialImpulse);
+        }
+
+        const vector<RadialImpulseHit>& World::GetRadialImpulseHits()
+        {
+            return m_RadialImpulseHits;
+        }
+
+        void World::SetBroadPhaseType(BroadPhaseType aBroadPhaseType)
+        {
+            m_BroadPhaseType = aBroadPhaseType;
+
+            if (m_BroadPhaseType == BroadPhaseType_DynamicTree)
+            {
+                m_BroadPhase = m_DynamicTree;
+            }
+            else
+            {
+                m_BroadPhase = m_SpatialHash;
+            }
+
+            m_IsBroadPhaseDirty = true;
+        }
+
+        BroadPhaseType World::GetBroadPhaseType()
+        {
+            return m_BroadPhaseType;
+        }
+
+        void World::SetBroadPhaseCellSize(float aCellSize)
+        {
+            m_SpatialHash->SetCellSize(aCellSize);
+            m_IsBroadPhaseDirty = true;
+        }
+
+        float World::GetBroadPhaseCellSize()
+        {
+            return m_SpatialHash->GetCellSize();
+        }
+
+        void World::SetVelocityIterations(unsigned int aVelocityIterations)
+        {
+            m_ContactSolver.SetVelocityIterations(aVelocityIterations);
+        }
+
+        unsigned int World::GetVelocityIterations()
+        {
+            return m_ContactSolver.GetVelocityIterations();
+        }
+
+        void World::SetPositionIterations(unsigned int aPositionIterations)
+        {
+            m_ContactSolver.SetPositionIterations(aPositionIterations);
+        }
+
+        unsigned int World::GetPositionIterations()
+        {
+            return m_ContactSolver.GetPositionIterations();
+        }
+
+        void World::SetThreadCount(unsigned int aThreadCount)
+        {
+            SafeDelete(m_ThreadPool);
+
+            //A single thread runs the narrowphase on the calling thread, without a pool
+            if (aThreadCount > 1)
+            {
+                m_ThreadPool = new ThreadPool(aThreadCount);
+            }
+
+            m_ContactSolver.SetThreadPool(m_ThreadPool);
+        }
+
+        unsigned int World::GetThreadCount()
+        {
+            return m_ThreadPool != nullptr ? m_ThreadPool->GetThreadCount() : 1;
+        }
+
+        unsigned long long World::ComputeChecksum()
+        {
+            //64-bit FNV-1a over the bits of each value
+            unsigned long long hash = 14695981039346656037ULL;
+            unsigned int count = m_BodyStorage.GetCount();
+
+            for (unsigned int i = 0; i < count; i++)
+            {
+                float values[6] = { m_BodyStorage.positionX[i], m_BodyStorage.positionY[i], m_BodyStorage.angle[i],
+                                    m_BodyStorage.linearVelocityX[i], m_BodyStorage.linearVelocityY[i], m_BodyStorage.angularVelocity[i] };
+
+                for (unsigned int j = 0; j < 6; j++)
+                {
+                    uint32_t bits = 0;
+                    memcpy(&bits, &values[j], sizeof(bits));
+                    hash = (hash ^ bits) * 1099511628211ULL;
+                }
+
+                hash = (hash ^ m_BodyStorage.flags[i]) * 1099511628211ULL;
+            }
+
+            return hash;
+        }
+
+        void World::SetChecksumEnabled(bool aChecksumEnabled)
+        {
+            m_ChecksumEnabled = aChecksumEnabled;
+        }
+
+        bool World::IsChecksumEnabled()
+        {
+            return m_ChecksumEnabled;
+        }
+
+        unsigned long long World::GetChecksum()
+        {
+            return m_Checksum;
+        }
+
+        unsigned long long World::GetStepCount()
+        {
+            return m_StepCount;
+        }
+
+        void World::SetSleepingEnabled(bool aSleepingEnabled)
+        {
+            m_SleepingEnabled = aSleepingEnabled;
+
+            if (m_SleepingEnabled == false)
+            {
+                for (unsigned int i = 0; i < m_BodyStorage.GetCount(); i++)
+                {
+                    m_BodyStorage.Wake(i);
+                }
+            }
+        }
+
+        bool World::IsSleepingEnabled()
+        {
+            return m_SleepingEnabled;
+        }
+
+        unsigned int World::GetSleepCount()
+        {
+            return m_BodyStorage.sleepCount;
+        }
+
+        unsigned int World::GetWakeCount()
+        {
+            return m_BodyStorage.wakeCount;
+        }
+
+        void World::ResetSleepCounters()
+        {
+            m_BodyStorage.sleepCount = 0;
+            m_BodyStorage.wakeCount = 0;
+        }
+
+        unsigned int World::GetSleepingBodyCount()
+        {
+            unsigned int count = 0;
+            for (unsigned int i = 0; i < m_BodyStorage.GetCount(); i++)
+            {
+                if (m_BodyStorage.IsSleeping(i) == true && m_BodyStorage.IsFree(i) == false)
+                {
+                    count++;
+                }
+            }
+            return count;
+        }
+
+        unsigned int World::GetPairCount()
+        {
+            return m_Pairs.size();
+        }
+
+        unsigned int World::GetContactCount()
+        {
+            return m_Contacts.size();
+        }
+
+        void World::SetWarmStarting(bool aWarmStarting)
+        {
+            m_ContactSolver.SetWarmStarting(aWarmStarting);
+        }
+
+        bool World::IsWarmStarting()
+        {
+            return m_ContactSolver.IsWarmStarting();
+        }
+
+        void World::SetGraphColoring(bool aGraphColoring)
+        {
+            m_ContactSolver.SetGraphColoring(aGraphColoring);
+        }
+
+        bool World::IsGraphColoring()
+        {
+            return m_ContactSolver.IsGraphColoring();
+        }
+
+        void World::SetIslandSplitting(bool aIslandSplitting)
+        {
+            m_ContactSolver.SetIslandSplitting(aIslandSplitting);
+        }
+
+        bool World::IsIslandSplitting()
+        {
+            return m_ContactSolver.IsIslandSplitting();
+        }
+
+        void World::SetRandom(Random* aRandom)
+        {
+            m_Random = aRandom;
+        }
+
+        Random* World::GetRandom()
+        {
+            return m_Random;
+        }
+
+        void World::SaveSnapshot(WorldSnapshot* aSnapshot)
+        {
+            m_BodyStorage.Save(aSnapshot->bodies);
+            aSnapshot->bodyCount = m_BodyStorage.GetCount();
+            aSnapshot->freeBodyIndices.assign(m_FreeBodyIndices.begin(), m_FreeBodyIndices.end());
+            aSnapshot->contactCache.assign(m_ContactSolver.GetCache().begin(), m_ContactSolver.GetCache().end());
+            aSnapshot->simplexCache.assign(m_SimplexCache.begin(), m_SimplexCache.end());
+            aSnapshot->touchingPairs.assign(m_TouchingPairs.begin(), m_TouchingPairs.end());
+            aSnapshot->accumulator = m_Accumulator;
+            aSnapshot->stepCount = m_StepCount;
+            aSnapshot->checksum = m_Checksum;
+            if (m_Random != nullptr)
+            {
+                aSnapshot->random = m_Random->GetState();
+            }
+        }
+
+        void World::RestoreSnapshot(const WorldSnapshot* aSnapshot)
+        {
+            unsigned int count = aSnapshot->bodyCount;
+
+            //Destroy the bodies in the slots that were appended since the save
+            for (unsigned int i = count; i < m_Bodies.size(); i++)
+            {
+                m_BodyPool.Destroy(m_Bodies.at(i));
+            }
+            m_Bodies.resize(count, nullptr);
+
+            m_BodyStorage.Restore(aSnapshot->bodies, count);
+
+            //Match the bodies to the restored slots, the bodies whose slot was free are destroyed, and the
+            //slots that held a body are given one, binding to the state that was just restored
+            for (unsigned int i = 0; i < count; i++)
+            {
+                if (m_BodyStorage.IsFree(i) == true)
+                {
+                    if (m_Bodies.at(i) != nullptr)
+                    {
+                        m_BodyPool.Destroy(m_Bodies.at(i));
+                        m_Bodies.at(i) = nullptr;
+                    }
+                }
+                else if (m_Bodies.at(i) == nullptr)
+                {
+                    m_Bodies.at(i) = m_BodyPool.Create(&m_BodyStorage, i);
+                }
+            }
+
+            m_FreeBodyIndices.assign(aSnapshot->freeBodyIndices.begin(), aSnapshot->freeBodyIndices.end());
+            m_ContactSolver.SetCache(aSnapshot->contactCache);
+            m_SimplexCache.assign(aSnapshot->simplexCache.begin(), aSnapshot->simplexCache.end());
+            m_TouchingPairs.assign(aSnapshot->touchingPairs.begin(), aSnapshot->touchingPairs.end());
+            m_Accumulator = aSnapshot->accumulator;
+            m_StepCount = aSnapshot->stepCount;
+            m_Checksum = aSnapshot->checksum;
+            if (m_Random != nullptr)
+            {
+                m_Random->SetState(aSnapshot->random);
+            }
+
+            //The contacts, events and queued impulses belong to the steps that were rewound
+            m_Contacts.clear();
+            m_BeginContactEvents.clear();
+            m_PersistContactEvents.clear();
+            m_EndContactEvents.clear();
+            m_RadialImpulses.clear();
+            m_RadialImpulseHits.clear();
+
+            //The snapshot doesn't hold the tree's fat AABBs, rebuild the tree from the restored bodies
+            m_DynamicTree->Clear();
+            m_IsBroadPhaseDirty = true;
+        }
+
+        //Orders the cached simplices by their pair key
+        static bool CompareCachedSimplices(const CachedSimplex& aA, const CachedSimplex& aB)
+        {
+            return aA.key < aB.key;
+        }
+
+        void World::CollidePairs(unsigned int aBegin, unsigned int aEnd, vector<Manifold>& aContacts, vector<CachedSimplex>& aSimplices, CircleBatch& aCircles)
+        {
+            aContacts.clear();
+            aSimplices.clear();
+            aCircles.Clear();
+
+            //Gather the circle vs circle pairs, and check them together
+            for (unsigned int i = aBegin; i < aEnd; i++)
+            {
+                unsigned int a = m_Pairs.at(i).indexA;
+                unsigned int b = m_Pairs.at(i).indexB;
+
+                if (m_ShapeCache.type[a] != ColliderType_Circle || m_ShapeCache.type[b] != ColliderType_Circle)
+                {
+                    continue;
+                }
+
+                //The still pairs are skipped, and the sensors and disabled bodies are left to the checks below
+                if ((IsStill(a) == true && IsStill(b) == true) || ((m_BodyStorage.flags[a] | m_BodyStorage.flags[b]) & BodyFlag_Sensor) != 0)
+                {
+                    continue;
+                }
+
+                GameObject* gameObjectA = m_BodyStorage.gameObject[a];
+                GameObject* gameObjectB = m_BodyStorage.gameObject[b];
+                if ((gameObjectA != nullptr && gameObjectA->IsEnabled() == false) || (gameObjectB != nullptr && gameObjectB->IsEnabled() == false))
+                {
+                    continue;
+                }
+
+                vec2 centerA = vec2(m_BodyStorage.positionX[a], m_BodyStorage.positionY[a]);
+                vec2 centerB = vec2(m_BodyStorage.positionX[b], m_BodyStorage.positionY[b]);
+                aCircles.Add(i, centerA, m_ShapeCache.radius[a], centerB, m_ShapeCache.radius[b]);
+            }
+
+            aCircles.Collide();
+
+            //Add the contacts in pair order, taking the circle pairs' results from the batch
+            unsigned int circle = 0;
+            for (unsigned int i = aBegin; i < aEnd; i++)
+            {
+                Body* a = m_Bodies.at(m_Pairs.at(i).indexA);
+                Body* b = m_Bodies.at(m_Pairs.at(i).indexB);
+
+                if (circle < aCircles.GetCount() && aCircles.id[circle] == i)
+                {
+                    if (aCircles.touching[circle] != 0)
+                    {
+                        Manifold manifold(a, b);
+                        vec2 normal = vec2(aCircles.normalX[circle], aCircles.normalY[circle]);
+                        vec2 point = vec2(aCircles.pointX[circle], aCircles.pointY[circle]);
+                        manifold.SetContact(aCircles.overlap[circle], normal, point);
+                        aContacts.push_back(manifold);
+                    }
+
+                    circle++;
+                    continue;
+                }
+
+                //Two bodies that aren't moving, because they are static or asleep, can't push each other
+                if (IsStill(m_Pairs.at(i).indexA) == true && IsStill(m_Pairs.at(i).indexB) == true)
+                {
+                    continue;
+                }
+
+                //Initilaize a Manifold object
+                Manifold manifold(a, b);
+
+                //Load the pair's GJK simplex from the previous step, the cache isn't written until every task is done
+                CachedSimplex search;
+                search.key = MakePairKey(m_Pairs.at(i).indexA, m_Pairs.at(i).indexB);
+                vector<CachedSimplex>::iterator cached = std::lower_bound(m_SimplexCache.begin(), m_SimplexCache.end(), search, CompareCachedSimplices);
+                if (cached != m_SimplexCache.end() && cached->key == search.key)
+                {
+                    *manifold.GetSimplexCache() = cached->simplex;
+                }
+
+                //Check the collision, a sensor's pair only needs to know if the colliders overlap, so no contact points are generated
+                if (((m_BodyStorage.flags[m_Pairs.at(i).indexA] | m_BodyStorage.flags[m_Pairs.at(i).indexB]) & BodyFlag_Sensor) != 0)
+                {
+                    if (CheckSensorOverlap(a, b, manifold.GetSimplexCache()) == true)
+                    {
+                        aContacts.push_back(manifold);
+                    }
+                }
+                else if (CheckCollision(a, b, &manifold) == true)
+                {
+                    aContacts.push_back(manifold);
+                }
+
+                //Keep the simplex for the next step, whether or not the bodies collided
+                if (manifold.GetSimplexCache()->count > 0)
+                {
+                    search.simplex = *manifold.GetSimplexCache();
+                    aSimplices.push_back(search);
+                }
+            }
+        }
+
+        //Orders the broadphase pairs by indexA then indexB
+        static bool CompareBroadPhasePairs(const BroadPhasePair& aA, const BroadPhasePair& aB)
+        {
+            if (aA.indexA != aB.indexA)
+            {
+                return aA.indexA < aB.indexA;
+            }
+            return aA.indexB < aB.indexB;
+        }
+
+        void World::UpdateSensorLayer()
+        {
+            m_SensorIndices.clear();
+            for (unsigned int i = 0; i < m_BodyStorage.GetCount(); i++)
+            {
+                if ((m_BodyStorage.flags[i] & BodyFlag_Sensor) != 0)
+                {
+                    m_SensorIndices.push_back(i);
+                }
+            }
+
+            //The broadphase is given the bodies with the sensors' slots left empty, so it never pairs two sensors
+            if (m_SensorIndices.empty() == false)
+            {
+                m_BroadPhaseBodies.assign(m_Bodies.begin(), m_Bodies.end());
+                for (unsigned int i = 0; i < m_SensorIndices.size(); i++)
+                {
+                    m_BroadPhaseBodies.at(m_SensorIndices.at(i)) = nullptr;
+                }
+            }
+        }
+
+        void World::FindSensorPairs()
+        {
+            if (m_SensorIndices.empty() == true)
+            {
+                return;
+            }
+
+            //Query the broadphase, which now holds the current AABBs, with each sensor's AABB
+            unsigned int pairCount = m_Pairs.size();
+            for (unsigned int i = 0; i < m_SensorIndices.size(); i++)
+            {
+                unsigned int sensor = m_SensorIndices.at(i);
+                m_BroadPhase->Query(m_ShapeCache.aabb[sensor], m_QueryResults);
+
+                for (unsigned int j = 0; j < m_QueryResults.size(); j++)
+                {
+                    unsigned int other = m_QueryResults.at(j);
+                    if (m_Bodies.at(sensor)->ShouldCollide(m_Bodies.at(other)) == true)
+                    {
+                        m_Pairs.push_back(BroadPhasePair(std::min(sensor, other), std::max(sensor, other)));
+                    }
+                }
+            }
+
+            //Both halves are sorted, merge them so the narrowphase still runs in pair order
+            std::sort(m_Pairs.begin() + pairCount, m_Pairs.end(), CompareBroadPhasePairs);
+            std::inplace_merge(m_Pairs.begin(), m_Pairs.begin() + pairCount, m_Pairs.end(), CompareBroadPhasePairs);
+        }
+
+        bool World::CheckSensorOverlap(Body* aBodyA, Body* aBodyB, SimplexCache* aCache)
+        {
+            if (aBodyA->GetGameObject() != nullptr && aBodyA->GetGameObject()->IsEnabled() == false)
+            {
+                return false;
+            }
+            if (aBodyB->GetGameObject() != nullptr && aBodyB->GetGameObject()->IsEnabled() == false)
+            {
+                return false;
+            }
+
+            //A circle is its center for GJK, and its radius is taken off the distance
+            Body* bodies[2] = { aBodyA, aBodyB };
+            vec2 centers[2];
+            ConvexShape shapes[2];
+            float radius = 0.0f;
+
+            for (unsigned int i = 0; i < 2; i++)
+            {
+                unsigned int index = bodies[i]->GetIndex();
+                Collider* collider = m_BodyStorage.collider[index];
+
+                if (collider->GetType() == ColliderType_Circle)
+                {
+                    centers[i] = vec2(m_BodyStorage.positionX[index], m_BodyStorage.positionY[index]);
+                    shapes[i] = ConvexShape(&centers[i], 1);
+                    radius += ((CircleCollider*)collider)->GetRadius();
+                }
+                else
+                {
+                    WorldPolygon polygon;
+                    GetWorldPolygon(m_ShapeCache, index, &polygon);
+                    shapes[i] = ConvexShape(polygon.vertices, polygon.count);
+                }
+            }
+
+            //GJK can stop on an edge of the Minkowski difference that the origin lies on, with a rounding
+            //error left in the distance, so shapes that are within the tolerance are overlapping
+            DistanceOutput output;
+            Physics::ComputeDistance(shapes[0], shapes[1], aCache, &output);
+            return output.distance <= radius + EPA_TOLERANCE;
+        }
+
+        void World::AddContactEvent(Manifold* aManifold)
+        {
+            unsigned int a = aManifold->GetBodyA()->GetIndex();
+            unsigned int b = aManifold->GetBodyB()->GetIndex();
+            unsigned long long key = MakePairKey(a, b);
+            m_TouchingPairs.push_back(key);
+
+            ContactEvent event(aManifold->GetBodyA(), aManifold->GetBodyB());
+            event.normal = aManifold->GetNormal();
+            if (aManifold->GetPointCount() > 0)
+            {
+                event.point = aManifold->GetPoint(0)->position;
+            }
+
+            if (std::binary_search(m_PreviousTouchingPairs.begin(), m_PreviousTouchingPairs.end(), key) == true)
+            {
+                m_PersistContactEvents.push_back(event);
+            }
+            else
+            {
+                m_BeginContactEvents.push_back(event);
+            }
+        }
+
+        void World::CollectEndContactEvents()
+        {
+            //The contacts are in pair order, so this is usually already sorted
+            if (std::is_sorted(m_TouchingPairs.begin(), m_TouchingPairs.end()) == false)
+            {
+                std::sort(m_TouchingPairs.begin(), m_TouchingPairs.end());
+            }
+
+            unsigned int touchingCount = m_TouchingPairs.size();
+            for (unsigned int i = 0; i < m_PreviousTouchingPairs.size(); i++)
+            {
+                unsigned long long key = m_PreviousTouchingPairs.at(i);
+                if (std::binary_search(m_TouchingPairs.begin(), m_TouchingPairs.begin() + touchingCount, key) == true)
+                {
+                    continue;
+                }
+
+                //The narrowphase skips the pairs of still bodies, so they are still touching
+                unsigned int a = (unsigned int)(key >> 32);
+                unsigned int b = (unsigned int)(key & 0xffffffff);
+                if (IsStill(a) == true && IsStill(b) == true)
+                {
+                    m_TouchingPairs.push_back(key);
+                    continue;
+                }
+
+                m_EndContactEvents.push_back(ContactEvent(m_Bodies.at(a), m_Bodies.at(b)));
+            }
+
+            //Both halves are sorted, merge them
+            std::inplace_merge(m_TouchingPairs.begin(), m_TouchingPairs.begin() + touchingCount, m_TouchingPairs.end());
+        }
+
+        unsigned long long World::MakePairKey(unsigned int aIndexA, unsigned int aIndexB)
+        {
+            return ((unsigned long long)std::min(aIndexA, aIndexB) << 32) | (unsigned long long)std::max(aIndexA, aIndexB);
+        }
+
+        bool World::IsStill(unsigned int aIndex)
+        {
+            return m_BodyStorage.inverseMass[aIndex] == 0.0f || m_BodyStorage.IsSleeping(aIndex) == true;
+        }
+
+        void World::RegisterCollisionCheck(ColliderType aTypeA, ColliderType aTypeB, CollisionCheck aCheck)
+        {
+            m_CollisionHandlers[aTypeA][aTypeB].check = aCheck;
+            m_CollisionHandlers[aTypeA][aTypeB].flip = false;
+
+            if (aTypeA != aTypeB)
+            {
+                m_CollisionHandlers[aTypeB][aTypeA].check = aCheck;
+                m_CollisionHandlers[aTypeB][aTypeA].flip = true;
+            }
+        }
+
+        bool World::CheckCollision(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+        {
+            //Look up the collision check to perform
+            const CollisionHandler& handler = m_CollisionHandlers[aBodyA->GetCollider()->GetType()][aBodyB->GetCollider()->GetType()];
+
+            //Safety check
+            if (handler.check == nullptr)
+            {
+                return false;
+            }
+
+            if (handler.flip == false)
+            {
+                return (this->*handler.check)(aBodyA, aBodyB, aManifold);
+            }
+
+            bool result = (this->*handler.check)(aBodyB, aBodyA, aManifold);
+
+            //because we flipped the bodies, we need to flip the normal (A to B)
+            aManifold->FlipNormal();
+
+            return result;
+        }
+
+        bool World::CheckCircleToCircle(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+        {
+            if (aBodyA->GetGameObject() != nullptr && aBodyA->GetGameObject()->IsEnabled() == false)
+            {
+                return false;
+            }
+
+            if (aBodyB->GetGameObject() != nullptr && aBodyB->GetGameObject()->IsEnabled() == false)
+            {
+                return false;
+            }
+
+            //Get the Circle Colliders
+            CircleCollider* circleColliderA = (CircleCollider*)aBodyA->GetCollider();
+            CircleCollider* circleColliderB = (CircleCollider*)aBodyB->GetCollider();
+
+            //Check the distance against the radii for collision
+            float distanceSquared = Math::CalculateDistanceSquared(aBodyA->GetPosition(), aBodyB->GetPosition());
+            float combinedRadii = circleColliderA->GetRadius() + circleColliderB->GetRadius();
+            float radiiSquared = combinedRadii * combinedRadii;
+
+            if (distanceSquared > radiiSquared)
+            {
+                return false;
+            }
+
+            //Calculate the overlap and the collision normal, if the centers are on top
+            //of each other pick an arbitrary normal
+            float distance = sqrtf(distanceSquared);
+            float overlap = combinedRadii - distance;
+            vec2 normal = distance > EPSILON ? vec2(aBodyB->GetPosition() - aBodyA->GetPosition()) / distance : vec2(1.0f, 0.0f);
+
+            //The contact point is halfway through the overlapping region
+            vec2 point = aBodyA->GetPosition() + normal * (circleColliderA->GetRadius() - overlap * 0.5f);
+            aManifold->SetContact(overlap, normal, point);
+
+            return true;
+        }
+
+        bool World::CheckCircleToBox(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+        {
+            if (aBodyA->GetGameObject() != nullptr && aBodyA->GetGameObject()->IsEnabled() == false)
+            {
+                return false;
+            }
+            if (aBodyB->GetGameObject() != nullptr && aBodyB->GetGameObject()->IsEnabled() == false)
+            {
+                return false;
+            }
+
+            CircleCollider* circleCollider = (CircleCollider*)aBodyA->GetCollider();
+            BoxCollider* boxCollider = (BoxCollider*)aBodyB->GetCollider();
+
+            float radius = circleCollider->GetRadius();
+            float radiusSquared = radius * radius;
+            mat2 orientation = m_ShapeCache.GetOrientation(aBodyB->GetIndex());
+
+            //Transform the circle's center into the box's local space
+            vec2 circleCenter = glm::transpose(orientation) * (aBodyA->GetPosition() - aBodyB->GetPosition());
+
+            float maxSeperation = -FLT_MAX;
+            unsigned int faceNormal = 0;
+
+            for (unsigned int i = 0; i < BOX_COLLIDER_VERTEX_COUNT; i++)
+            {
+                vec2 vertex1 = boxCollider->GetNormalsAtIndex(i);
+                vec2 vertex2 = circleCenter - boxCollider->GetVerticesAtIndex(i);
+                float seperation = Math::Dot(vertex1, vertex2);
+
+                if (seperation > radius)
+                {
+                    return false;
+                }
+
+                if (seperation > maxSeperation)
+                {
+                    maxSeperation = seperation;
+                    faceNormal = i;
                 }
             }
 
             if (maxSeperation < EPSILON)
             {
-                //Calculate the overlap and collision normal
-                float overlap = circleCollider->GetRadius();
-                vec2 normal = -(orientation * boxCollider->GetNormalsAtIndex(faceNormal));
-                aManifold->SetContact(overlap, normal);
+                //The circle's center is inside the box, push it out through the closest face
+                float overlap = radius - maxSeperation;
+                vec2 normal = -(orientation * boxCollider->GetNormalsAtIndex(faceNormal));
+                vec2 point = aBodyB->GetPosition() + orientation * (circleCenter - boxCollider->GetNormalsAtIndex(faceNormal) * maxSeperation);
+                aManifold->SetContact(overlap, normal, point);
+
+                return true;
+            }
+
+            //Find the closest point on the face's edge to the circle's center
+            vec2 vertex1 = boxCollider->GetVerticesAtIndex(faceNormal);
+            unsigned int index2 = (faceNormal + 1 < BOX_COLLIDER_VERTEX_COUNT) ? faceNormal + 1 : 0;
+            vec2 vertex2 = boxCollider->GetVerticesAtIndex(index2);
+
+            vec2 edge = vertex2 - vertex1;
+            float t = glm::clamp(Math::Dot(circleCenter - vertex1, edge) / Math::Dot(edge, edge), 0.0f, 1.0f);
+            vec2 closestPoint = vertex1 + edge * t;
+
+            float distanceSquared = Math::CalculateDistanceSquared(closestPoint, circleCenter);
+
+            if (distanceSquared <= radiusSquared)
+            {
+                //Calculate the overlap and the collision normal
+                float distance = sqrtf(distanceSquared);
+                float overlap = radius - distance;
+                vec2 normal = distance > EPSILON ? (circleCenter - closestPoint) / distance : boxCollider->GetNormalsAtIndex(faceNormal);
+                normal = -(orientation * normal);
+                vec2 point = aBodyB->GetPosition() + orientation * closestPoint;
+                aManifold->SetContact(overlap, normal, point);
+
+                return true;
+            }
+
+            return false;
+
+        }
+
+        //Local constants used by the box and polygon collision checks
+        const float BOX_REFERENCE_FACE_TOLERANCE = 0.0005f;     //In meters, favours box A as the reference box to keep the manifold stable
+        const float POLYGON_REFERENCE_FACE_TOLERANCE = 0.001f;  //Favours polygon A's face as the reference face, when both faces are almost as aligned with the normal
+
+        //A clipped contact point, and the id of the features that produced it
+        struct ClipVertex
+        {
+            vec2 position;
+            unsigned int id;
+        };
+
+        //Transforms a box or polygon collider into world space, at the body's current position and angle, for the
+        //checks that run after the bodies have moved, when the shape cache is out of date. The vertices and normals
+        //are written into the buffers, which must hold POLYGON_COLLIDER_MAX_VERTICES each
+        static void TransformPolygon(Body* aBody, vec2* aVertices, vec2* aNormals, WorldPolygon* aWorldPolygon)
+        {
+            vec2 position = aBody->GetPosition();
+            float s = 0.0f;
+            float c = 0.0f;
+            PhysicsSinCos(aBody->GetAngle(), &s, &c);
+            mat2 orientation = mat2(c, s, -s, c);
+
+            Collider* collider = aBody->GetCollider();
+            if (collider->GetType() == ColliderType_Box)
+            {
+                BoxCollider* boxCollider = (BoxCollider*)collider;
+                for (unsigned int i = 0; i < BOX_COLLIDER_VERTEX_COUNT; i++)
+                {
+                    aVertices[i] = position + orientation * boxCollider->GetVerticesAtIndex(i);
+                    aNormals[i] = orientation * boxCollider->GetNormalsAtIndex(i);
+                }
+                aWorldPolygon->count = BOX_COLLIDER_VERTEX_COUNT;
+            }
+            else
+            {
+                PolygonCollider* polygonCollider = (PolygonCollider*)collider;
+                for (unsigned int i = 0; i < polygonCollider->GetVertexCount(); i++)
+                {
+                    aVertices[i] = position + orientation * polygonCollider->GetVerticesAtIndex(i);
+                    aNormals[i] = orientation * polygonCollider->GetNormalsAtIndex(i);
+                }
+                aWorldPolygon->count = polygonCollider->GetVertexCount();
+            }
+
+            aWorldPolygon->vertices = aVertices;
+            aWorldPolygon->normals = aNormals;
+        }
+
+        //Returns the largest separation of polygon2 from any of polygon1's faces, and which face it was
+        static float FindMaxSeparation(const WorldPolygon& aPolygon1, const WorldPolygon& aPolygon2, unsigned int* aEdgeIndex)
+        {
+            float maxSeparation = -FLT_MAX;
+            unsigned int bestIndex = 0;
+
+            for (unsigned int i = 0; i < aPolygon1.count; i++)
+            {
+                //Find the deepest vertex of polygon2 along the face's normal
+                float separation = FLT_MAX;
+                for (unsigned int j = 0; j < aPolygon2.count; j++)
+                {
+                    float distance = Math::Dot(aPolygon1.normals[i], aPolygon2.vertices[j] - aPolygon1.vertices[i]);
+                    separation = fminf(separation, distance);
+                }
+
+                if (separation > maxSeparation)
+                {
+                    maxSeparation = separation;
+                    bestIndex = i;
+                }
+            }
+
+            *aEdgeIndex = bestIndex;
+            return maxSeparation;
+        }
+
+        //Returns the index of the polygon's face whose normal is most aligned with the direction
+        static unsigned int FindMostAlignedFace(const WorldPolygon& aPolygon, vec2 aDirection)
+        {
+            unsigned int bestIndex = 0;
+            float maxDot = -FLT_MAX;
+            for (unsigned int i = 0; i < aPolygon.count; i++)
+            {
+                float dot = Math::Dot(aPolygon.normals[i], aDirection);
+                if (dot > maxDot)
+                {
+                    maxDot = dot;
+                    bestIndex = i;
+                }
+            }
+            return bestIndex;
+        }
+
+        //Clips the segment to the half space dot(normal, x) <= offset, returns the number of points left
+        static unsigned int ClipSegmentToLine(ClipVertex aOut[2], const ClipVertex aIn[2], vec2 aNormal, float aOffset, unsigned int aClipId)
+        {
+            unsigned int count = 0;
+
+            //Calculate the distance of the end points to the line
+            float distance0 = Math::Dot(aNormal, aIn[0].position) - aOffset;
+            float distance1 = Math::Dot(aNormal, aIn[1].position) - aOffset;
+
+            //Keep the points behind the line
+            if (distance0 <= 0.0f)
+            {
+                aOut[count++] = aIn[0];
+            }
+            if (distance1 <= 0.0f)
+            {
+                aOut[count++] = aIn[1];
+            }
+
+            //If the points are on opposite sides of the line, add the intersection point
+            if (distance0 * distance1 < 0.0f)
+            {
+                float t = distance0 / (distance0 - distance1);
+                aOut[count].position = aIn[0].position + (aIn[1].position - aIn[0].position) * t;
+                aOut[count].id = aClipId;
+                count++;
+            }
+
+            return count;
+        }
+
+        //Clips the incident polygon's most anti-parallel face against the reference face's side planes, and adds
+        //the clipped points that are behind the reference face to the manifold. Flip is set when the reference
+        //polygon is body B's. Returns true if any points were added
+        static bool ClipPolygons(const WorldPolygon& aReference, const WorldPolygon& aIncident, unsigned int aReferenceEdge, bool aFlip, Manifold* aManifold)
+        {
+            //Find the incident edge, the edge whose normal is most anti-parallel to the reference normal
+            vec2 referenceNormal = aReference.normals[aReferenceEdge];
+            unsigned int incidentEdge = FindMostAlignedFace(aIncident, -referenceNormal);
+
+            //The feature ids pack the reference edge, the incident feature and which body is the reference body, the
+            //incident features below the incident polygon's vertex count are its vertices, the next two are the
+            //points created by the side planes
+            unsigned int featureId = aReferenceEdge | (aFlip == true ? 1 << 16 : 0);
+            unsigned int incidentEdge2 = (incidentEdge + 1 < aIncident.count) ? incidentEdge + 1 : 0;
+
+            ClipVertex incident[2];
+            incident[0].position = aIncident.vertices[incidentEdge];
+            incident[0].id = featureId | (incidentEdge << 8);
+            incident[1].position = aIncident.vertices[incidentEdge2];
+            incident[1].id = featureId | (incidentEdge2 << 8);
+
+            //Build the reference face's side planes
+            unsigned int referenceEdge2 = (aReferenceEdge + 1 < aReference.count) ? aReferenceEdge + 1 : 0;
+            vec2 vertex1 = aReference.vertices[aReferenceEdge];
+            vec2 vertex2 = aReference.vertices[referenceEdge2];
+            vec2 tangent = Math::Normalize(vertex2 - vertex1);
+
+            float frontOffset = Math::Dot(referenceNormal, vertex1);
+            float sideOffset1 = -Math::Dot(tangent, vertex1);
+            float sideOffset2 = Math::Dot(tangent, vertex2);
+
+            //Clip the incident edge against the reference face's side planes
+            ClipVertex clipPoints1[2];
+            ClipVertex clipPoints2[2];
+
+            if (ClipSegmentToLine(clipPoints1, incident, -tangent, sideOffset1, featureId | (aIncident.count << 8)) < 2)
+            {
+                return false;
+            }
+
+            if (ClipSegmentToLine(clipPoints2, clipPoints1, tangent, sideOffset2, featureId | ((aIncident.count + 1) << 8)) < 2)
+            {
+                return false;
+            }
+
+            //The normal must point from A to B
+            aManifold->SetNormal(aFlip == true ? -referenceNormal : referenceNormal);
+
+            //Keep the clipped points that are behind the reference face
+            for (unsigned int i = 0; i < 2; i++)
+            {
+                float separation = Math::Dot(referenceNormal, clipPoints2[i].position) - frontOffset;
+
+                if (separation <= 0.0f)
+                {
+                    //The contact point is halfway between the incident point and the reference face
+                    vec2 point = clipPoints2[i].position - referenceNormal * (separation * 0.5f);
+                    aManifold->AddPoint(point, -separation, clipPoints2[i].id);
+                }
+            }
+
+            return aManifold->GetPointCount() > 0;
+        }
+
+        //Clips a ray against the polygon's faces, pushed out by the radius. Returns false if the ray misses,
+        //or if it starts inside the polygon, otherwise the fraction and normal of the face it entered through
+        static bool ClipRayToPolygon(const WorldPolygon& aPolygon, vec2 aStart, vec2 aDirection, float aRadius, float aMaxFraction, float* aFraction, vec2* aNormal)
+        {
+            float tMin = 0.0f;
+            float tMax = aMaxFraction;
+            int entryFace = -1;
+
+            for (unsigned int i = 0; i < aPolygon.count; i++)
+            {
+                //The ray is inside the face's half space for t where numerator >= denominator * t
+                float numerator = Math::Dot(aPolygon.normals[i], aPolygon.vertices[i] - aStart) + aRadius;
+                float denominator = Math::Dot(aPolygon.normals[i], aDirection);
+
+                if (fabsf(denominator) < EPSILON)
+                {
+                    //The ray is parallel to the face
+                    if (numerator < 0.0f)
+                    {
+                        return false;
+                    }
+                }
+                else if (denominator < 0.0f && numerator < tMin * denominator)
+                {
+                    //The ray enters the face's half space
+                    tMin = numerator / denominator;
+                    entryFace = (int)i;
+                }
+                else if (denominator > 0.0f && numerator < tMax * denominator)
+                {
+                    //The ray leaves the face's half space
+                    tMax = numerator / denominator;
+                }
+
+                if (tMax < tMin)
+                {
+                    return false;
+                }
+            }
+
+            if (entryFace == -1)
+            {
+                return false;
+            }
+
+            *aFraction = tMin;
+            *aNormal = aPolygon.normals[entryFace];
+            return true;
+        }
+
+        bool World::CheckBoxToBox(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+        {
+            if (aBodyA->GetGameObject() != nullptr && aBodyA->GetGameObject()->IsEnabled() == false)
+            {
+                return false;
+            }
+
+            if (aBodyB->GetGameObject() != nullptr && aBodyB->GetGameObject()->IsEnabled() == false)
+            {
+                return false;
+            }
+
+            WorldPolygon boxA;
+            WorldPolygon boxB;
+            GetWorldPolygon(m_ShapeCache, aBodyA->GetIndex(), &boxA);
+            GetWorldPolygon(m_ShapeCache, aBodyB->GetIndex(), &boxB);
+
+            //Separating axis test, check the face normals of both boxes
+            unsigned int edgeA = 0;
+            float separationA = FindMaxSeparation(boxA, boxB, &edgeA);
+            if (separationA > 0.0f)
+            {
+                return false;
+            }
+
+            unsigned int edgeB = 0;
+            float separationB = FindMaxSeparation(boxB, boxA, &edgeB);
+            if (separationB > 0.0f)
+            {
+                return false;
+            }
+
+            //The reference face is the face of least penetration, the other box is the incident box
+            if (separationB > separationA + BOX_REFERENCE_FACE_TOLERANCE)
+            {
+                return ClipPolygons(boxB, boxA, edgeB, true, aManifold);
+            }
+
+            return ClipPolygons(boxA, boxB, edgeA, false, aManifold);
+        }
+
+        bool World::CheckCircleToPolygon(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+        {
+            if (aBodyA->GetGameObject() != nullptr && aBodyA->GetGameObject()->IsEnabled() == false)
+            {
+                return false;
+            }
+            if (aBodyB->GetGameObject() != nullptr && aBodyB->GetGameObject()->IsEnabled() == false)
+            {
+                return false;
+            }
+
+            float radius = ((CircleCollider*)aBodyA->GetCollider())->GetRadius();
+            vec2 center = aBodyA->GetPosition();
+
+            WorldPolygon polygon;
+            GetWorldPolygon(m_ShapeCache, aBodyB->GetIndex(), &polygon);
+
+            //Find the closest point on the polygon to the circle's center, the circle is a single point for GJK
+            ConvexShape shapeA(&center, 1);
+            ConvexShape shapeB(polygon.vertices, polygon.count);
+
+            DistanceOutput output;
+            Physics::ComputeDistance(shapeA, shapeB, aManifold->GetSimplexCache(), &output);
+
+            if (output.distance > radius)
+            {
+                return false;
+            }
 
+            if (output.distance > EPSILON)
+            {
+                //The normal points from the circle's center to the closest point on the polygon
+                vec2 normal = (output.pointB - center) / output.distance;
+                aManifold->SetContact(radius - output.distance, normal, output.pointB);
                 return true;
             }
 
-            vec2 vertex1 = boxCollider->GetVerticesAtIndex(faceNormal);
-            unsigned int index2 = (faceNormal + 1 < BOX_COLLIDER_VERTEX_COUNT) ? faceNormal + 1 : 0;
-            vec2 vertex2 = boxCollider->GetVerticesAtIndex(index2);
+            //The circle's center is inside the polygon, push it out through the closest face
+            unsigned int face = 0;
+            float maxSeparation = -FLT_MAX;
+            for (unsigned int i = 0; i < polygon.count; i++)
+            {
+                float separation = Math::Dot(polygon.normals[i], center - polygon.vertices[i]);
+                if (separation > maxSeparation)
+                {
+                    maxSeparation = separation;
+                    face = i;
+                }
+            }
+
+            vec2 point = center - polygon.normals[face] * maxSeparation;
+            aManifold->SetContact(radius - maxSeparation, -polygon.normals[face], point);
+            return true;
+        }
+
+        bool World::CheckPolygonToPolygon(Body* aBodyA, Body* aBodyB, Manifold* aManifold)
+        {
+            if (aBodyA->GetGameObject() != nullptr && aBodyA->GetGameObject()->IsEnabled() == false)
+            {
+                return false;
+            }
+
+            if (aBodyB->GetGameObject() != nullptr && aBodyB->GetGameObject()->IsEnabled() == false)
+            {
+                return false;
+            }
 
-            vec2 closestPoint = Math::CalculateClosestPoint(circleCenter, radius, vertex1, vertex2);
+            WorldPolygon polygonA;
+            WorldPolygon polygonB;
+            GetWorldPolygon(m_ShapeCache, aBodyA->GetIndex(), &polygonA);
+            GetWorldPolygon(m_ShapeCache, aBodyB->GetIndex(), &polygonB);
 
-            float distance = Math::CalculateDistanceSquared(closestPoint, circleCenter);
+            ConvexShape shapeA(polygonA.vertices, polygonA.count);
+            ConvexShape shapeB(polygonB.vertices, polygonB.count);
 
-            if (distance <= radiusSquared)
+            //GJK finds if the polygons overlap, starting from the last step's simplex, and EPA finds the normal
+            PenetrationOutput output;
+            if (ComputePenetration(shapeA, shapeB, aManifold->GetSimplexCache(), &output) == false)
             {
-                //Calculate the overlap and the collision normal
-                float overlap = radius - distance;
-                vec2 normal = circleCenter - closestPoint;
-                normal = -(orientation * normal);
-                normal = Math::Normalize(normal);
-                aManifold->SetContact(overlap, normal);
+                return false;
+            }
+
+            //The reference face is the face most aligned with the penetration normal, the contact points
+            //are then clipped from the other polygon's face, the same as the box to box check
+            unsigned int edgeA = FindMostAlignedFace(polygonA, output.normal);
+            unsigned int edgeB = FindMostAlignedFace(polygonB, -output.normal);
+            float alignmentA = Math::Dot(polygonA.normals[edgeA], output.normal);
+            float alignmentB = -Math::Dot(polygonB.normals[edgeB], output.normal);
+
+            if (alignmentB > alignmentA + POLYGON_REFERENCE_FACE_TOLERANCE)
+            {
+                return ClipPolygons(polygonB, polygonA, edgeB, true, aManifold);
+            }
+
+            return ClipPolygons(polygonA, polygonB, edgeA, false, aManifold);
+        }
+
+        void World::QueryBroadPhase(const AABB& aAABB, vector<unsigned int>& aBodies)
+        {
+            //Update the broadphase with the bodies' current AABBs, if they've changed since the last query
+            if (m_IsBroadPhaseDirty == true || m_BodyStorage.isTransformDirty == true)
+            {
+                m_ShapeCache.Update(m_BodyStorage);
+                UpdateSensorLayer();
+                m_BroadPhase->Update(m_SensorIndices.empty() == true ? m_Bodies : m_BroadPhaseBodies, m_ShapeCache.aabb);
+                m_IsBroadPhaseDirty = false;
+                m_BodyStorage.isTransformDirty = false;
+            }
+
+            m_BroadPhase->Query(aAABB, aBodies);
+        }
+
+        bool World::IsQueryable(Body* aBody)
+        {
+            //Bodies whose GameObject is disabled aren't in the game, so the queries skip them
+            return aBody->GetGameObject() == nullptr || aBody->GetGameObject()->IsEnabled() == true;
+        }
+
+        bool World::RayCastBody(Body* aBody, vec2 aPoint1, vec2 aPoint2, float aMaxFraction, RayCastResult* aResult)
+        {
+            //Fills in the result and returns true if the ray hits the body closer than the max fraction
+            Collider* collider = aBody->GetCollider();
+            vec2 direction = aPoint2 - aPoint1;
+
+            if (collider->GetType() == ColliderType_Circle)
+            {
+                float radius = ((CircleCollider*)collider)->GetRadius();
+                vec2 offset = aPoint1 - aBody->GetPosition();
+
+                //Rays that start inside the circle don't hit it
+                float c = Math::Dot(offset, offset) - radius * radius;
+                if (c <= 0.0f)
+                {
+                    return false;
+                }
+
+                float a = Math::Dot(direction, direction);
+                float b = Math::Dot(offset, direction);
+                float discriminant = b * b - a * c;
+                if (b >= 0.0f || discriminant < 0.0f || a < EPSILON * EPSILON)
+                {
+                    return false;
+                }
+
+                float t = (-b - sqrtf(discriminant)) / a;
+                if (t >= aMaxFraction)
+                {
+                    return false;
+                }
+
+                aResult->body = aBody;
+                aResult->fraction = t;
+                aResult->point = aPoint1 + direction * t;
+                aResult->normal = Math::Normalize(offset + direction * t);
+                return true;
+            }
+            else if (collider->GetType() == ColliderType_Box)
+            {
+                //Slab test, in the box's local space
+                BoxCollider* boxCollider = (BoxCollider*)collider;
+                mat2 orientation = m_ShapeCache.GetOrientation(aBody->GetIndex());
+                vec2 start = glm::transpose(orientation) * (aPoint1 - aBody->GetPosition());
+                vec2 localDirection = glm::transpose(orientation) * direction;
+                vec2 extents = vec2(boxCollider->GetWidth() * 0.5f, boxCollider->GetHeight() * 0.5f);
+
+                float tMin = 0.0f;
+                float tMax = aMaxFraction;
+                int entryAxis = -1;
+                vec2 normal = vec2(0.0f, 0.0f);
+
+                for (int axis = 0; axis < 2; axis++)
+                {
+                    if (fabsf(localDirection[axis]) < EPSILON)
+                    {
+                        //The ray is parallel to the slab
+                        if (fabsf(start[axis]) > extents[axis])
+                        {
+                            return false;
+                        }
+                    }
+                    else
+                    {
+                        float inverseDirection = 1.0f / localDirection[axis];
+                        float t1 = (-extents[axis] - start[axis]) * inverseDirection;
+                        float t2 = (extents[axis] - start[axis]) * inverseDirection;
+                        float sign = -1.0f;
+                        if (t1 > t2)
+                        {
+                            std::swap(t1, t2);
+                            sign = 1.0f;
+                        }
+
+                        //Keep the face the ray entered through
+                        if (t1 > tMin)
+                        {
+                            tMin = t1;
+                            entryAxis = axis;
+                            normal = vec2(0.0f, 0.0f);
+                            normal[axis] = sign;
+                        }
+                        tMax = std::min(tMax, t2);
+
+                        if (tMin > tMax)
+                        {
+                            return false;
+                        }
+                    }
+                }
+
+                //The ray started inside the box, or the box is beyond the max fraction
+                if (entryAxis == -1 || tMin >= aMaxFraction)
+                {
+                    return false;
+                }
+
+                aResult->body = aBody;
+                aResult->fraction = tMin;
+                aResult->point = aPoint1 + direction * tMin;
+                aResult->normal = orientation * normal;
+                return true;
+            }
+            else if (collider->GetType() == ColliderType_Polygon)
+            {
+                WorldPolygon polygon;
+                GetWorldPolygon(m_ShapeCache, aBody->GetIndex(), &polygon);
+
+                float fraction = 0.0f;
+                vec2 normal = vec2(0.0f, 0.0f);
+                if (ClipRayToPolygon(polygon, aPoint1, direction, 0.0f, aMaxFraction, &fraction, &normal) == false || fraction >= aMaxFraction)
+                {
+                    return false;
+                }
 
+                aResult->body = aBody;
+                aResult->fraction = fraction;
+                aResult->point = aPoint1 + direction * fraction;
+                aResult->normal = normal;
                 return true;
             }
 
             return false;
+        }
+
+        float World::ComputeDistance(Body* aBody, vec2 aPoint)
+        {
+            //Returns the distance from the point to the body's collider, 0 if the point is inside it
+            Collider* collider = aBody->GetCollider();
+
+            if (collider->GetType() == ColliderType_Circle)
+            {
+                float distance = Math::CalculateDistance(aPoint, aBody->GetPosition()) - ((CircleCollider*)collider)->GetRadius();
+                return std::max(distance, 0.0f);
+            }
+            else if (collider->GetType() == ColliderType_Box)
+            {
+                BoxCollider* boxCollider = (BoxCollider*)collider;
+                mat2 orientation = m_ShapeCache.GetOrientation(aBody->GetIndex());
+                vec2 local = glm::transpose(orientation) * (aPoint - aBody->GetPosition());
+                vec2 extents = vec2(boxCollider->GetWidth() * 0.5f, boxCollider->GetHeight() * 0.5f);
+                vec2 outside = glm::max(glm::abs(local) - extents, vec2(0.0f, 0.0f));
+                return Math::CalculateDistance(outside);
+            }
+            else if (collider->GetType() == ColliderType_Polygon)
+            {
+                WorldPolygon polygon;
+                GetWorldPolygon(m_ShapeCache, aBody->GetIndex(), &polygon);
+
+                ConvexShape shapeA(&aPoint, 1);
+                ConvexShape shapeB(polygon.vertices, polygon.count);
+
+                SimplexCache cache;
+                DistanceOutput output;
+                Physics::ComputeDistance(shapeA, shapeB, &cache, &output);
+                return output.distance;
+            }
+
+            return Math::CalculateDistance(aPoint, aBody->GetPosition());
+        }
+
+        void World::ApplyRadialImpulses()
+        {
+            for (unsigned int i = 0; i < m_RadialImpulses.size(); i++)
+            {
+                const RadialImpulse& radialImpulse = m_RadialImpulses.at(i);
+
+                //The broadphase finds the bodies whose AABB overlaps the impulse's bounds, sensors aren't in it
+                vec2 extents = vec2(radialImpulse.radius, radialImpulse.radius);
+                m_BroadPhase->Query(AABB(radialImpulse.center - extents, radialImpulse.center + extents), m_QueryResults);
+
+                for (unsigned int j = 0; j < m_QueryResults.size(); j++)
+                {
+                    unsigned int index = m_QueryResults.at(j);
+                    Body* body = m_Bodies.at(index);
+                    if (body == nullptr || IsQueryable(body) == false)
+                    {
+                        continue;
+                    }
+
+                    float distance = ComputeDistance(body, radialImpulse.center);
+                    if (distance > radialImpulse.radius)
+                    {
+                        continue;
+                    }
+
+                    //Weaken the impulse with the distance to the body's collider
+                    float scale = 1.0f;
+                    if (radialImpulse.falloff != RadialFalloff_None && radialImpulse.radius > 0.0f)
+                    {
+                        scale = 1.0f - distance / radialImpulse.radius;
+                        if (radialImpulse.falloff == RadialFalloff_Quadratic)
+                        {
+                            scale *= scale;
+                        }
+                    }
 
+                    //Push the body's center away from the impulse's center, a body centered on it isn't pushed
+                    RadialImpulseHit hit;
+                    hit.body = body;
+                    hit.impulseIndex = i;
+                    hit.distance = distance;
+
+                    vec2 offset = body->GetPosition() - radialImpulse.center;
+                    float length = Math::CalculateDistance(offset);
+                    if (length > EPSILON && m_BodyStorage.inverseMass[index] != 0.0f)
+                    {
+                        hit.impulse = offset * (radialImpulse.strength * scale / length);
+                        body->ApplyLinearImpulse(hit.impulse);
+                    }
+
+                    m_RadialImpulseHits.push_back(hit);
+                }
+            }
+
+            m_RadialImpulses.clear();
+        }
+
+        void World::SolveTimeOfImpact()
+        {
+            for (unsigned int i = 0; i < m_BulletSweeps.size(); i++)
+            {
+                unsigned int index = m_BulletSweeps.at(i).index;
+                Body* bullet = m_Bodies.at(index);
+
+                //Safety check, skip disabled bullets
+                if (bullet->GetGameObject() != nullptr && bullet->GetGameObject()->IsEnabled() == false)
+                {
+                    continue;
+                }
+
+                //The bullet is swept as a circle, boxes and polygons use their inscribed circle so the
+                //bullet is never stopped before it actually touches a body
+                float sweepRadius = 0.0f;
+                Collider* collider = bullet->GetCollider();
+                if (collider->GetType() == ColliderType_Circle)
+                {
+                    sweepRadius = ((CircleCollider*)collider)->GetRadius();
+                }
+                else if (collider->GetType() == ColliderType_Box)
+                {
+                    sweepRadius = std::min(((BoxCollider*)collider)->GetWidth(), ((BoxCollider*)collider)->GetHeight()) * 0.5f;
+                }
+                else if (collider->GetType() == ColliderType_Polygon)
+                {
+                    sweepRadius = ((PolygonCollider*)collider)->GetInnerRadius();
+                }
+
+                //If the bullet moved less than its radius, the discrete collision check will catch it
+                vec2 start = m_BulletSweeps.at(i).start;
+                vec2 end = bullet->GetPosition();
+                if (Math::CalculateDistanceSquared(start, end) < sweepRadius * sweepRadius)
+                {
+                    continue;
+                }
+
+                //Query the broadphase with the swept AABB
+                vec2 extents = vec2(sweepRadius, sweepRadius);
+                AABB sweptAABB(glm::min(start, end) - extents, glm::max(start, end) + extents);
+                m_BroadPhase->Query(sweptAABB, m_QueryResults);
+
+                //Find the earliest time of impact
+                float minTimeOfImpact = 1.0f;
+                for (unsigned int j = 0; j < m_QueryResults.size(); j++)
+                {
+                    Body* target = m_Bodies.at(m_QueryResults.at(j));
+
+                    //Bullets don't sweep against themselves, other bullets, or bodies they're filtered from
+                    if (target == bullet || target->IsBullet() == true || bullet->ShouldCollide(target) == false)
+                    {
+                        continue;
+                    }
+
+                    //Skip disabled bodies
+                    if (target->GetGameObject() != nullptr && target->GetGameObject()->IsEnabled() == false)
+                    {
+                        continue;
+                    }
+
+                    minTimeOfImpact = std::min(minTimeOfImpact, ComputeTimeOfImpact(start, end, sweepRadius, target));
+                }
+
+                //Move the bullet back to its time of impact, it keeps its velocity so the contact
+                //solver handles the impact during the next step
+                if (minTimeOfImpact < 1.0f)
+                {
+                    vec2 position = start + (end - start) * minTimeOfImpact;
+                    m_BodyStorage.positionX[index] = position.x;
+                    m_BodyStorage.positionY[index] = position.y;
+                }
+            }
+        }
+
+        float World::ComputeTimeOfImpact(vec2 aStart, vec2 aEnd, float aSweepRadius, Body* aTarget)
+        {
+            //Returns the fraction (0 to 1) of the sweep at which the bullet hits the target, or 1 if it
+            //doesn't. The target is treated as stationary at its current position. If the bullet already
+            //overlaps the target at the start of the sweep it is left to the discrete collision check
+            float radius = std::max(aSweepRadius - WORLD_TOI_TARGET_OVERLAP, 0.0f);
+            Collider* collider = aTarget->GetCollider();
+
+            if (collider->GetType() == ColliderType_Circle)
+            {
+                //Ray cast the bullet's center against the target circle grown by the bullet's radius
+                float combinedRadius = ((CircleCollider*)collider)->GetRadius() + radius;
+                vec2 offset = aStart - aTarget->GetPosition();
+                vec2 direction = aEnd - aStart;
+
+                float c = Math::Dot(offset, offset) - combinedRadius * combinedRadius;
+                if (c <= 0.0f)
+                {
+                    return 1.0f;
+                }
+
+                float a = Math::Dot(direction, direction);
+                float b = Math::Dot(offset, direction);
+                float discriminant = b * b - a * c;
+                if (b >= 0.0f || discriminant < 0.0f)
+                {
+                    return 1.0f;
+                }
+
+                float t = (-b - sqrtf(discriminant)) / a;
+                return t < 1.0f ? t : 1.0f;
+            }
+            else if (collider->GetType() == ColliderType_Box)
+            {
+                //Ray cast the bullet's center, in the box's local space, against the box grown by
+                //the bullet's radius. The grown box's corners are square, so the bullet can stop
+                //slightly early near a corner, which the next step's sweep continues from
+                BoxCollider* boxCollider = (BoxCollider*)collider;
+                float angle = aTarget->GetAngle();
+                float s = 0.0f;
+                float c = 0.0f;
+                PhysicsSinCos(angle, &s, &c);
+                mat2 orientation = mat2(c, s, -s, c);
+                vec2 start = glm::transpose(orientation) * (aStart - aTarget->GetPosition());
+                vec2 direction = glm::transpose(orientation) * (aEnd - aStart);
+                vec2 extents = vec2(boxCollider->GetWidth() * 0.5f + radius, boxCollider->GetHeight() * 0.5f + radius);
+
+                float tMin = 0.0f;
+                float tMax = 1.0f;
+                bool inside = true;
+
+                //Slab test, on each axis
+                for (int axis = 0; axis < 2; axis++)
+                {
+                    if (fabsf(start[axis]) > extents[axis])
+                    {
+                        inside = false;
+                    }
+
+                    if (fabsf(direction[axis]) < EPSILON)
+                    {
+                        //The ray is parallel to the slab
+                        if (fabsf(start[axis]) > extents[axis])
+                        {
+                            return 1.0f;
+                        }
+                    }
+                    else
+                    {
+                        float inverseDirection = 1.0f / direction[axis];
+                        float t1 = (-extents[axis] - start[axis]) * inverseDirection;
+                        float t2 = (extents[axis] - start[axis]) * inverseDirection;
+                        tMin = std::max(tMin, std::min(t1, t2));
+                        tMax = std::min(tMax, std::max(t1, t2));
+
+                        if (tMin > tMax)
+                        {
+                            return 1.0f;
+                        }
+                    }
+                }
+
+                return inside == true ? 1.0f : tMin;
+            }
+            else if (collider->GetType() == ColliderType_Polygon)
+            {
+                //Ray cast the bullet's center against the polygon's faces pushed out by the bullet's
+                //radius, the same as a box, the corners are square so the bullet can stop slightly early
+                vec2 vertices[POLYGON_COLLIDER_MAX_VERTICES];
+                vec2 normals[POLYGON_COLLIDER_MAX_VERTICES];
+                WorldPolygon polygon;
+                TransformPolygon(aTarget, vertices, normals, &polygon);
+
+                float fraction = 1.0f;
+                vec2 normal = vec2(0.0f, 0.0f);
+                if (ClipRayToPolygon(polygon, aStart, aEnd - aStart, radius, 1.0f, &fraction, &normal) == false)
+                {
+                    return 1.0f;
+                }
+                return fraction;
+            }
+
+            return 1.0f;
+        }
+
+        void World::UpdateSleeping(float aTimeStep)
+        {
+            if (m_SleepingEnabled == false)
+            {
+                return;
+            }
+
+            unsigned int count = m_BodyStorage.GetCount();
+            float linearToleranceSquared = WORLD_SLEEP_LINEAR_TOLERANCE * WORLD_SLEEP_LINEAR_TOLERANCE;
+            float angularToleranceSquared = WORLD_SLEEP_ANGULAR_TOLERANCE * WORLD_SLEEP_ANGULAR_TOLERANCE;
+
+            //Build the contact islands, bodies that touch are merged into the same island. Static
+            //bodies don't join islands, otherwise everything resting on the ground would be one island
+            m_IslandParents.resize(count);
+            for (unsigned int i = 0; i < count; i++)
+            {
+                m_IslandParents.at(i) = i;
+            }
+
+            for (unsigned int i = 0; i < m_Contacts.size(); i++)
+            {
+                unsigned int indexA = m_Contacts.at(i).GetBodyA()->GetIndex();
+                unsigned int indexB = m_Contacts.at(i).GetBodyB()->GetIndex();
+
+                if (m_BodyStorage.inverseMass[indexA] != 0.0f && m_BodyStorage.inverseMass[indexB] != 0.0f)
+                {
+                    unsigned int rootA = FindIslandRoot(indexA);
+                    unsigned int rootB = FindIslandRoot(indexB);
+
+                    //Attach the higher root to the lower root, so the islands don't depend on the contact order
+                    if (rootA < rootB)
+                    {
+                        m_IslandParents.at(rootB) = rootA;
+                    }
+                    else if (rootB < rootA)
+                    {
+                        m_IslandParents.at(rootA) = rootB;
+                    }
+                }
+            }
+
+            //Update how long each awake body has been at rest, an island can only
+            //sleep once its most recently moving body has been at rest long enough
+            m_IslandSleepTimes.assign(count, FLT_MAX);
+            for (unsigned int i = 0; i < count; i++)
+            {
+                if (m_BodyStorage.inverseMass[i] == 0.0f || m_BodyStorage.IsSleeping(i) == true)
+                {
+                    continue;
+                }
+
+                float linearSpeedSquared = m_BodyStorage.linearVelocityX[i] * m_BodyStorage.linearVelocityX[i] + m_BodyStorage.linearVelocityY[i] * m_BodyStorage.linearVelocityY[i];
+                float angularSpeedSquared = m_BodyStorage.angularVelocity[i] * m_BodyStorage.angularVelocity[i];
+
+                if (linearSpeedSquared > linearToleranceSquared || angularSpeedSquared > angularToleranceSquared)
+                {
+                    m_BodyStorage.sleepTime[i] = 0.0f;
+                }
+                else
+                {
+                    m_BodyStorage.sleepTime[i] += aTimeStep;
+                }
+
+                unsigned int root = FindIslandRoot(i);
+                m_IslandSleepTimes.at(root) = std::min(m_IslandSleepTimes.at(root), m_BodyStorage.sleepTime[i]);
+            }
+
+            //Put the islands that have been at rest long enough to sleep
+            for (unsigned int i = 0; i < count; i++)
+            {
+                if (m_BodyStorage.inverseMass[i] == 0.0f || m_BodyStorage.IsSleeping(i) == true)
+                {
+                    continue;
+                }
+
+                if (m_IslandSleepTimes.at(FindIslandRoot(i)) >= WORLD_TIME_TO_SLEEP)
+                {
+                    m_BodyStorage.Sleep(i);
+
+                    //SyncGameObjects() skips sleeping bodies, so move the GameObject to where the body came to rest,
+                    //instead of leaving it at the last interpolated transform
+                    SyncGameObject(i, 1.0f);
+                }
+            }
+        }
+
+        unsigned int World::FindIslandRoot(unsigned int aIndex)
+        {
+            //Walk up to the root, halving the path along the way
+            while (m_IslandParents.at(aIndex) != aIndex)
+            {
+                m_IslandParents.at(aIndex) = m_IslandParents.at(m_IslandParents.at(aIndex));
+                aIndex = m_IslandParents.at(aIndex);
+            }
+            return aIndex;
         }
     }
 }
\ No newline at end of file
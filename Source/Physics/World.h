@@ -4,6 +4,21 @@
 #include "../Core/BaseObject.h"
 #include "WorldListener.h"
 #include "Manifold.h"
+#include "BroadPhase.h"
+#include "BodyStorage.h"
+#include "ShapeCache.h"
+#include "CircleBatch.h"
+#include "ContactSolver.h"
+#include "Collider.h"
+#include "RayCast.h"
+#include "RadialImpulse.h"
+#include "ContactEvent.h"
+#include "WorldSnapshot.h"
+#include "Body.h"
+#include "CircleCollider.h"
+#include "BoxCollider.h"
+#include "PolygonCollider.h"
+#include "../Utils/Pool/Pool.h"
 
 
 using namespace glm;
@@ -12,47 +27,344 @@ namespace GameDev2D
 {
     //Forward declarations
     class GameObject;
+    class ThreadPool;
+    class Random;
+    class DebugLineRenderer;
 
     namespace Physics
     {
+        //Local constants
+        const float WORLD_SLEEP_LINEAR_TOLERANCE = 0.05f;    //In m/s
+        const float WORLD_SLEEP_ANGULAR_TOLERANCE = 0.035f;  //In radians/second (2 degrees)
+        const float WORLD_TIME_TO_SLEEP = 0.5f;              //In seconds
+        const double WORLD_DEFAULT_FIXED_TIME_STEP = 1.0 / 60.0;  //In seconds
+        const unsigned int WORLD_DEFAULT_MAX_SUB_STEPS = 5;
+        const unsigned int WORLD_MIN_PAIRS_PER_TASK = 64;    //Narrowphase tasks smaller than this cost more to hand to a thread than to run
+        const unsigned int WORLD_RAY_PACKET_SIZE = 8;       //Rays that are batched together share a single broadphase query
+        const float WORLD_RAY_PACKET_CELL_SIZE = 4.0f;      //In meters, rays are grouped into packets by the cell their origin is in
+        const unsigned int WORLD_MIN_RAY_PACKETS_PER_TASK = 8;
+        const float WORLD_TOI_TARGET_OVERLAP = 0.01f; //In meters, bullets are stopped slightly inside a body so the next step's narrowphase finds the contact
+        const float WORLD_DEBUG_DRAW_NORMAL_LENGTH = 0.25f; //In meters
+
         //Forward declarations
-        class Body;
-        class Collider;
+        class SpatialHash;
+        class DynamicTreeBroadPhase;
 
         class World : public BaseObject
         {
         public:
-            static World* GetInstance();
+            World();
+            ~World();
 
+            //Advances the world by a single step, and syncs the GameObjects to the bodies
             void Step(double timeStep);
 
+            //Advances the world by the frame's delta time, using as many fixed time steps as fit in the
+            //accumulated time, up to the maximum number of sub-steps. Forces applied before Update() act
+            //on every sub-step, and are cleared if the frame is too short for a step, so apply continuous
+            //forces every frame and use impulses for one-off pushes. The GameObjects are synced to the bodies' transforms interpolated between
+            //the last two steps by the time left over in the accumulator
+            void Update(double delta);
+
+            //The time step (in seconds) used by Update()
+            void SetFixedTimeStep(double fixedTimeStep);
+            double GetFixedTimeStep();
+
+            //The maximum number of steps Update() can take in a single frame, when a frame takes longer
+            //the remaining time is dropped so the physics can't fall further and further behind
+            void SetMaxSubSteps(unsigned int maxSubSteps);
+            unsigned int GetMaxSubSteps();
+
+            //Returns how far (from 0 to 1) the time left over in the accumulator is into the next step
+            float GetInterpolationAlpha();
+
+            //Draws the bodies' colliders and AABBs and the last step's contact normals, when DRAW_DEBUG_PHYSICS_WORLD
+            //is enabled. Everything is added to a DebugLineRenderer and drawn with a single draw call
             void DebugDraw();
 
+            //Creates a body, reusing the slot of a destroyed body if there is one. The collider must have been
+            //created by the World, it can be shared by several bodies
             Body* CreateBody(Collider* collider, float density);
 
+            //Destroys the body and frees its slot for the next body that is created. The body's pointer must not be
+            //used afterwards, hold a BodyHandle instead to refer to a body that may be destroyed. The body's contacts
+            //and contact events are dropped, no end events are sent. Must not be called during a step
+            void DestroyBody(Body* body);
+
+            //Returns the body the handle refers to, or null if the body has been destroyed
+            Body* GetBody(BodyHandle handle);
+
+            //Returns the number of bodies that haven't been destroyed
+            unsigned int GetBodyCount();
+
+            //Colliders are allocated from pools owned by the World, a collider must not be destroyed while a
+            //body still uses it. The colliders that are still alive are released when the World is deleted
+            CircleCollider* CreateCircleCollider(float radius);
+            BoxCollider* CreateBoxCollider(float width, float height);
+            PolygonCollider* CreatePolygonCollider(const vec2* vertices, unsigned int count);
+            void DestroyCollider(Collider* collider);
+
             void SetGravity(vec2 gravity);
             vec2 GetGravity();
 
+            //The listener is called for every contact during the step, to decide if the contact gets a collision
+            //response. It must not change the game's state, handle the contact events after the step for that
             void SetListener(WorldListener* listener);
 
+            //The contact events collected during the steps taken by the last call to Step() or Update(), in the
+            //order the steps found them. Contacts between two still (static or asleep) bodies don't persist or end
+            const vector<ContactEvent>& GetBeginContactEvents();
+            const vector<ContactEvent>& GetPersistContactEvents();
+            const vector<ContactEvent>& GetEndContactEvents();
+
+            //Casts a ray from point1 to point2, returns true if it hit a body and fills in the result with the
+            //closest hit. Bodies the ray starts inside of, bodies whose GameObject is disabled, and sensors, aren't hit
+            bool RayCast(vec2 point1, vec2 point2, RayCastResult* result);
+
+            //Casts a batch of rays, the results are in the same order as the rays. Rays that start near each other
+            //are grouped into packets that share a single broadphase query, and the packets are spread across the
+            //World's threads, so casting many rays at once is much cheaper than casting them one at a time
+            void RayCast(const vector<RayCastInput>& rays, vector<RayCastResult>& results);
+
+            //Fills the bodies vector with the bodies whose collider overlaps the circle or AABB, in body order,
+            //sensors aren't in the broadphase so they are never found by these queries
+            void OverlapCircle(vec2 center, float radius, vector<Body*>& bodies);
+            void OverlapAABB(const AABB& aabb, vector<Body*>& bodies);
+
+            //Returns the body whose collider is closest to the point, within the max distance (in meters), or
+            //null if there isn't one. The ignore body, if set, is skipped (for example the body doing the search)
+            Body* FindNearestBody(vec2 point, float maxDistance, Body* ignore = nullptr);
+
+            //Queues a radial impulse (an explosion) that pushes the bodies whose collider is within the radius
+            //(in meters) away from the center, the strength is the impulse (in kg m/s) at full strength. The
+            //impulses queued between steps are applied together at the start of the next step, right after the
+            //broadphase is updated, so each one costs a single broadphase query instead of a scan of every body
+            void ApplyRadialImpulse(vec2 center, float radius, float strength, RadialFalloff falloff);
+
+            //The bodies hit by the radial impulses applied during the steps taken by the last call to Step() or
+            //Update(), in the order the impulses were queued, then in body order. Static bodies are reported too,
+            //but aren't pushed. Like the contact events, they're meant to be handled after the step, for example
+            //an explosion that hits a barrel can queue the barrel's own explosion for the next step
+            const vector<RadialImpulseHit>& GetRadialImpulseHits();
+
+            //Sets which broadphase is used to find the body pairs to check for collision,
+            //the spatial hash is the default
+            void SetBroadPhaseType(BroadPhaseType broadPhaseType);
+            BroadPhaseType GetBroadPhaseType();
+
+            //Sets the cell size (in meters) of the broadphase's spatial hash
+            void SetBroadPhaseCellSize(float cellSize);
+            float GetBroadPhaseCellSize();
+
+            //Sets the number of iterations the contact solver runs each step, more
+            //iterations are more accurate but take longer
+            void SetVelocityIterations(unsigned int velocityIterations);
+            unsigned int GetVelocityIterations();
+
+            void SetPositionIterations(unsigned int positionIterations);
+            unsigned int GetPositionIterations();
+
+            //Sets the number of threads the narrowphase and the contact solver's islands are split across,
+            //including the thread that calls Step(). The contacts are merged in the same order regardless
+            //of the thread count, so the simulation's results don't change. The default is 1, which doesn't
+            //create any threads
+            void SetThreadCount(unsigned int threadCount);
+            unsigned int GetThreadCount();
+
+            //Returns a hash of every body's position, angle, velocities and sleep state, computed in
+            //body order from the values' bits. Two machines running the same simulation in a
+            //deterministic build (PHYSICS_DETERMINISTIC) produce the same checksum every step
+            unsigned long long ComputeChecksum();
+
+            //When enabled, the checksum is computed at the end of every step, so a desync can be
+            //caught on the step it happens. GetStepCount() returns the number of steps simulated
+            void SetChecksumEnabled(bool checksumEnabled);
+            bool IsChecksumEnabled();
+            unsigned long long GetChecksum();
+            unsigned long long GetStepCount();
+
+            //Sets wether bodies can fall asleep, bodies fall asleep once every body in their contact
+            //island has been slower than the sleep tolerances for WORLD_TIME_TO_SLEEP seconds.
+            //Disabling sleeping wakes every body
+            void SetSleepingEnabled(bool sleepingEnabled);
+            bool IsSleepingEnabled();
+
+            //Profiling counters, the number of times a body has been put to sleep or woken up
+            //since the counters were last reset, and the number of bodies currently asleep
+            unsigned int GetSleepCount();
+            unsigned int GetWakeCount();
+            void ResetSleepCounters();
+            unsigned int GetSleepingBodyCount();
+
+            //Profiling counters, the number of body pairs the broadphase handed to the narrowphase
+            //and the number of contacts the narrowphase produced, during the last step
+            unsigned int GetPairCount();
+            unsigned int GetContactCount();
+
+            //Sets wether the contact impulses from the previous step are used to warm start the contact solver
+            void SetWarmStarting(bool warmStarting);
+            bool IsWarmStarting();
+
+            //Sets wether the contact solver graph colours the constraints and solves them in SIMD lanes. This
+            //changes the order the constraints are solved in, so the results change. Disabled by default
+            void SetGraphColoring(bool graphColoring);
+            bool IsGraphColoring();
+
+            //Sets wether the contact solver hands the contact islands to different threads, only used when
+            //there is more than one thread. The results don't change. Enabled by default
+            void SetIslandSplitting(bool islandSplitting);
+            bool IsIslandSplitting();
+
+            //Saves the state of every body, the contact cache, the touching pairs, the accumulator and the Random's
+            //state, if one is set, into the snapshot, restoring it rewinds the World so the following steps are re-simulated
+            //exactly. Bodies created since the save are destroyed by the restore, and bodies destroyed since the save
+            //are brought back, so the game must look its bodies up again with World::GetBody() after a restore. The
+            //colliders and GameObjects the bodies refer to must still exist. Must not be called during a step
+            void SaveSnapshot(WorldSnapshot* snapshot);
+            void RestoreSnapshot(const WorldSnapshot* snapshot);
+
+            //Sets the random number generator whose state is saved and restored with the snapshots, the World
+            //doesn't own it. Each game simulation has its own, so they stay independent of each other
+            void SetRandom(Random* random);
+            Random* GetRandom();
+
         private:
-            //Private to ensure Singleton design pattern
-            World();
-            ~World();
+            //Signature of the collision methods stored in the collision dispatch table
+            typedef bool (World::*CollisionCheck)(Body* bodyA, Body* bodyB, Manifold* manifold);
+
+            //An entry in the collision dispatch table, if flip is true the bodies are
+            //swapped before the check and the normal is flipped afterwards
+            struct CollisionHandler
+            {
+                CollisionCheck check;
+                bool flip;
+            };
+
+            //A bullet's index and its position at the start of the step
+            struct BulletSweep
+            {
+                unsigned int index;
+                vec2 start;
+            };
+
+            //Registers the collision method for a pair of collider types, the
+            //reverse pair (typeB, typeA) is registered automatically
+            void RegisterCollisionCheck(ColliderType typeA, ColliderType typeB, CollisionCheck check);
+
+            //Query methods, the broadphase holds the AABBs from the start of the last step, so it is updated to
+            //the bodies' current AABBs before the first query after a step, or after a body was added or moved
+            void QueryBroadPhase(const AABB& aabb, vector<unsigned int>& bodies);
+            bool IsQueryable(Body* body);
+            bool RayCastBody(Body* body, vec2 point1, vec2 point2, float maxFraction, RayCastResult* result);
+            float ComputeDistance(Body* body, vec2 point);
+
+            //Applies the queued radial impulses, the broadphase must be up to date
+            void ApplyRadialImpulses();
+
+            //Simulates a single step, without syncing the GameObjects
+            void Simulate(double timeStep);
+
+            //Sets the GameObjects' transforms to the bodies' transforms, interpolated between the
+            //previous and current transforms by alpha
+            void SyncGameObjects(float alpha);
+
+            //Sets a single body's GameObject's transform, interpolated by alpha
+            void SyncGameObject(unsigned int index, float alpha);
+
+            //Runs the narrowphase on a range of the broadphase's pairs, the manifolds of the colliding pairs
+            //are added to the contacts vector, and the GJK simplices of the pairs to the simplices vector, to
+            //warm start the next step. The circle vs circle pairs are gathered into the circle batch and
+            //checked together. Safe to call from any thread
+            void CollidePairs(unsigned int begin, unsigned int end, vector<Manifold>& contacts, vector<CachedSimplex>& simplices, CircleBatch& circles);
+
+            //Sensor methods, the sensors are kept out of the broadphase, each sensor queries the broadphase
+            //for the bodies it overlaps, and the pairs are merged into the broadphase's pairs
+            void UpdateSensorLayer();
+            void FindSensorPairs();
+            bool CheckSensorOverlap(Body* bodyA, Body* bodyB, SimplexCache* cache);
 
             //Private collision methods
             bool CheckCollision(Body* bodyA, Body* bodyB, Manifold* manifold);
             bool CheckCircleToCircle(Body* bodyA, Body* bodyB, Manifold* manifold);
             bool CheckCircleToBox(Body* bodyA, Body* bodyB, Manifold* manifold);
+            bool CheckBoxToBox(Body* bodyA, Body* bodyB, Manifold* manifold);
+            bool CheckCircleToPolygon(Body* bodyA, Body* bodyB, Manifold* manifold);
+            bool CheckPolygonToPolygon(Body* bodyA, Body* bodyB, Manifold* manifold);
+
+            //Continuous collision methods, sweeps the bullets from their position at the start of
+            //the step to their new position, and moves them back to their first time of impact
+            void SolveTimeOfImpact();
+
+            //Contact event methods, the touching pairs are kept sorted by their key between steps, so the
+            //contacts that began or persisted, and the pairs that stopped touching, can be found
+            void AddContactEvent(Manifold* manifold);
+            void CollectEndContactEvents();
+            static unsigned long long MakePairKey(unsigned int indexA, unsigned int indexB);
+
+            //Returns wether the body can't move, because it is static or asleep
+            bool IsStill(unsigned int index);
+
+            //Sleep methods, builds the contact islands and puts the islands that have come to rest to sleep
+            void UpdateSleeping(float timeStep);
+            unsigned int FindIslandRoot(unsigned int index);
+            float ComputeTimeOfImpact(vec2 start, vec2 end, float sweepRadius, Body* target);
 
             //Member variables
             vec2 m_Gravity;
-            vector<Body*> m_Bodies;
+            double m_FixedTimeStep;
+            double m_Accumulator;
+            unsigned int m_MaxSubSteps;
+            vector<float> m_SubStepForceX;
+            vector<float> m_SubStepForceY;
+            vector<float> m_SubStepTorque;
+            vector<Body*> m_Bodies;                 //Indexed by the body's slot, null for free slots
+            vector<unsigned int> m_FreeBodyIndices;
+            BodyStorage m_BodyStorage;
+            ShapeCache m_ShapeCache;                //The bodies' colliders in world space, refreshed with the broadphase
+            Pool<Body> m_BodyPool;
+            Pool<CircleCollider> m_CircleColliderPool;
+            Pool<BoxCollider> m_BoxColliderPool;
+            Pool<PolygonCollider> m_PolygonColliderPool;
+
+            BroadPhaseType m_BroadPhaseType;
+            BroadPhase* m_BroadPhase;
+            SpatialHash* m_SpatialHash;
+            DynamicTreeBroadPhase* m_DynamicTree;
+            vector<BroadPhasePair> m_Pairs;
+            vector<unsigned int> m_SensorIndices;
+            vector<Body*> m_BroadPhaseBodies;      //The bodies, with the sensors' slots left empty, when there are sensors
 
+            CollisionHandler m_CollisionHandlers[ColliderType_Count][ColliderType_Count];
             vector<Manifold> m_Contacts;
+            vector<vector<Manifold>> m_TaskContacts;
+            vector<vector<CachedSimplex>> m_TaskSimplices;
+            vector<CircleBatch> m_TaskCircleBatches;
+            vector<CachedSimplex> m_SimplexCache;   //Sorted by key, read by the narrowphase, rebuilt after it
+            vector<ContactEvent> m_BeginContactEvents;
+            vector<ContactEvent> m_PersistContactEvents;
+            vector<ContactEvent> m_EndContactEvents;
+            vector<unsigned long long> m_TouchingPairs;
+            vector<unsigned long long> m_PreviousTouchingPairs;
+            ThreadPool* m_ThreadPool;
+            vector<BulletSweep> m_BulletSweeps;
+            vector<unsigned long long> m_RayKeys;
+            vector<unsigned int> m_PacketCandidates;
+            vector<unsigned int> m_PacketOffsets;
+            bool m_IsBroadPhaseDirty;
+            vector<unsigned int> m_IslandParents;
+            vector<float> m_IslandSleepTimes;
+            bool m_SleepingEnabled;
+            bool m_ChecksumEnabled;
+            unsigned long long m_Checksum;
+            unsigned long long m_StepCount;
+            vector<unsigned int> m_QueryResults;
+            vector<RadialImpulse> m_RadialImpulses;
+            vector<RadialImpulseHit> m_RadialImpulseHits;
+            ContactSolver m_ContactSolver;
 
             WorldListener* m_Listener;
-            static World* s_Instance;
+            Random* m_Random;
+            DebugLineRenderer* m_DebugLineRenderer; //Created by the first DebugDraw() call, it needs the graphics context
         };
     }
 }
@@ -0,0 +1,46 @@
+#ifndef __WORLD_SNAPSHOT_H__
+#define __WORLD_SNAPSHOT_H__
+
+#include "ContactSolver.h"
+#include "../Services/Random/Random.h"
+
+
+using namespace std;
+
+namespace GameDev2D
+{
+    namespace Physics
+    {
+        //The complete state of a World, saved by World::SaveSnapshot() and restored by World::RestoreSnapshot(),
+        //used to rewind the simulation for rollback netcode. Every field is a flat copy, so saving and restoring
+        //are a memcpy per array, and a snapshot that is saved every frame reuses its memory
+        struct WorldSnapshot
+        {
+            WorldSnapshot()
+            {
+                this->bodyCount = 0;
+                this->accumulator = 0.0;
+                this->stepCount = 0;
+                this->checksum = 0;
+                this->random.seed = 0;
+                this->random.state = 0;
+                this->random.increment = 0;
+                this->random.callCount = 0;
+            }
+
+            //Member variables
+            vector<unsigned char> bodies;               //The BodyStorage arrays, back to back
+            unsigned int bodyCount;                     //Including the free slots
+            vector<unsigned int> freeBodyIndices;
+            vector<CachedContact> contactCache;
+            vector<CachedSimplex> simplexCache;
+            vector<unsigned long long> touchingPairs;
+            double accumulator;
+            unsigned long long stepCount;
+            unsigned long long checksum;
+            RandomState random;                         //The World's Random, if it has one
+        };
+    }
+}
+
+#endif
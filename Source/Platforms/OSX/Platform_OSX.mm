@@ -8,6 +8,7 @@
 
 #include "Platform_OSX.h"
 #include "ServiceLocator.h"
+#include "SpriteBatch.h"
 #include "Game.h"
 #include "ResizeEvent.h"
 #include "OrientationChangedEvent.h"
@@ -57,8 +58,8 @@ namespace GameDev2D
         //Initialize the base class
         PlatformLayer::Init();
         
-        //Create the game object
-        m_Game = new Game();
+        //Create the game object, in its own context
+        CreateGame();
         
         //Resize the window to the desired width and height, and
         //set the fullscreen and vertical sync settings
@@ -103,6 +104,11 @@ namespace GameDev2D
             ServiceLocator::GetGraphics()->Clear();
         }
 
+#if GRAPHICS_SPRITE_BATCHING
+        //Batch the frame's sprites together
+        ServiceLocator::GetGraphics()->GetSpriteBatch()->Begin();
+#endif
+
         if (m_Game != nullptr)
         {
             //Safety check the camera
@@ -126,6 +132,11 @@ namespace GameDev2D
         //Draw the services
         ServiceLocator::DrawServices();
 
+#if GRAPHICS_SPRITE_BATCHING
+        //Draw the last of the batched sprites
+        ServiceLocator::GetGraphics()->GetSpriteBatch()->End();
+#endif
+
         //If the application isn't suspended, flush the opengl buffer
         if(m_IsSuspended == false)
         {
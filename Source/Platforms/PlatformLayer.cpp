@@ -10,6 +10,7 @@
 #include "PlatformLayer.h"
 #include "../Services/ServiceLocator.h"
 #include "../../Game/Game.h"
+#include "../../Game/GameContext.h"
 #if __APPLE__
 #include <unistd.h>
 #endif
@@ -18,6 +19,7 @@
 namespace GameDev2D
 {
     PlatformLayer::PlatformLayer(const string& aPlatformType, int aFrameRate) : BaseObject(aPlatformType), EventDispatcher(),
+        m_GameContext(nullptr),
         m_Game(nullptr),
         m_Width(0),
         m_Height(0),
@@ -43,7 +45,11 @@ namespace GameDev2D
     }
     
     PlatformLayer::~PlatformLayer()
-    {    
+    {
+        //Delete the game and its context, the game's objects release their resources through the services
+        m_Game = nullptr;
+        SafeDelete(m_GameContext);
+
         //Remove all the game services
         ServiceLocator::RemoveAllServices();
     }
@@ -184,6 +190,19 @@ namespace GameDev2D
     {
         return m_Game;
     }
+
+    GameContext* PlatformLayer::GetGameContext()
+    {
+        return m_GameContext;
+    }
+
+    void PlatformLayer::CreateGame()
+    {
+        //The game's physics World steps at the target frame rate, and its Random is seeded with the time
+        m_GameContext = new GameContext(1.0 / (double)GetTargetFramerate(), (uint64_t)time(nullptr));
+        m_GameContext->CreateGame();
+        m_Game = m_GameContext->GetGame();
+    }
     
     int PlatformLayer::GetWidth()
     {
@@ -301,10 +320,10 @@ namespace GameDev2D
         //Update the Game's services
         ServiceLocator::UpdateServices(deltaTime);
 
-        //Update the Game and its camera
+        //Update the Game, through its context, and its camera
         if (m_Game != nullptr)
         {
-            m_Game->Update(deltaTime);
+            m_GameContext->Update(deltaTime);
 
             if (m_Game->GetCamera() != nullptr)
             {
@@ -23,6 +23,7 @@ namespace GameDev2D
     struct VideoModeInfo;
     class Scene;
     class Game;
+    class GameContext;
 
     //Supported platforms
     enum PlatformType
@@ -91,6 +92,9 @@ namespace GameDev2D
 
         //Returns a pointer to the game instance
         Game* GetGame();
+
+        //Returns a pointer to the context the game runs in, which owns its physics World and Random
+        GameContext* GetGameContext();
         
         //Returns the current width and height of our platform's window. Can be overridden.
         virtual int GetWidth();
@@ -197,6 +201,9 @@ namespace GameDev2D
         
         //Logs platform specific details about OS, CPU, RAM, HDD, GPU
         virtual void LogPlatformDetails();
+
+        //Creates the game's context and the game, must be called after Init() has loaded the services
+        void CreateGame();
         
         //This method applies the changes set in the SetVideoModeInfo() method at the start of the Update() method.
         //Abstract, must be implemented by an inheriting class
@@ -224,7 +231,8 @@ namespace GameDev2D
         friend class RenderTarget;
         
         //Member variables
-        Game* m_Game;
+        GameContext* m_GameContext;
+        Game* m_Game;   //Owned by the game context
         unsigned int m_Width;
         unsigned int m_Height;
         bool m_IsSuspended;
@@ -3,6 +3,7 @@
 #include "App/GameWindow.h"
 #include "../../../Game/Game.h"
 #include "../../Services/ServiceLocator.h"
+#include "../../Graphics/Core/SpriteBatch.h"
 #include "../../Events/Platform/ResizeEvent.h"
 #include "../../Events/Platform/FullscreenEvent.h"
 
@@ -39,8 +40,8 @@ namespace GameDev2D
         //Initialize the base class
         PlatformLayer::Init();
 
-        //Create the game object
-        m_Game = new Game();
+        //Create the game object, in its own context
+        CreateGame();
 
         //Set the window's desired width and height, and fullscreen settings
         VideoModeInfo_Win32 videoModeInfo;
@@ -86,6 +87,11 @@ namespace GameDev2D
             ServiceLocator::GetGraphics()->Clear();
         }
 
+#if GRAPHICS_SPRITE_BATCHING
+        //Batch the frame's sprites together
+        ServiceLocator::GetGraphics()->GetSpriteBatch()->Begin();
+#endif
+
         if (m_Game != nullptr)
         {
             //Safety check the camera
@@ -109,6 +115,11 @@ namespace GameDev2D
         //Draw the services
         ServiceLocator::DrawServices();
 
+#if GRAPHICS_SPRITE_BATCHING
+        //Draw the last of the batched sprites
+        ServiceLocator::GetGraphics()->GetSpriteBatch()->End();
+#endif
+
         //If the application isn't suspended, flush the opengl buffer
         if(m_IsSuspended == false)
         {
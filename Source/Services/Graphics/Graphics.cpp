@@ -9,6 +9,7 @@
 #include "Graphics.h"
 #include "../ServiceLocator.h"
 #include "../ShaderManager/ShaderManager.h"
+#include "../../Graphics/Core/SpriteBatch.h"
 #include "../../Platforms/PlatformLayer.h"
 
 
@@ -28,7 +29,8 @@ namespace GameDev2D
         m_ViewportWidth(0),
         m_ViewportHeight(0),
         m_BoundTextureId(0),
-        m_BoundVertexArray(0)
+        m_BoundVertexArray(0),
+        m_SpriteBatch(nullptr)
     {
         #if TARGET_OS_IPHONE
         m_MainRenderTarget = new RenderTarget();
@@ -40,6 +42,9 @@ namespace GameDev2D
         //Create the default camera and set it as the active camera
         m_DefaultCamera = new Camera();
         m_ActiveCamera = m_DefaultCamera;
+
+        //Create the sprite batch, it doesn't create its buffers until it's first drawn
+        m_SpriteBatch = new SpriteBatch();
     }
     
     Graphics::~Graphics()
@@ -50,6 +55,9 @@ namespace GameDev2D
         m_ActiveRenderTarget = nullptr;
         #endif
     
+        //Delete the sprite batch
+        SafeDelete(m_SpriteBatch);
+
         //Delete the default camera
         SafeDelete(m_DefaultCamera);
         m_ActiveCamera = nullptr;
@@ -60,6 +68,9 @@ namespace GameDev2D
     
     void Graphics::Clear()
     {
+        //Draw the batched sprites before they are cleared
+        m_SpriteBatch->Flush();
+
         glClear(GL_COLOR_BUFFER_BIT);
     }
     
@@ -149,6 +160,9 @@ namespace GameDev2D
     
     void Graphics::SetViewportSize(int aWidth, int aHeight)
     {
+        //Draw the batched sprites with the current viewport
+        m_SpriteBatch->Flush();
+
         //Reset the viewport
     	m_ViewportWidth = aWidth;
         m_ViewportHeight = aHeight;
@@ -182,6 +196,9 @@ namespace GameDev2D
         //Safety check that the render target isn't null and that it isn't already set
         if(aRenderTarget != m_ActiveRenderTarget)
         {
+            //Draw the batched sprites to the render target they were drawn for
+            m_SpriteBatch->Flush();
+
             //Safety check the active render target and unbind it
             if(m_ActiveRenderTarget != nullptr)
             {
@@ -220,6 +237,12 @@ namespace GameDev2D
     {
         if(aCamera != nullptr)
         {
+            //Draw the batched sprites with the camera they were drawn for
+            if (aCamera != m_ActiveCamera)
+            {
+                m_SpriteBatch->Flush();
+            }
+
             m_ActiveCamera = aCamera;
         }
     }
@@ -231,6 +254,9 @@ namespace GameDev2D
     
     void Graphics::PushScissorClip(float aX, float aY, float aWidth, float aHeight)
     {
+        //Draw the batched sprites with the current clipping rect
+        m_SpriteBatch->Flush();
+
         //If this is the first scissor clip, enable scissor clipping
         if(m_ScissorStack.size() == 0)
         {
@@ -247,6 +273,9 @@ namespace GameDev2D
     
     void Graphics::PopScissorClip()
     {
+        //Draw the batched sprites with the current clipping rect
+        m_SpriteBatch->Flush();
+
         //Pop back the scissor stack
         m_ScissorStack.pop_back();
         Log(VerbosityLevel_Graphics, "Pop scissor clip");
@@ -289,6 +318,9 @@ namespace GameDev2D
 
     void Graphics::DeleteTexture(unsigned int* aTextureId)
     {
+        //Draw the batched sprites, in case they use the texture
+        m_SpriteBatch->Flush();
+
         //If the texture we are about to delete is bound, we need to unbind it
         if (*aTextureId == GetBoundTextureId())
         {
@@ -349,6 +381,11 @@ namespace GameDev2D
         return m_BoundVertexArray;
     }
     
+    SpriteBatch* Graphics::GetSpriteBatch()
+    {
+        return m_SpriteBatch;
+    }
+
     unsigned int Graphics::GetOpenGLRenderMode(RenderMode aRenderMode)
     {
         unsigned int renderModes[] = { GL_POINTS, GL_LINES, GL_LINE_LOOP, GL_LINE_STRIP, GL_TRIANGLES, GL_TRIANGLE_STRIP, GL_QUADS, GL_QUAD_STRIP, GL_POLYGON };
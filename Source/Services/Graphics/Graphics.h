@@ -25,6 +25,9 @@ using namespace glm;
 
 namespace GameDev2D
 {
+    //Forward declarations
+    class SpriteBatch;
+
     //The Graphics game service is responsible for clearing the back buffer, managing
     //the active RenderTarget and Camera, resizing the viewport and backbuffer. Managing
     //a clipping rect stack and the currently bound texture and vertex array object.
@@ -105,6 +108,9 @@ namespace GameDev2D
         //Returns the currently bound vertex array
         unsigned int GetBoundVertexArray();
 
+        //Returns the SpriteBatch that TextureFrame draws are added to while it is active
+        SpriteBatch* GetSpriteBatch();
+
         //Converts the RenderMode into the OpenGL constant
         unsigned int GetOpenGLRenderMode(RenderMode renderMode);
         
@@ -142,6 +148,9 @@ namespace GameDev2D
         
         //Scissor stack to keep track of multiple clipping rects
         vector<pair<vec2, vec2>> m_ScissorStack;
+
+        //The batched sprites are drawn before the render target, camera, viewport or clipping changes
+        SpriteBatch* m_SpriteBatch;
     };
 }
 
@@ -0,0 +1,109 @@
+#include "Random.h"
+
+
+namespace GameDev2D
+{
+    Random::Random() : GameService("Random"),
+        m_Seed(0),
+        m_State(0),
+        m_Increment(0),
+        m_CallCount(0)
+    {
+        SetSeed((uint64_t)time(nullptr));
+    }
+
+    Random::~Random()
+    {
+
+    }
+
+    bool Random::CanUpdate()
+    {
+        return false;
+    }
+
+    bool Random::CanDraw()
+    {
+        return false;
+    }
+
+    void Random::SetSeed(uint64_t aSeed)
+    {
+        //Initialize the generator the same way the PCG reference implementation does
+        m_Seed = aSeed;
+        m_State = 0;
+        m_Increment = (aSeed << 1u) | 1u;
+        m_CallCount = 0;
+
+        NextUInt();
+        m_State += aSeed;
+        NextUInt();
+        m_CallCount = 0;
+    }
+
+    uint64_t Random::GetSeed()
+    {
+        return m_Seed;
+    }
+
+    unsigned int Random::NextUInt()
+    {
+        //PCG32 (XSH RR), advance the 64-bit state and permute the old state into the output
+        uint64_t oldState = m_State;
+        m_State = oldState * 6364136223846793005ULL + m_Increment;
+        uint32_t xorShifted = (uint32_t)(((oldState >> 18u) ^ oldState) >> 27u);
+        uint32_t rotation = (uint32_t)(oldState >> 59u);
+        m_CallCount++;
+        return (xorShifted >> rotation) | (xorShifted << ((0u - rotation) & 31u));
+    }
+
+    unsigned int Random::NextUInt(unsigned int aRange)
+    {
+        assert(aRange > 0);
+
+        //Reject the values that would make the lower numbers more likely than the higher numbers
+        uint32_t threshold = (0u - aRange) % aRange;
+        while (true)
+        {
+            uint32_t value = NextUInt();
+            if (value >= threshold)
+            {
+                return value % aRange;
+            }
+        }
+    }
+
+    float Random::NextFloat()
+    {
+        //Use the top 24 bits, a float's precision, so the result is exact and never reaches 1
+        return (float)(NextUInt() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    float Random::NextFloat(float aMin, float aMax)
+    {
+        return aMin + (aMax - aMin) * NextFloat();
+    }
+
+    unsigned long long Random::GetCallCount()
+    {
+        return m_CallCount;
+    }
+
+    RandomState Random::GetState()
+    {
+        RandomState state;
+        state.seed = m_Seed;
+        state.state = m_State;
+        state.increment = m_Increment;
+        state.callCount = m_CallCount;
+        return state;
+    }
+
+    void Random::SetState(const RandomState& aState)
+    {
+        m_Seed = aState.seed;
+        m_State = aState.state;
+        m_Increment = aState.increment;
+        m_CallCount = aState.callCount;
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef __GameDev2D__Random__
+#define __GameDev2D__Random__
+
+#include "../GameService.h"
+
+
+using namespace std;
+
+namespace GameDev2D
+{
+    //The complete state of the Random generator, saved and restored to rewind the sequence of random numbers
+    struct RandomState
+    {
+        uint64_t seed;
+        uint64_t state;
+        uint64_t increment;
+        unsigned long long callCount;
+    };
+
+    //The Random game service is the engine's seeded random number generator (a PCG32 generator). It
+    //only uses integer math, so the same seed produces the same sequence of numbers on every platform
+    //and compiler, which rand() doesn't guarantee. Use it for anything that affects the simulation, so
+    //replays and lockstep matches stay in sync. By default it is seeded with the current time. There is no
+    //shared Random in the ServiceLocator, each GameContext owns one and its World saves its state in snapshots
+    class Random : public GameService
+    {
+    public:
+        Random();
+        ~Random();
+
+        //Pure virtual method in GameService, needed to determine
+        //if we should update and draw this GameService
+        bool CanUpdate();
+        bool CanDraw();
+
+        //Restarts the sequence of random numbers from the seed
+        void SetSeed(uint64_t seed);
+        uint64_t GetSeed();
+
+        //Returns a random unsigned int in the range [0, UINT_MAX]
+        unsigned int NextUInt();
+
+        //Returns a random unsigned int in the range [0, range - 1], the range must be greater than zero
+        unsigned int NextUInt(unsigned int range);
+
+        //Returns a random float in the range [0, 1)
+        float NextFloat();
+
+        //Returns a random float in the range [min, max)
+        float NextFloat(float min, float max);
+
+        //Returns the number of values generated since the seed was set, handy to check that two
+        //machines have consumed the same amount of randomness
+        unsigned long long GetCallCount();
+
+        //Saves and restores the generator's state, restoring it replays the same numbers that followed the save
+        RandomState GetState();
+        void SetState(const RandomState& state);
+
+    private:
+        //Member variables
+        uint64_t m_Seed;
+        uint64_t m_State;
+        uint64_t m_Increment;
+        unsigned long long m_CallCount;
+    };
+}
+
+#endif /* defined(__GameDev2D__Random__) */
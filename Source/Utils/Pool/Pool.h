@@ -0,0 +1,107 @@
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include "../../Core/BaseObject.h"
+#include <new>
+#include <utility>
+
+
+namespace GameDev2D
+{
+    //Local constants
+    const unsigned int POOL_DEFAULT_SLAB_SIZE = 64;
+
+    //A pool of fixed size slots, allocated in slabs of SlabSize objects. Destroyed objects put their
+    //slot on a free list, which the next created object reuses, so objects that are created and
+    //destroyed over and over don't fragment the heap, and the pool's memory only grows to the largest
+    //number of objects that were alive at once. Objects never move, so pointers to them stay valid
+    //until they are destroyed. The pool only releases its memory when it is deleted, it doesn't call
+    //the destructors of the objects that are still alive
+    template <typename T, unsigned int SlabSize = POOL_DEFAULT_SLAB_SIZE>
+    class Pool
+    {
+    public:
+        Pool() :
+            m_FreeList(nullptr),
+            m_Count(0)
+        {
+
+        }
+
+        ~Pool()
+        {
+            for (unsigned int i = 0; i < m_Slabs.size(); i++)
+            {
+                delete[] m_Slabs.at(i);
+            }
+            m_Slabs.clear();
+        }
+
+        //Constructs an object in a free slot, passing the arguments to its constructor
+        template <typename... Args>
+        T* Create(Args&&... args)
+        {
+            //Allocate a new slab if there are no free slots left
+            if (m_FreeList == nullptr)
+            {
+                Slot* slab = new Slot[SlabSize];
+                for (unsigned int i = 0; i < SlabSize; i++)
+                {
+                    slab[i].next = i + 1 < SlabSize ? &slab[i + 1] : nullptr;
+                }
+
+                m_Slabs.push_back(slab);
+                m_FreeList = slab;
+            }
+
+            Slot* slot = m_FreeList;
+            m_FreeList = slot->next;
+            m_Count++;
+
+            return new (slot->data) T(std::forward<Args>(args)...);
+        }
+
+        //Destructs the object and returns its slot to the free list
+        void Destroy(T* object)
+        {
+            if (object == nullptr)
+            {
+                return;
+            }
+
+            object->~T();
+
+            Slot* slot = reinterpret_cast<Slot*>(object);
+            slot->next = m_FreeList;
+            m_FreeList = slot;
+            m_Count--;
+        }
+
+        //Returns the number of objects that are alive
+        unsigned int GetCount()
+        {
+            return m_Count;
+        }
+
+        //Returns the number of slots that have been allocated
+        unsigned int GetCapacity()
+        {
+            return m_Slabs.size() * SlabSize;
+        }
+
+    private:
+        //A slot holds either an object or, while it's free, the next free slot
+        union Slot
+        {
+            Slot* next;
+            alignas(T) unsigned char data[sizeof(T)];
+        };
+
+        //Member variables
+        vector<Slot*> m_Slabs;
+        Slot* m_FreeList;
+        unsigned int m_Count;
+    };
+}
+
+#endif
@@ -0,0 +1,144 @@
+#include "ThreadPool.h"
+
+
+namespace GameDev2D
+{
+    ThreadPool::ThreadPool(unsigned int aThreadCount) : BaseObject("ThreadPool"),
+        m_Task(nullptr),
+        m_TaskCount(0),
+        m_NextTask(0),
+        m_FinishedTasks(0),
+        m_Generation(0),
+        m_ActiveWorkers(0),
+        m_IsShuttingDown(false)
+    {
+        //The calling thread is one of the threads
+        for (unsigned int i = 1; i < aThreadCount; i++)
+        {
+            m_Workers.push_back(thread(&ThreadPool::WorkerLoop, this));
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        //Wake the workers up and wait for them to exit
+        {
+            lock_guard<mutex> lock(m_Mutex);
+            m_IsShuttingDown = true;
+        }
+        m_WorkAvailable.notify_all();
+
+        for (unsigned int i = 0; i < m_Workers.size(); i++)
+        {
+            m_Workers.at(i).join();
+        }
+        m_Workers.clear();
+    }
+
+    void ThreadPool::Run(unsigned int aTaskCount, const function<void(unsigned int)>& aTask)
+    {
+        //Safety check
+        if (aTaskCount == 0)
+        {
+            return;
+        }
+
+        //There's no point in waking the workers for a single task
+        if (aTaskCount == 1 || m_Workers.empty() == true)
+        {
+            for (unsigned int i = 0; i < aTaskCount; i++)
+            {
+                aTask(i);
+            }
+            return;
+        }
+
+        //Hand the tasks to the workers
+        {
+            lock_guard<mutex> lock(m_Mutex);
+            m_Task = &aTask;
+            m_TaskCount = aTaskCount;
+            m_NextTask = 0;
+            m_FinishedTasks = 0;
+            m_Generation++;
+        }
+        m_WorkAvailable.notify_all();
+
+        //Help out, then wait for the workers to finish the remaining tasks. The workers must also have
+        //stopped looking for tasks, so none of them picks up a task from the next call to Run()
+        RunTasks(&aTask, aTaskCount);
+
+        unique_lock<mutex> lock(m_Mutex);
+        m_WorkFinished.wait(lock, [this]() { return m_FinishedTasks == m_TaskCount && m_ActiveWorkers == 0; });
+        m_Task = nullptr;
+    }
+
+    unsigned int ThreadPool::GetThreadCount()
+    {
+        return m_Workers.size() + 1;
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        unsigned int generation = 0;
+
+        while (true)
+        {
+            const function<void(unsigned int)>* task = nullptr;
+            unsigned int taskCount = 0;
+
+            //Wait for a new batch of tasks
+            {
+                unique_lock<mutex> lock(m_Mutex);
+                m_WorkAvailable.wait(lock, [this, generation]() { return m_IsShuttingDown == true || m_Generation != generation; });
+
+                if (m_IsShuttingDown == true)
+                {
+                    return;
+                }
+
+                generation = m_Generation;
+
+                //A worker that wakes up late can find the batch already finished, and Run() may have returned
+                //(or be about to). Skip the batch without becoming active, Run() only waits for active workers
+                if (m_Task == nullptr || m_NextTask >= m_TaskCount)
+                {
+                    continue;
+                }
+
+                task = m_Task;
+                taskCount = m_TaskCount;
+                m_ActiveWorkers++;
+            }
+
+            RunTasks(task, taskCount);
+
+            {
+                lock_guard<mutex> lock(m_Mutex);
+                m_ActiveWorkers--;
+            }
+            m_WorkFinished.notify_all();
+        }
+    }
+
+    void ThreadPool::RunTasks(const function<void(unsigned int)>* aTask, unsigned int aTaskCount)
+    {
+        while (true)
+        {
+            unsigned int taskIndex = m_NextTask.fetch_add(1);
+            if (taskIndex >= aTaskCount)
+            {
+                return;
+            }
+
+            (*aTask)(taskIndex);
+
+            //If this was the last task, wake up the thread waiting in Run()
+            if (m_FinishedTasks.fetch_add(1) + 1 == aTaskCount)
+            {
+                lock_guard<mutex> lock(m_Mutex);
+                m_WorkFinished.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+
+#include "../../Core/BaseObject.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+namespace GameDev2D
+{
+    //A fixed size pool of worker threads, used to split a batch of independent tasks across
+    //the CPU's cores. The thread that calls Run() also runs tasks, so a pool with a thread
+    //count of 4 creates 3 worker threads
+    class ThreadPool : public BaseObject
+    {
+    public:
+        ThreadPool(unsigned int threadCount);
+        ~ThreadPool();
+
+        //Calls the task function once for each task index, from 0 to taskCount - 1, spread across
+        //the threads in the pool. Blocks until every task has finished. The tasks are handed out in
+        //no particular order, so they must not depend on each other
+        void Run(unsigned int taskCount, const function<void(unsigned int taskIndex)>& task);
+
+        //Returns the number of threads that run tasks, including the calling thread
+        unsigned int GetThreadCount();
+
+    private:
+        //The worker threads' main loop
+        void WorkerLoop();
+
+        //Runs tasks until there are none left
+        void RunTasks(const function<void(unsigned int)>* task, unsigned int taskCount);
+
+        //Member variables
+        vector<thread> m_Workers;
+        mutex m_Mutex;
+        condition_variable m_WorkAvailable;
+        condition_variable m_WorkFinished;
+        const function<void(unsigned int)>* m_Task;
+        unsigned int m_TaskCount;
+        atomic<unsigned int> m_NextTask;
+        atomic<unsigned int> m_FinishedTasks;
+        unsigned int m_Generation;
+        unsigned int m_ActiveWorkers;
+        bool m_IsShuttingDown;
+    };
+}
+
+#endif
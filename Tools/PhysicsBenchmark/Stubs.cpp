@@ -0,0 +1,23 @@
+//The physics code calls into a few game classes, whose real implementations need a window and a
+//graphics context. The benchmark's bodies have no GameObjects, so these are never reached
+
+#include "../../Game/GameObject.h"
+
+
+namespace GameDev2D
+{
+    vec2 GameObject::GetPosition()
+    {
+        return vec2(0.0f, 0.0f);
+    }
+
+    void GameObject::SetAngle(float)
+    {
+
+    }
+
+    bool GameObject::IsEnabled()
+    {
+        return true;
+    }
+}
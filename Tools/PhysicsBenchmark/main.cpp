@@ -0,0 +1,386 @@
+//Physics stress-scene benchmark, builds a scene of bodies against the Physics::World API, steps it and
+//prints the cost of a step as JSON on stdout. Runs without a window, one scene per run:
+//
+//  PhysicsBenchmark --scene pile --bodies 2000 --steps 600 --broadphase tree --threads 4
+//
+//The contact solver's graph colouring (--coloring) and island splitting (--islands) can be switched
+//on and off on their own, to measure each one's effect
+//
+//--verify-circle-batch N runs no scene, it checks N random circle pairs with each of the CircleBatch's
+//paths (AVX, SSE and scalar) and exits with 1 if the SIMD paths' results aren't bitwise equal to the
+//scalar path's. The World's results must not depend on which path checked a pair
+//
+//Scenes:
+//  circles  - circles drifting in a box, no gravity
+//  boxes    - boxes drifting in a box, no gravity
+//  mixed    - half circles, half boxes, drifting in a box, no gravity
+//  pile     - a dense pile of circles and boxes falling onto the ground, under gravity
+//  scatter  - circles spread far apart, that rarely touch, no gravity
+//  polygons - hexagons, with a circle and a box every third body, drifting in a box, no gravity
+
+#include "Physics/World.h"
+#include "Physics/Body.h"
+#include "Physics/CircleCollider.h"
+#include "Physics/BoxCollider.h"
+#include "Physics/PolygonCollider.h"
+#include "Physics/CircleBatch.h"
+#include "Physics/PhysicsSIMD.h"
+#include "Services/Random/Random.h"
+#include <chrono>
+#include <sys/resource.h>
+
+
+using namespace GameDev2D;
+
+//Local constants
+const float BENCHMARK_BODY_SIZE = 1.0f;         //In meters, the circles' diameter and the boxes' width and height
+const float BENCHMARK_DRIFT_SPEED = 2.0f;       //In m/s, the maximum starting speed of the drifting bodies
+const float BENCHMARK_WALL_THICKNESS = 2.0f;    //In meters
+const double BENCHMARK_TIME_STEP = 1.0 / 60.0;  //In seconds
+
+//The benchmark's settings, parsed from the command line
+struct BenchmarkSettings
+{
+    BenchmarkSettings()
+    {
+        this->scene = "mixed";
+        this->bodies = 1000;
+        this->steps = 600;
+        this->warmupSteps = 60;
+        this->broadPhase = "hash";
+        this->threads = 1;
+        this->sleeping = true;
+        this->graphColoring = false;
+        this->islandSplitting = true;
+        this->seed = 1;
+        this->verifyCircleBatch = 0;
+    }
+
+    //Member variables
+    string scene;
+    unsigned int bodies;
+    unsigned int steps;
+    unsigned int warmupSteps;
+    string broadPhase;
+    unsigned int threads;
+    bool sleeping;
+    bool graphColoring;
+    bool islandSplitting;
+    uint64_t seed;
+    unsigned int verifyCircleBatch; //The number of pairs to verify, 0 runs the scene instead
+};
+
+//The random numbers used to build the scene, the World's snapshots also save and restore it
+Random* g_Random = nullptr;
+
+//Returns false if an argument is unknown or missing its value
+bool ParseSettings(int aArgc, char* aArgv[], BenchmarkSettings* aSettings)
+{
+    for (int i = 1; i < aArgc; i++)
+    {
+        string argument = aArgv[i];
+        if (i + 1 >= aArgc)
+        {
+            return false;
+        }
+
+        string value = aArgv[++i];
+        if (argument == "--scene") aSettings->scene = value;
+        else if (argument == "--bodies") aSettings->bodies = (unsigned int)strtoul(value.c_str(), nullptr, 10);
+        else if (argument == "--steps") aSettings->steps = (unsigned int)strtoul(value.c_str(), nullptr, 10);
+        else if (argument == "--warmup") aSettings->warmupSteps = (unsigned int)strtoul(value.c_str(), nullptr, 10);
+        else if (argument == "--broadphase") aSettings->broadPhase = value;
+        else if (argument == "--threads") aSettings->threads = (unsigned int)strtoul(value.c_str(), nullptr, 10);
+        else if (argument == "--sleep") aSettings->sleeping = value != "0";
+        else if (argument == "--coloring") aSettings->graphColoring = value != "0";
+        else if (argument == "--islands") aSettings->islandSplitting = value != "0";
+        else if (argument == "--seed") aSettings->seed = strtoull(value.c_str(), nullptr, 10);
+        else if (argument == "--verify-circle-batch") aSettings->verifyCircleBatch = (unsigned int)strtoul(value.c_str(), nullptr, 10);
+        else return false;
+    }
+
+    return aSettings->steps > 0;
+}
+
+//Creates a static box, centered on the position
+void CreateWall(Physics::World* aWorld, vec2 aPosition, float aWidth, float aHeight)
+{
+    Physics::Body* body = aWorld->CreateBody(aWorld->CreateBoxCollider(aWidth, aHeight), 0.0f);
+    body->SetPosition(aPosition);
+}
+
+//Surrounds the square area, centered on the origin, with static walls
+void CreateWalls(Physics::World* aWorld, float aSize)
+{
+    float half = aSize * 0.5f + BENCHMARK_WALL_THICKNESS * 0.5f;
+    float length = aSize + BENCHMARK_WALL_THICKNESS * 2.0f;
+    CreateWall(aWorld, vec2(0.0f, -half), length, BENCHMARK_WALL_THICKNESS);
+    CreateWall(aWorld, vec2(0.0f, half), length, BENCHMARK_WALL_THICKNESS);
+    CreateWall(aWorld, vec2(-half, 0.0f), BENCHMARK_WALL_THICKNESS, length);
+    CreateWall(aWorld, vec2(half, 0.0f), BENCHMARK_WALL_THICKNESS, length);
+}
+
+//Creates drifting bodies at random positions in the square area, every circleEvery'th body is a circle
+void CreateDrifting(Physics::World* aWorld, unsigned int aCount, float aSize, unsigned int aCircleEvery)
+{
+    Physics::Collider* circle = aWorld->CreateCircleCollider(BENCHMARK_BODY_SIZE * 0.5f);
+    Physics::Collider* box = aWorld->CreateBoxCollider(BENCHMARK_BODY_SIZE, BENCHMARK_BODY_SIZE);
+    float half = (aSize - BENCHMARK_BODY_SIZE) * 0.5f;
+
+    for (unsigned int i = 0; i < aCount; i++)
+    {
+        Physics::Body* body = aWorld->CreateBody(aCircleEvery != 0 && i % aCircleEvery == 0 ? circle : box, 1.0f);
+        body->SetPosition(vec2(g_Random->NextFloat(-half, half), g_Random->NextFloat(-half, half)));
+        body->SetAngle(g_Random->NextFloat(0.0f, 6.2831853f));
+        body->SetLinearVelocity(vec2(g_Random->NextFloat(-BENCHMARK_DRIFT_SPEED, BENCHMARK_DRIFT_SPEED), g_Random->NextFloat(-BENCHMARK_DRIFT_SPEED, BENCHMARK_DRIFT_SPEED)));
+    }
+}
+
+//Creates drifting hexagons at random positions in the square area, every third body is a circle or a box
+void CreateDriftingPolygons(Physics::World* aWorld, unsigned int aCount, float aSize)
+{
+    vec2 vertices[6];
+    for (unsigned int i = 0; i < 6; i++)
+    {
+        float angle = i * 6.2831853f / 6.0f;
+        vertices[i] = vec2(cosf(angle), sinf(angle)) * (BENCHMARK_BODY_SIZE * 0.5f);
+    }
+
+    Physics::Collider* hexagon = aWorld->CreatePolygonCollider(vertices, 6);
+    Physics::Collider* circle = aWorld->CreateCircleCollider(BENCHMARK_BODY_SIZE * 0.5f);
+    Physics::Collider* box = aWorld->CreateBoxCollider(BENCHMARK_BODY_SIZE, BENCHMARK_BODY_SIZE);
+    float half = (aSize - BENCHMARK_BODY_SIZE) * 0.5f;
+
+    for (unsigned int i = 0; i < aCount; i++)
+    {
+        Physics::Collider* collider = i % 3 == 0 ? (i % 2 == 0 ? circle : box) : hexagon;
+        Physics::Body* body = aWorld->CreateBody(collider, 1.0f);
+        body->SetPosition(vec2(g_Random->NextFloat(-half, half), g_Random->NextFloat(-half, half)));
+        body->SetAngle(g_Random->NextFloat(0.0f, 6.2831853f));
+        body->SetLinearVelocity(vec2(g_Random->NextFloat(-BENCHMARK_DRIFT_SPEED, BENCHMARK_DRIFT_SPEED), g_Random->NextFloat(-BENCHMARK_DRIFT_SPEED, BENCHMARK_DRIFT_SPEED)));
+    }
+}
+
+//Creates columns of alternating circles and boxes above the ground, touching each other, under gravity
+void CreatePile(Physics::World* aWorld, unsigned int aCount)
+{
+    Physics::Collider* circle = aWorld->CreateCircleCollider(BENCHMARK_BODY_SIZE * 0.5f);
+    Physics::Collider* box = aWorld->CreateBoxCollider(BENCHMARK_BODY_SIZE, BENCHMARK_BODY_SIZE);
+    unsigned int columns = std::max((unsigned int)sqrtf((float)aCount), 1u);
+    float width = columns * BENCHMARK_BODY_SIZE;
+
+    aWorld->SetGravity(vec2(0.0f, -10.0f));
+    CreateWall(aWorld, vec2(0.0f, -BENCHMARK_WALL_THICKNESS * 0.5f), width + BENCHMARK_WALL_THICKNESS * 4.0f, BENCHMARK_WALL_THICKNESS);
+    CreateWall(aWorld, vec2(-width * 0.5f - BENCHMARK_WALL_THICKNESS, width), BENCHMARK_WALL_THICKNESS, width * 2.0f);
+    CreateWall(aWorld, vec2(width * 0.5f + BENCHMARK_WALL_THICKNESS, width), BENCHMARK_WALL_THICKNESS, width * 2.0f);
+
+    for (unsigned int i = 0; i < aCount; i++)
+    {
+        unsigned int column = i % columns;
+        unsigned int row = i / columns;
+        float jitter = g_Random->NextFloat(-0.05f, 0.05f);
+
+        Physics::Body* body = aWorld->CreateBody((row + column) % 2 == 0 ? circle : box, 1.0f);
+        body->SetPosition(vec2((column + 0.5f) * BENCHMARK_BODY_SIZE - width * 0.5f + jitter, (row + 0.5f) * BENCHMARK_BODY_SIZE * 1.01f));
+    }
+}
+
+//Builds the scene, returns false if the scene is unknown
+bool CreateScene(Physics::World* aWorld, const BenchmarkSettings& aSettings)
+{
+    //The drifting scenes fill a quarter of their area, the scattered scene a hundredth
+    float denseSize = sqrtf(aSettings.bodies * 4.0f) * BENCHMARK_BODY_SIZE;
+    float sparseSize = sqrtf(aSettings.bodies * 100.0f) * BENCHMARK_BODY_SIZE;
+
+    if (aSettings.scene == "circles")
+    {
+        CreateWalls(aWorld, denseSize);
+        CreateDrifting(aWorld, aSettings.bodies, denseSize, 1);
+    }
+    else if (aSettings.scene == "boxes")
+    {
+        CreateWalls(aWorld, denseSize);
+        CreateDrifting(aWorld, aSettings.bodies, denseSize, 0);
+    }
+    else if (aSettings.scene == "mixed")
+    {
+        CreateWalls(aWorld, denseSize);
+        CreateDrifting(aWorld, aSettings.bodies, denseSize, 2);
+    }
+    else if (aSettings.scene == "pile")
+    {
+        CreatePile(aWorld, aSettings.bodies);
+    }
+    else if (aSettings.scene == "scatter")
+    {
+        CreateWalls(aWorld, sparseSize);
+        CreateDrifting(aWorld, aSettings.bodies, sparseSize, 1);
+    }
+    else if (aSettings.scene == "polygons")
+    {
+        CreateWalls(aWorld, denseSize);
+        CreateDriftingPolygons(aWorld, aSettings.bodies, denseSize);
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+//Returns the number of pairs whose outputs aren't bitwise equal in the two batches
+unsigned int CompareCircleBatches(const Physics::CircleBatch& aBatch, const Physics::CircleBatch& aReference)
+{
+    unsigned int mismatches = 0;
+    for (unsigned int i = 0; i < aReference.id.size(); i++)
+    {
+        if (aBatch.touching.at(i) != aReference.touching.at(i) ||
+            memcmp(&aBatch.overlap.at(i), &aReference.overlap.at(i), sizeof(float)) != 0 ||
+            memcmp(&aBatch.normalX.at(i), &aReference.normalX.at(i), sizeof(float)) != 0 ||
+            memcmp(&aBatch.normalY.at(i), &aReference.normalY.at(i), sizeof(float)) != 0 ||
+            memcmp(&aBatch.pointX.at(i), &aReference.pointX.at(i), sizeof(float)) != 0 ||
+            memcmp(&aBatch.pointY.at(i), &aReference.pointY.at(i), sizeof(float)) != 0)
+        {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+//Checks random circle pairs with the CircleBatch's AVX, SSE and scalar paths, returns false if they differ
+bool VerifyCircleBatch(unsigned int aPairs)
+{
+    Physics::CircleBatch reference;
+    for (unsigned int i = 0; i < aPairs; i++)
+    {
+        vec2 centerA = vec2(g_Random->NextFloat(-2.0f, 2.0f), g_Random->NextFloat(-2.0f, 2.0f));
+        float radiusA = g_Random->NextFloat(0.1f, 1.0f);
+        float radiusB = g_Random->NextFloat(0.1f, 1.0f);
+        vec2 centerB = vec2(g_Random->NextFloat(-2.0f, 2.0f), g_Random->NextFloat(-2.0f, 2.0f));
+
+        //Mix in the edge cases, centers on top of each other and circles that are exactly touching
+        if (i % 7 == 3)
+        {
+            centerB = centerA;
+        }
+        else if (i % 7 == 5)
+        {
+            centerB = centerA + vec2(radiusA + radiusB, 0.0f);
+        }
+
+        reference.Add(i, centerA, radiusA, centerB, radiusB);
+    }
+
+    Physics::CircleBatch avx = reference;
+    Physics::CircleBatch sse = reference;
+    reference.Collide(Physics::CircleBatchPath_Scalar);
+    sse.Collide(Physics::CircleBatchPath_SSE);
+    avx.Collide(Physics::CircleBatchPath_AVX);
+
+    unsigned int avxMismatches = CompareCircleBatches(avx, reference);
+    unsigned int sseMismatches = CompareCircleBatches(sse, reference);
+
+    printf("{\n");
+    printf("  \"verify\": \"circle_batch\",\n");
+    printf("  \"pairs\": %u,\n", aPairs);
+    printf("  \"avx\": %s,\n", PHYSICS_SIMD_AVX ? "true" : "false");
+    printf("  \"sse\": %s,\n", PHYSICS_SIMD_SSE ? "true" : "false");
+    printf("  \"avx_mismatches\": %u,\n", avxMismatches);
+    printf("  \"sse_mismatches\": %u\n", sseMismatches);
+    printf("}\n");
+
+    return avxMismatches == 0 && sseMismatches == 0;
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkSettings settings;
+    if (ParseSettings(argc, argv, &settings) == false)
+    {
+        fprintf(stderr, "Usage: PhysicsBenchmark [--scene circles|boxes|mixed|pile|scatter|polygons] [--bodies N] [--steps N] [--warmup N]\n"
+                        "                        [--broadphase hash|tree] [--threads N] [--sleep 0|1] [--coloring 0|1] [--islands 0|1] [--seed N]\n"
+                        "       PhysicsBenchmark --verify-circle-batch N [--seed N]\n");
+        return 1;
+    }
+
+    g_Random = new Random();
+    g_Random->SetSeed(settings.seed);
+
+    if (settings.verifyCircleBatch > 0)
+    {
+        return VerifyCircleBatch(settings.verifyCircleBatch) == true ? 0 : 1;
+    }
+
+    Physics::World* world = new Physics::World();
+    world->SetRandom(g_Random);
+    world->SetBroadPhaseType(settings.broadPhase == "tree" ? Physics::BroadPhaseType_DynamicTree : Physics::BroadPhaseType_SpatialHash);
+    world->SetThreadCount(std::max(settings.threads, 1u));
+    world->SetSleepingEnabled(settings.sleeping);
+    world->SetGraphColoring(settings.graphColoring);
+    world->SetIslandSplitting(settings.islandSplitting);
+
+    if (CreateScene(world, settings) == false)
+    {
+        fprintf(stderr, "Unknown scene: %s\n", settings.scene.c_str());
+        return 1;
+    }
+
+    //Let the scene settle before it's measured
+    for (unsigned int i = 0; i < settings.warmupSteps; i++)
+    {
+        world->Step(BENCHMARK_TIME_STEP);
+    }
+
+    //Time each step on its own, so the median and the worst step can be reported
+    vector<double> times;
+    times.reserve(settings.steps);
+    unsigned long long pairs = 0;
+    unsigned long long contacts = 0;
+
+    for (unsigned int i = 0; i < settings.steps; i++)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        world->Step(BENCHMARK_TIME_STEP);
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        times.push_back((double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        pairs += world->GetPairCount();
+        contacts += world->GetContactCount();
+    }
+
+    double total = 0.0;
+    for (unsigned int i = 0; i < times.size(); i++)
+    {
+        total += times.at(i);
+    }
+
+    std::sort(times.begin(), times.end());
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    printf("{\n");
+    printf("  \"scene\": \"%s\",\n", settings.scene.c_str());
+    printf("  \"bodies\": %u,\n", settings.bodies);
+    printf("  \"total_bodies\": %u,\n", world->GetBodyCount());
+    printf("  \"steps\": %u,\n", settings.steps);
+    printf("  \"warmup_steps\": %u,\n", settings.warmupSteps);
+    printf("  \"broadphase\": \"%s\",\n", settings.broadPhase == "tree" ? "tree" : "hash");
+    printf("  \"threads\": %u,\n", world->GetThreadCount());
+    printf("  \"sleeping\": %s,\n", settings.sleeping == true ? "true" : "false");
+    printf("  \"graph_coloring\": %s,\n", settings.graphColoring == true ? "true" : "false");
+    printf("  \"island_splitting\": %s,\n", settings.islandSplitting == true ? "true" : "false");
+    printf("  \"seed\": %llu,\n", (unsigned long long)settings.seed);
+    printf("  \"deterministic\": %s,\n", PHYSICS_DETERMINISTIC ? "true" : "false");
+    printf("  \"ns_per_step\": { \"mean\": %.0f, \"median\": %.0f, \"min\": %.0f, \"max\": %.0f },\n",
+           total / times.size(), times.at(times.size() / 2), times.front(), times.back());
+    printf("  \"pairs_per_step\": %.1f,\n", (double)pairs / settings.steps);
+    printf("  \"contacts_per_step\": %.1f,\n", (double)contacts / settings.steps);
+    printf("  \"sleeping_bodies\": %u,\n", world->GetSleepingBodyCount());
+    printf("  \"peak_rss_kb\": %ld,\n", usage.ru_maxrss);
+    printf("  \"checksum\": \"%016llx\"\n", world->ComputeChecksum());
+    printf("}\n");
+
+    return 0;
+}